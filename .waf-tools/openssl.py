@@ -0,0 +1,61 @@
+#! /usr/bin/env python
+# encoding: utf-8
+
+'''
+
+When using this tool, the wscript will look like:
+
+    def options(opt):
+        opt.load('compiler_cxx openssl')
+
+    def configure(conf):
+        conf.load('compiler_cxx openssl')
+        conf.check_openssl()
+
+    def build(bld):
+        bld(source='main.cpp', target='app', use='OPENSSL')
+
+Options are generated, in order to specify the location of OpenSSL includes/libraries.
+
+
+'''
+from waflib import Options, Errors
+from waflib.Configure import conf
+
+OPENSSL_CODE = '''
+#include <openssl/evp.h>
+
+int
+main(int, char**)
+{
+  unsigned char digest[32];
+  return EVP_Digest("", 0, digest, 0, EVP_sha256(), 0) == 1 ? 0 : 1;
+}
+'''
+
+def options(opt):
+    opt.add_option('--with-openssl', type='string', default=None,
+                   dest='with_openssl', help='''Path to OpenSSL, e.g., /usr/local''')
+
+@conf
+def check_openssl(self, *k, **kw):
+    root = k and k[0] or kw.get('path', None) or Options.options.with_openssl
+    mandatory = kw.get('mandatory', True)
+    var = kw.get('uselib_store', 'OPENSSL')
+
+    args = dict(lib='crypto',
+                msg='Checking for OpenSSL library',
+                define_name='HAVE_%s' % var,
+                uselib_store=var,
+                mandatory=True,
+                fragment=OPENSSL_CODE)
+    if root:
+        args['includes'] = "%s/include" % root
+        args['libpath'] = "%s/lib" % root
+
+    try:
+        self.check_cxx(**args)
+        self.env['HAVE_%s' % var] = True
+    except Errors.ConfigurationError:
+        if mandatory:
+            raise
@@ -24,6 +24,9 @@
 #include "util/crypto.hpp"
 #include "util/concepts.hpp"
 
+#include <boost/iostreams/device/array.hpp>
+#include <boost/iostreams/stream.hpp>
+
 namespace ndn {
 
 BOOST_CONCEPT_ASSERT((boost::EqualityComparable<Data>));
@@ -34,15 +37,21 @@ static_assert(std::is_base_of<tlv::Error, Data::Error>::value,
 
 Data::Data()
   : m_content(tlv::Content) // empty content
+  , m_isMetaInfoPending(false)
+  , m_isSignaturePending(false)
 {
 }
 
 Data::Data(const Name& name)
   : m_name(name)
+  , m_isMetaInfoPending(false)
+  , m_isSignaturePending(false)
 {
 }
 
 Data::Data(const Block& wire)
+  : m_isMetaInfoPending(false)
+  , m_isSignaturePending(false)
 {
   wireDecode(wire);
 }
@@ -61,7 +70,9 @@ Data::wireEncode(EncodingImpl<TAG>& encoder, bool unsignedPortion/* = false*/) c
 
   // (reverse encoding)
 
-  if (!unsignedPortion && !m_signature)
+  const Signature& signature = getSignature();
+
+  if (!unsignedPortion && !signature)
     {
       throw Error("Requested wire format, but data packet has not been signed yet");
     }
@@ -69,20 +80,24 @@ Data::wireEncode(EncodingImpl<TAG>& encoder, bool unsignedPortion/* = false*/) c
   if (!unsignedPortion)
     {
       // SignatureValue
-      totalLength += encoder.prependBlock(m_signature.getValue());
+      totalLength += encoder.prependBlock(signature.getValue());
     }
 
   // SignatureInfo
-  totalLength += encoder.prependBlock(m_signature.getInfo());
+  totalLength += encoder.prependBlock(signature.getInfo());
 
   // Content
   totalLength += encoder.prependBlock(getContent());
 
+  // Name, MetaInfo, and SignatureInfo keep their encoded blocks, which are spliced into the
+  // packet as is.  This way, a change of one field (e.g., Content) only requires encoding
+  // of that field when the packet is encoded again.
+
   // MetaInfo
-  totalLength += getMetaInfo().wireEncode(encoder);
+  totalLength += encoder.prependBlock(getMetaInfo().wireEncode());
 
   // Name
-  totalLength += getName().wireEncode(encoder);
+  totalLength += encoder.prependBlock(getName().wireEncode());
 
   if (!unsignedPortion)
     {
@@ -111,7 +126,7 @@ Data::wireEncode(EncodingBuffer& encoder, const Block& signatureValue) const
   encoder.prependVarNumber(totalLength);
   encoder.prependVarNumber(tlv::Data);
 
-  const_cast<Data*>(this)->wireDecode(encoder.block());
+  adoptWire(encoder.block());
   return m_wire;
 }
 
@@ -127,12 +142,64 @@ Data::wireEncode() const
   EncodingBuffer buffer(estimatedSize, 0);
   wireEncode(buffer);
 
-  const_cast<Data*>(this)->wireDecode(buffer.block());
+  adoptWire(buffer.block());
   return m_wire;
 }
 
+size_t
+Data::wireEncode(uint8_t* buffer, size_t bufferSize) const
+{
+  if (m_wire.hasWire()) {
+    if (m_wire.size() > bufferSize)
+      throw Error("Buffer is too small to hold the wire encoding of Data packet");
+
+    std::copy(m_wire.begin(), m_wire.end(), buffer);
+    return m_wire.size();
+  }
+
+  const Signature& signature = getSignature();
+  if (!signature)
+    throw Error("Requested wire format, but data packet has not been signed yet");
+
+  const Block* elements[] = {&getName().wireEncode(), &getMetaInfo().wireEncode(),
+                             &getContent(), &signature.getInfo(), &signature.getValue()};
+
+  size_t valueLength = 0;
+  for (const Block* element : elements)
+    valueLength += element->size();
+
+  size_t totalLength = tlv::sizeOfVarNumber(tlv::Data) + tlv::sizeOfVarNumber(valueLength) +
+                       valueLength;
+  if (totalLength > bufferSize)
+    throw Error("Buffer is too small to hold the wire encoding of Data packet");
+
+  boost::iostreams::stream<boost::iostreams::array_sink> os(reinterpret_cast<char*>(buffer),
+                                                            bufferSize);
+  tlv::writeVarNumber(os, tlv::Data);
+  tlv::writeVarNumber(os, valueLength);
+  for (const Block* element : elements)
+    os.write(reinterpret_cast<const char*>(element->wire()), element->size());
+
+  return totalLength;
+}
+
 void
 Data::wireDecode(const Block& wire)
+{
+  wireDecodeLazy(wire);
+
+  decodeMetaInfo();
+  decodeSignature();
+}
+
+void
+Data::wireDecodeLazy(const Block& wire)
+{
+  adoptWire(wire);
+}
+
+void
+Data::adoptWire(const Block& wire) const
 {
   m_fullName.clear();
   m_wire = wire;
@@ -147,16 +214,28 @@ Data::wireDecode(const Block& wire)
   // Name
   m_name.wireDecode(m_wire.get(tlv::Name));
 
-  // MetaInfo
-  m_metaInfo.wireDecode(m_wire.get(tlv::MetaInfo));
+  // MetaInfo (deferred)
+  m_metaInfo = MetaInfo();
+  m_isMetaInfoPending = true;
 
   // Content
   m_content = m_wire.get(tlv::Content);
 
-  ///////////////
-  // Signature //
-  ///////////////
+  // Signature (deferred)
+  m_signature = Signature();
+  m_isSignaturePending = true;
+}
 
+void
+Data::decodeMetaInfo() const
+{
+  m_metaInfo.wireDecode(m_wire.get(tlv::MetaInfo));
+  m_isMetaInfoPending = false;
+}
+
+void
+Data::decodeSignature() const
+{
   // SignatureInfo
   m_signature.setInfo(m_wire.get(tlv::SignatureInfo));
 
@@ -164,6 +243,8 @@ Data::wireDecode(const Block& wire)
   Block::element_const_iterator val = m_wire.find(tlv::SignatureValue);
   if (val != m_wire.elements_end())
     m_signature.setValue(*val);
+
+  m_isSignaturePending = false;
 }
 
 Data&
@@ -183,8 +264,11 @@ Data::getFullName() const
       throw Error("Full name requested, but Data packet does not have wire format "
                   "(e.g., not signed)");
     }
+    uint8_t digest[crypto::SHA256_DIGEST_SIZE];
+    crypto::sha256(m_wire.wire(), m_wire.size(), digest);
+
     m_fullName = m_name;
-    m_fullName.appendImplicitSha256Digest(crypto::sha256(m_wire.wire(), m_wire.size()));
+    m_fullName.appendImplicitSha256Digest(digest, sizeof(digest));
   }
 
   return m_fullName;
@@ -317,6 +401,12 @@ Data::onChanged()
   // !!!Note!!! Signature is not invalidated and it is responsibility of
   // the application to do proper re-signing if necessary
 
+  // fields deferred by wireDecodeLazy must be decoded before the wire goes away
+  if (m_isMetaInfoPending)
+    decodeMetaInfo();
+  if (m_isSignaturePending)
+    decodeSignature();
+
   m_wire.reset();
   m_fullName.clear();
 }
@@ -107,6 +107,20 @@ public:
   const Block&
   wireEncode() const;
 
+  /**
+   * @brief Encode to a wire format into a caller-provided buffer
+   *
+   * If the packet has no wire encoding yet, the encoded blocks of its fields are written
+   * into @p buffer directly, without creating the wire encoding of the packet itself.
+   *
+   * @param buffer     destination of the wire encoding
+   * @param bufferSize size of @p buffer, which must be at least wireEncode().size()
+   * @return number of bytes written into @p buffer
+   * @throw Error @p bufferSize is too small to hold the wire encoding
+   */
+  size_t
+  wireEncode(uint8_t* buffer, size_t bufferSize) const;
+
   /**
    * @brief Finalize Data packet encoding with the specified SignatureValue
    *
@@ -120,7 +134,10 @@ public:
    *
    *     Data data;
    *     ...
-   *     EncodingBuffer encoder;
+   *     EncodingEstimator estimator;
+   *     size_t unsignedPortionSize = data.wireEncode(estimator, true);
+   *     EncodingBuffer encoder(<header_reserve> + unsignedPortionSize + <signature_reserve>,
+   *                            <signature_reserve>);
    *     data.wireEncode(encoder, true);
    *     ...
    *     Block signatureValue = <sign_over_unsigned_portion>(encoder.buf(), encoder.size());
@@ -135,6 +152,20 @@ public:
   void
   wireDecode(const Block& wire);
 
+  /**
+   * @brief Decode from the wire format, deferring decoding of MetaInfo and Signature
+   *
+   * Only the top-level elements and the Name are decoded by this call.  MetaInfo and
+   * SignatureInfo/SignatureValue are decoded from the wire when they are first accessed,
+   * so that applications that only look at the Name (e.g., to match it against pending
+   * Interests or to insert the packet into a cache) do not pay for decoding them.
+   *
+   * @note A malformed MetaInfo or SignatureInfo is reported by the first accessor that
+   *       needs the field, rather than by this method.
+   */
+  void
+  wireDecodeLazy(const Block& wire);
+
   /**
    * @brief Check if Data is already has wire encoding
    */
@@ -318,10 +349,34 @@ protected:
   onChanged();
 
 private:
-  Name m_name;
-  MetaInfo m_metaInfo;
+  /**
+   * @brief Use @p wire as the wire encoding, with all fields pointing into it
+   *
+   * Name and Content are taken from @p wire, MetaInfo and Signature are decoded from it
+   * when first accessed, so that no field keeps its own copy of what is in the wire.
+   */
+  void
+  adoptWire(const Block& wire) const;
+
+  /**
+   * @brief Decode MetaInfo from m_wire, if deferred by wireDecodeLazy
+   */
+  void
+  decodeMetaInfo() const;
+
+  /**
+   * @brief Decode SignatureInfo and SignatureValue from m_wire, if deferred by wireDecodeLazy
+   */
+  void
+  decodeSignature() const;
+
+private:
+  mutable Name m_name;
+  mutable MetaInfo m_metaInfo;
   mutable Block m_content;
-  Signature m_signature;
+  mutable Signature m_signature;
+  mutable bool m_isMetaInfoPending;
+  mutable bool m_isSignaturePending;
 
   mutable Block m_wire;
   mutable Name m_fullName;
@@ -348,30 +403,36 @@ Data::getName() const
 inline const MetaInfo&
 Data::getMetaInfo() const
 {
+  if (m_isMetaInfoPending)
+    decodeMetaInfo();
+
   return m_metaInfo;
 }
 
 inline uint32_t
 Data::getContentType() const
 {
-  return m_metaInfo.getType();
+  return getMetaInfo().getType();
 }
 
 inline const time::milliseconds&
 Data::getFreshnessPeriod() const
 {
-  return m_metaInfo.getFreshnessPeriod();
+  return getMetaInfo().getFreshnessPeriod();
 }
 
 inline const name::Component&
 Data::getFinalBlockId() const
 {
-  return m_metaInfo.getFinalBlockId();
+  return getMetaInfo().getFinalBlockId();
 }
 
 inline const Signature&
 Data::getSignature() const
 {
+  if (m_isSignaturePending)
+    decodeSignature();
+
   return m_signature;
 }
 
@@ -26,7 +26,6 @@
 
 #include "tlv.hpp"
 #include "encoding-buffer.hpp"
-#include "buffer-stream.hpp"
 
 #include <boost/lexical_cast.hpp>
 #include <boost/asio/buffer.hpp>
@@ -304,24 +303,29 @@ Block::parse() const
   Buffer::const_iterator begin = value_begin();
   Buffer::const_iterator end = value_end();
 
+  // First pass only walks Type-Length headers to validate boundaries and count elements,
+  // so that the sub-element container is allocated exactly once
+  size_t nElements = 0;
+  const uint8_t* scanEnd = tlv::scanElements(&*begin, &*begin + value_size(), nElements);
+  if (scanEnd != &*begin + value_size())
+    {
+      throw tlv::Error("Malformed or truncated TLV sub-element");
+    }
+
+  m_subBlocks.reserve(nElements);
+
   while (begin != end)
     {
       Buffer::const_iterator element_begin = begin;
 
       uint32_t type = tlv::readType(begin, end);
       uint64_t length = tlv::readVarNumber(begin, end);
-
-      if (length > static_cast<uint64_t>(end - begin))
-        {
-          m_subBlocks.clear();
-          throw tlv::Error("TLV length exceeds buffer length");
-        }
       Buffer::const_iterator element_end = begin + length;
 
-      m_subBlocks.push_back(Block(m_buffer,
-                                  type,
-                                  element_begin, element_end,
-                                  begin, element_end));
+      m_subBlocks.emplace_back(m_buffer,
+                               type,
+                               element_begin, element_end,
+                               begin, element_end);
 
       begin = element_end;
       // don't do recursive parsing, just the top level
@@ -334,43 +338,43 @@ Block::encode()
   if (hasWire())
     return;
 
-  OBufferStream os;
-  tlv::writeVarNumber(os, type());
-
+  size_t valueSize = 0;
   if (hasValue())
     {
-      tlv::writeVarNumber(os, value_size());
-      os.write(reinterpret_cast<const char*>(value()), value_size());
-    }
-  else if (m_subBlocks.size() == 0)
-    {
-      tlv::writeVarNumber(os, 0);
+      valueSize = value_size();
     }
   else
     {
-      size_t valueSize = 0;
       for (element_const_iterator i = m_subBlocks.begin(); i != m_subBlocks.end(); ++i) {
         valueSize += i->size();
       }
+    }
 
-      tlv::writeVarNumber(os, valueSize);
+  // total size is known upfront, so the wire buffer is allocated exactly once
+  EncodingBuffer encoder(tlv::sizeOfVarNumber(m_type) + tlv::sizeOfVarNumber(valueSize) +
+                         valueSize, 0);
 
-      for (element_const_iterator i = m_subBlocks.begin(); i != m_subBlocks.end(); ++i) {
-        if (i->hasWire())
-          os.write(reinterpret_cast<const char*>(i->wire()), i->size());
-        else if (i->hasValue()) {
-          tlv::writeVarNumber(os, i->type());
-          tlv::writeVarNumber(os, i->value_size());
-          os.write(reinterpret_cast<const char*>(i->value()), i->value_size());
-        }
-        else
+  if (hasValue())
+    {
+      encoder.prependByteArray(value(), value_size());
+    }
+  else
+    {
+      for (element_container::const_reverse_iterator i = m_subBlocks.rbegin();
+           i != m_subBlocks.rend(); ++i) {
+        if (!i->hasWire() && !i->hasValue())
           throw Error("Underlying value buffer is empty");
+
+        encoder.prependBlock(*i);
       }
     }
 
+  encoder.prependVarNumber(valueSize);
+  encoder.prependVarNumber(m_type);
+
   // now assign correct block
 
-  m_buffer = os.buf();
+  m_buffer = encoder.getBuffer();
   m_begin = m_buffer->begin();
   m_end   = m_buffer->end();
   m_size  = m_end - m_begin;
@@ -178,6 +178,7 @@ OID::decode(CryptoPP::BufferedTransformation& in)
 namespace oid {
 const OID RSA("1.2.840.113549.1.1.1");
 const OID ECDSA("1.2.840.10045.2.1");
+const OID ED25519("1.3.101.112");
 
 const OID ATTRIBUTE_NAME("2.5.4.41");
 }
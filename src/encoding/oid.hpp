@@ -100,6 +100,7 @@ namespace oid {
 //crypto algorithm
 extern const OID RSA;
 extern const OID ECDSA;
+extern const OID ED25519;
 
 //certificate entries
 extern const OID ATTRIBUTE_NAME;
@@ -95,7 +95,9 @@ enum {
 enum SignatureTypeValue {
   DigestSha256 = 0,
   SignatureSha256WithRsa = 1,
-  SignatureSha256WithEcdsa = 3
+  SignatureSha256WithEcdsa = 3,
+  SignatureHmacWithSha256 = 4,
+  SignatureEd25519 = 5
 };
 
 /** @brief indicates a possible value of ContentType field
@@ -174,6 +176,25 @@ template<class InputIterator>
 inline uint32_t
 readType(InputIterator& begin, const InputIterator& end);
 
+/**
+ * @brief Find boundaries of consecutive TLV elements in a contiguous buffer
+ *
+ * Only Type and Length of each element are read, TLV-VALUE is skipped without being
+ * inspected.  Scanning stops at the first element that is incomplete or has a malformed
+ * header.
+ *
+ * @param [in]  begin     Begin of the buffer
+ * @param [in]  end       End of the buffer
+ * @param [out] nElements Number of complete elements found
+ *
+ * @throws This call never throws exception
+ *
+ * @return pointer to the first byte after the last complete element, or @p begin if
+ *         no complete element has been found
+ */
+inline const uint8_t*
+scanElements(const uint8_t* begin, const uint8_t* end, size_t& nElements);
+
 /**
  * @brief Get number of bytes necessary to hold value of VAR-NUMBER
  */
@@ -368,6 +389,37 @@ readType(InputIterator& begin, const InputIterator& end)
   return static_cast<uint32_t>(type);
 }
 
+inline const uint8_t*
+scanElements(const uint8_t* begin, const uint8_t* end, size_t& nElements)
+{
+  nElements = 0;
+  while (begin != end)
+    {
+      const uint8_t* element = begin;
+      uint64_t length = 0;
+
+      // most elements have both Type and Length encoded in a single octet
+      if (end - begin >= 2 && begin[0] < 253 && begin[1] < 253)
+        {
+          length = begin[1];
+          begin += 2;
+        }
+      else
+        {
+          uint32_t type = 0;
+          if (!readType(begin, end, type) || !readVarNumber(begin, end, length))
+            return element;
+        }
+
+      if (length > static_cast<uint64_t>(end - begin))
+        return element;
+
+      begin += length;
+      ++nElements;
+    }
+  return begin;
+}
+
 size_t
 sizeOfVarNumber(uint64_t varNumber)
 {
@@ -483,7 +483,9 @@ Face::onReceiveElement(const Block& blockFromDaemon)
 
   if (block.type() == tlv::Interest)
     {
-      shared_ptr<Interest> interest = make_shared<Interest>(block);
+      // Selectors are decoded only if the application looks at them
+      shared_ptr<Interest> interest = make_shared<Interest>();
+      interest->wireDecodeLazy(block);
       if (&block != &blockFromDaemon)
         interest->getLocalControlHeader().wireDecode(blockFromDaemon);
 
@@ -491,7 +493,10 @@ Face::onReceiveElement(const Block& blockFromDaemon)
     }
   else if (block.type() == tlv::Data)
     {
-      shared_ptr<Data> data = make_shared<Data>(block);
+      // matching against pending Interests needs only the Name in most cases;
+      // MetaInfo and Signature are decoded only if accessed
+      shared_ptr<Data> data = make_shared<Data>();
+      data->wireDecodeLazy(block);
       if (&block != &blockFromDaemon)
         data->getLocalControlHeader().wireDecode(blockFromDaemon);
 
@@ -25,6 +25,9 @@
 #include "util/concepts.hpp"
 #include "data.hpp"
 
+#include <boost/iostreams/device/array.hpp>
+#include <boost/iostreams/stream.hpp>
+
 namespace ndn {
 
 BOOST_CONCEPT_ASSERT((boost::EqualityComparable<Interest>));
@@ -218,12 +221,10 @@ Interest::matchesData(const Data& data) const
   const KeyLocator& publisherPublicKeyLocator = this->getPublisherPublicKeyLocator();
   if (!publisherPublicKeyLocator.empty()) {
     const Signature& signature = data.getSignature();
-    const Block& signatureInfo = signature.getInfo();
-    Block::element_const_iterator it = signatureInfo.find(tlv::KeyLocator);
-    if (it == signatureInfo.elements_end()) {
+    if (!signature.hasKeyLocator()) {
       return false;
     }
-    if (publisherPublicKeyLocator.wireEncode() != *it) {
+    if (publisherPublicKeyLocator != signature.getKeyLocator()) {
       return false;
     }
   }
@@ -311,14 +312,100 @@ Interest::wireEncode() const
   EncodingBuffer buffer(estimatedSize, 0);
   wireEncode(buffer);
 
-  // to ensure that Nonce block points to the right memory location
-  const_cast<Interest*>(this)->wireDecode(buffer.block());
-
+  adoptWire(buffer.block());
   return m_wire;
 }
 
+static size_t
+sizeOfNonNegativeIntegerBlock(uint32_t type, uint64_t value)
+{
+  size_t valueLength = tlv::sizeOfNonNegativeInteger(value);
+  return tlv::sizeOfVarNumber(type) + tlv::sizeOfVarNumber(valueLength) + valueLength;
+}
+
+static void
+writeNonNegativeIntegerBlock(std::ostream& os, uint32_t type, uint64_t value)
+{
+  tlv::writeVarNumber(os, type);
+  tlv::writeVarNumber(os, tlv::sizeOfNonNegativeInteger(value));
+  tlv::writeNonNegativeInteger(os, value);
+}
+
+static void
+writeBlock(std::ostream& os, const Block& block)
+{
+  os.write(reinterpret_cast<const char*>(block.wire()), block.size());
+}
+
+size_t
+Interest::wireEncode(uint8_t* buffer, size_t bufferSize) const
+{
+  if (m_wire.hasWire()) {
+    if (m_wire.size() > bufferSize)
+      throw Error("Buffer is too small to hold the wire encoding of Interest");
+
+    std::copy(m_wire.begin(), m_wire.end(), buffer);
+    return m_wire.size();
+  }
+
+  // elements in the same order and under the same conditions as in
+  // wireEncode(EncodingImpl<TAG>&), whose comments describe them
+  getNonce(); // to ensure that Nonce is properly set
+  bool hasScope = getScope() >= 0;
+  bool hasInterestLifetime = getInterestLifetime() >= time::milliseconds::zero() &&
+                             getInterestLifetime() != DEFAULT_INTEREST_LIFETIME;
+  BOOST_ASSERT(hasLink() || !hasSelectedDelegation());
+
+  size_t valueLength = getName().wireEncode().size() + m_nonce.size();
+  if (hasSelectors())
+    valueLength += getSelectors().wireEncode().size();
+  if (hasScope)
+    valueLength += sizeOfNonNegativeIntegerBlock(tlv::Scope, getScope());
+  if (hasInterestLifetime)
+    valueLength += sizeOfNonNegativeIntegerBlock(tlv::InterestLifetime,
+                                                 getInterestLifetime().count());
+  if (hasLink())
+    valueLength += m_link.size();
+  if (hasSelectedDelegation())
+    valueLength += sizeOfNonNegativeIntegerBlock(tlv::SelectedDelegation,
+                                                 m_selectedDelegationIndex);
+
+  size_t totalLength = tlv::sizeOfVarNumber(tlv::Interest) + tlv::sizeOfVarNumber(valueLength) +
+                       valueLength;
+  if (totalLength > bufferSize)
+    throw Error("Buffer is too small to hold the wire encoding of Interest");
+
+  boost::iostreams::stream<boost::iostreams::array_sink> os(reinterpret_cast<char*>(buffer),
+                                                            bufferSize);
+  tlv::writeVarNumber(os, tlv::Interest);
+  tlv::writeVarNumber(os, valueLength);
+  writeBlock(os, getName().wireEncode());
+  if (hasSelectors())
+    writeBlock(os, getSelectors().wireEncode());
+  writeBlock(os, m_nonce);
+  if (hasScope)
+    writeNonNegativeIntegerBlock(os, tlv::Scope, getScope());
+  if (hasInterestLifetime)
+    writeNonNegativeIntegerBlock(os, tlv::InterestLifetime, getInterestLifetime().count());
+  if (hasLink())
+    writeBlock(os, m_link);
+  if (hasSelectedDelegation())
+    writeNonNegativeIntegerBlock(os, tlv::SelectedDelegation, m_selectedDelegationIndex);
+
+  return totalLength;
+}
+
 void
 Interest::wireDecode(const Block& wire)
+{
+  wireDecodeLazy(wire);
+
+  if (m_pendingSelectors.hasWire())
+    decodeSelectors();
+}
+
+void
+Interest::wireDecodeLazy(const Block& wire)
 {
   m_wire = wire;
   m_wire.parse();
@@ -338,14 +425,15 @@ Interest::wireDecode(const Block& wire)
   // Name
   m_name.wireDecode(m_wire.get(tlv::Name));
 
-  // Selectors
+  // Selectors (deferred)
+  m_selectors = Selectors();
   Block::element_const_iterator val = m_wire.find(tlv::Selectors);
   if (val != m_wire.elements_end())
     {
-      m_selectors.wireDecode(*val);
+      m_pendingSelectors = *val;
     }
   else
-    m_selectors = Selectors();
+    m_pendingSelectors.reset();
 
   // Nonce
   m_nonce = m_wire.get(tlv::Nonce);
@@ -393,6 +481,23 @@ Interest::wireDecode(const Block& wire)
   }
 }
 
+void
+Interest::adoptWire(const Block& wire) const
+{
+  // fields already hold the values the wire was created from, so there is nothing to decode;
+  // only Nonce has to point into the new wire, as setNonce() updates it in place
+  m_wire = wire;
+  m_wire.parse();
+  m_nonce = m_wire.get(tlv::Nonce);
+}
+
+void
+Interest::decodeSelectors() const
+{
+  m_selectors.wireDecode(m_pendingSelectors);
+  m_pendingSelectors.reset();
+}
+
 bool
 Interest::hasLink() const
 {
@@ -107,12 +107,39 @@ public:
   const Block&
   wireEncode() const;
 
+  /**
+   * @brief Encode to a wire format into a caller-provided buffer
+   *
+   * If the packet has no wire encoding yet, the encoded blocks of its fields are written
+   * into @p buffer directly, without creating the wire encoding of the packet itself.
+   *
+   * @param buffer     destination of the wire encoding
+   * @param bufferSize size of @p buffer, which must be at least wireEncode().size()
+   * @return number of bytes written into @p buffer
+   * @throw Error @p bufferSize is too small to hold the wire encoding
+   */
+  size_t
+  wireEncode(uint8_t* buffer, size_t bufferSize) const;
+
   /**
    * @brief Decode from the wire format
    */
   void
   wireDecode(const Block& wire);
 
+  /**
+   * @brief Decode from the wire format, deferring decoding of Selectors
+   *
+   * Selectors are decoded from the wire when they are first accessed, so that applications
+   * that only look at the Name (e.g., to dispatch the Interest to an InterestFilter) do not
+   * pay for decoding them.
+   *
+   * @note Malformed Selectors are reported by the first accessor that needs them, rather
+   *       than by this method.
+   */
+  void
+  wireDecodeLazy(const Block& wire);
+
   /**
    * @brief Check if already has wire
    */
@@ -345,18 +372,22 @@ public: // Selectors
   bool
   hasSelectors() const
   {
-    return !m_selectors.empty();
+    return !getSelectors().empty();
   }
 
   const Selectors&
   getSelectors() const
   {
+    if (m_pendingSelectors.hasWire())
+      decodeSelectors();
+
     return m_selectors;
   }
 
   Interest&
   setSelectors(const Selectors& selectors)
   {
+    m_pendingSelectors.reset();
     m_selectors = selectors;
     m_wire.reset();
     return *this;
@@ -365,12 +396,13 @@ public: // Selectors
   int
   getMinSuffixComponents() const
   {
-    return m_selectors.getMinSuffixComponents();
+    return getSelectors().getMinSuffixComponents();
   }
 
   Interest&
   setMinSuffixComponents(int minSuffixComponents)
   {
+    getSelectors(); // decode deferred Selectors before modifying them
     m_selectors.setMinSuffixComponents(minSuffixComponents);
     m_wire.reset();
     return *this;
@@ -379,12 +411,13 @@ public: // Selectors
   int
   getMaxSuffixComponents() const
   {
-    return m_selectors.getMaxSuffixComponents();
+    return getSelectors().getMaxSuffixComponents();
   }
 
   Interest&
   setMaxSuffixComponents(int maxSuffixComponents)
   {
+    getSelectors();
     m_selectors.setMaxSuffixComponents(maxSuffixComponents);
     m_wire.reset();
     return *this;
@@ -393,12 +426,13 @@ public: // Selectors
   const KeyLocator&
   getPublisherPublicKeyLocator() const
   {
-    return m_selectors.getPublisherPublicKeyLocator();
+    return getSelectors().getPublisherPublicKeyLocator();
   }
 
   Interest&
   setPublisherPublicKeyLocator(const KeyLocator& keyLocator)
   {
+    getSelectors();
     m_selectors.setPublisherPublicKeyLocator(keyLocator);
     m_wire.reset();
     return *this;
@@ -407,12 +441,13 @@ public: // Selectors
   const Exclude&
   getExclude() const
   {
-    return m_selectors.getExclude();
+    return getSelectors().getExclude();
   }
 
   Interest&
   setExclude(const Exclude& exclude)
   {
+    getSelectors();
     m_selectors.setExclude(exclude);
     m_wire.reset();
     return *this;
@@ -421,12 +456,13 @@ public: // Selectors
   int
   getChildSelector() const
   {
-    return m_selectors.getChildSelector();
+    return getSelectors().getChildSelector();
   }
 
   Interest&
   setChildSelector(int childSelector)
   {
+    getSelectors();
     m_selectors.setChildSelector(childSelector);
     m_wire.reset();
     return *this;
@@ -435,12 +471,13 @@ public: // Selectors
   int
   getMustBeFresh() const
   {
-    return m_selectors.getMustBeFresh();
+    return getSelectors().getMustBeFresh();
   }
 
   Interest&
   setMustBeFresh(bool mustBeFresh)
   {
+    getSelectors();
     m_selectors.setMustBeFresh(mustBeFresh);
     m_wire.reset();
     return *this;
@@ -459,9 +496,23 @@ public: // EqualityComparable concept
     return !(*this == other);
   }
 
+private:
+  /**
+   * @brief Use @p wire, just encoded from the current fields, as the wire encoding
+   */
+  void
+  adoptWire(const Block& wire) const;
+
+  /**
+   * @brief Decode Selectors deferred by wireDecodeLazy
+   */
+  void
+  decodeSelectors() const;
+
 private:
   Name m_name;
-  Selectors m_selectors;
+  mutable Selectors m_selectors;
+  mutable Block m_pendingSelectors; ///< Selectors element not yet decoded into m_selectors
   mutable Block m_nonce;
   int m_scope;
   time::milliseconds m_interestLifetime;
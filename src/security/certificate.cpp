@@ -43,22 +43,55 @@ static_assert(std::is_base_of<tlv::Error, Certificate::Error>::value,
               "Certificate::Error must inherit from tlv::Error");
 
 Certificate::Certificate()
-  : m_notBefore(time::system_clock::TimePoint::max())
+  : m_isDecoded(true)
+  , m_notBefore(time::system_clock::TimePoint::max())
   , m_notAfter(time::system_clock::TimePoint::min())
+  , m_decodeOnce(new std::once_flag)
 {
 }
 
 Certificate::Certificate(const Data& data)
   // Use the copy constructor.  It clones the signature object.
   : Data(data)
+  , m_isDecoded(false)
+  , m_decodeOnce(new std::once_flag)
 {
-  decode();
 }
 
 Certificate::Certificate(const Block& block)
   : Data(block)
+  , m_isDecoded(false)
+  , m_decodeOnce(new std::once_flag)
 {
-  decode();
+}
+
+Certificate::Certificate(const Certificate& other)
+  : Data(other)
+  , m_isDecoded(other.isContentDecodable())
+  , m_subjectDescriptionList(other.m_subjectDescriptionList)
+  , m_notBefore(other.m_notBefore)
+  , m_notAfter(other.m_notAfter)
+  , m_key(other.m_key)
+  , m_extensionList(other.m_extensionList)
+  , m_decodeOnce(new std::once_flag)
+{
+}
+
+Certificate&
+Certificate::operator=(const Certificate& other)
+{
+  if (this == &other)
+    return *this;
+
+  Data::operator=(other);
+  m_isDecoded = other.isContentDecodable();
+  m_subjectDescriptionList = other.m_subjectDescriptionList;
+  m_notBefore = other.m_notBefore;
+  m_notAfter = other.m_notAfter;
+  m_key = other.m_key;
+  m_extensionList = other.m_extensionList;
+  m_decodeOnce.reset(new std::once_flag);
+  return *this;
 }
 
 Certificate::~Certificate()
@@ -69,12 +102,14 @@ void
 Certificate::wireDecode(const Block& wire)
 {
   Data::wireDecode(wire);
-  decode();
+  m_isDecoded = false;
+  m_decodeOnce.reset(new std::once_flag);
 }
 
 bool
 Certificate::isTooEarly()
 {
+  decode();
   if (time::system_clock::now() < m_notBefore)
     return true;
   else
@@ -84,6 +119,7 @@ Certificate::isTooEarly()
 bool
 Certificate::isTooLate()
 {
+  decode();
   if (time::system_clock::now() > m_notAfter)
     return true;
   else
@@ -130,6 +166,9 @@ Certificate::encode()
 
   using namespace CryptoPP;
 
+  // fields that have not been accessed yet still need to be taken from the old content
+  decode();
+
   OBufferStream os;
   CryptoPP::FileSink sink(os);
 
@@ -194,7 +233,19 @@ Certificate::encode()
 }
 
 void
-Certificate::decode()
+Certificate::decode() const
+{
+  // call_once returns without marking the flag if decodeContent throws
+  std::call_once(*m_decodeOnce, [this] {
+      if (!m_isDecoded) {
+        decodeContent();
+        m_isDecoded = true;
+      }
+    });
+}
+
+void
+Certificate::decodeContent() const
 {
   using namespace CryptoPP;
 
@@ -265,9 +316,23 @@ Certificate::decode()
   }
 }
 
+bool
+Certificate::isContentDecodable() const
+{
+  try {
+    decode();
+    return true;
+  }
+  catch (const Error&) {
+    return false;
+  }
+}
+
 void
 Certificate::printCertificate(std::ostream& oss, const std::string& indent) const
 {
+  decode();
+
   util::IndentedStream os(oss, indent);
 
   os << "Certificate name:\n";
@@ -290,6 +355,9 @@ Certificate::printCertificate(std::ostream& oss, const std::string& indent) cons
   case KEY_TYPE_ECDSA:
     os << "(ECDSA)";
     break;
+  case KEY_TYPE_ED25519:
+    os << "(Ed25519)";
+    break;
   default:
     os << "(Unknown key type)";
     break;
@@ -315,6 +383,12 @@ Certificate::printCertificate(std::ostream& oss, const std::string& indent) cons
     case tlv::SignatureTypeValue::SignatureSha256WithEcdsa:
       os << "SignatureSha256WithEcdsa";
       break;
+    case tlv::SignatureTypeValue::SignatureHmacWithSha256:
+      os << "SignatureHmacWithSha256";
+      break;
+    case tlv::SignatureTypeValue::SignatureEd25519:
+      os << "SignatureEd25519";
+      break;
     default:
       os << "Unknown Signature Type";
     }
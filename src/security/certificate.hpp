@@ -32,6 +32,8 @@
 #include "certificate-extension.hpp"
 #include "public-key.hpp"
 
+#include <mutex>
+
 namespace ndn {
 
 class Certificate : public Data
@@ -57,6 +59,9 @@ public:
 
   /**
    * @brief Create a Certificate from the content in the data packet.
+   *
+   * The content is decoded on first access to the certificate fields, see decode().
+   *
    * @param data The data packet with the content to decode.
    */
   explicit
@@ -69,6 +74,17 @@ public:
   explicit
   Certificate(const Block& block);
 
+  /**
+   * @brief Copy a certificate
+   *
+   * The fields of @p other are decoded first, if possible, so that the copy does not race
+   * with a concurrent decoding of @p other.
+   */
+  Certificate(const Certificate& other);
+
+  Certificate&
+  operator=(const Certificate& other);
+
   virtual
   ~Certificate();
 
@@ -81,6 +97,32 @@ public:
   void
   encode();
 
+  /**
+   * @brief decode certificate info from content, unless already done
+   *
+   * Constructing or wire-decoding a certificate only decodes the Data packet.  Validity,
+   * subject description, public key, and extensions are decoded from the content when one
+   * of them is accessed for the first time.  Call this method to check the content eagerly.
+   *
+   * Decoding is done at most once, even when a const certificate is shared between threads.
+   * If it fails, it is attempted again on the next access.
+   *
+   * @throws Error if the content cannot be decoded
+   */
+  void
+  decode() const;
+
+  /**
+   * @brief decode certificate info from content, unless already done, without throwing
+   *
+   * Certificates loaded from files are checked with this method, so that a malformed one is
+   * rejected when it is loaded rather than when it is first used.
+   *
+   * @return whether the content can be decoded
+   */
+  bool
+  isContentDecodable() const;
+
   /**
    * @brief Add a subject description.
    * @param description The description to be added.
@@ -88,18 +130,21 @@ public:
   void
   addSubjectDescription(const CertificateSubjectDescription& description)
   {
+    decode();
     m_subjectDescriptionList.push_back(description);
   }
 
   const SubjectDescriptionList&
   getSubjectDescriptionList() const
   {
+    decode();
     return m_subjectDescriptionList;
   }
 
   SubjectDescriptionList&
   getSubjectDescriptionList()
   {
+    decode();
     return m_subjectDescriptionList;
   }
 
@@ -110,72 +155,84 @@ public:
   void
   addExtension(const CertificateExtension& extension)
   {
+    decode();
     m_extensionList.push_back(extension);
   }
 
   const ExtensionList&
   getExtensionList() const
   {
+    decode();
     return m_extensionList;
   }
 
   ExtensionList&
   getExtensionList()
   {
+    decode();
     return m_extensionList;
   }
 
   void
   setNotBefore(const time::system_clock::TimePoint& notBefore)
   {
+    decode();
     m_notBefore = notBefore;
   }
 
   time::system_clock::TimePoint&
   getNotBefore()
   {
+    decode();
     return m_notBefore;
   }
 
   const time::system_clock::TimePoint&
   getNotBefore() const
   {
+    decode();
     return m_notBefore;
   }
 
   void
   setNotAfter(const time::system_clock::TimePoint& notAfter)
   {
+    decode();
     m_notAfter = notAfter;
   }
 
   time::system_clock::TimePoint&
   getNotAfter()
   {
+    decode();
     return m_notAfter;
   }
 
   const time::system_clock::TimePoint&
   getNotAfter() const
   {
+    decode();
     return m_notAfter;
   }
 
   void
   setPublicKeyInfo(const PublicKey& key)
   {
+    decode();
     m_key = key;
   }
 
   PublicKey&
   getPublicKeyInfo()
   {
+    decode();
     return m_key;
   }
 
   const PublicKey&
   getPublicKeyInfo() const
   {
+    decode();
     return m_key;
   }
 
@@ -197,15 +254,21 @@ public:
   printCertificate(std::ostream& os, const std::string& indent = "") const;
 
 protected:
+  /// whether the fields below reflect the content; they are decoded lazily
+  mutable bool m_isDecoded;
+  mutable SubjectDescriptionList m_subjectDescriptionList;
+  mutable time::system_clock::TimePoint m_notBefore;
+  mutable time::system_clock::TimePoint m_notAfter;
+  mutable PublicKey m_key;
+  mutable ExtensionList m_extensionList;
+
+private:
   void
-  decode();
+  decodeContent() const;
 
-protected:
-  SubjectDescriptionList m_subjectDescriptionList;
-  time::system_clock::TimePoint m_notBefore;
-  time::system_clock::TimePoint m_notAfter;
-  PublicKey m_key;
-  ExtensionList m_extensionList;
+private:
+  /// serializes the lazy decoding; replaced whenever the content is replaced
+  unique_ptr<std::once_flag> m_decodeOnce;
 };
 
 std::ostream&
@@ -101,6 +101,8 @@ public:
       {
       case tlv::SignatureSha256WithRsa:
       case tlv::SignatureSha256WithEcdsa:
+      case tlv::SignatureEd25519:
+      case tlv::SignatureHmacWithSha256:
         {
           if (!static_cast<bool>(m_keyLocatorChecker))
             throw Error("Strong signature requires KeyLocatorChecker");
@@ -172,6 +174,8 @@ private:
           {
           case tlv::SignatureSha256WithRsa:
           case tlv::SignatureSha256WithEcdsa:
+          case tlv::SignatureEd25519:
+          case tlv::SignatureHmacWithSha256:
             {
               if (!signature.hasKeyLocator()) {
                 onValidationFailed(packet.shared_from_this(),
@@ -242,7 +246,8 @@ public:
       m_signers[(*it)->getName().getPrefix(-1)] = (*it);
 
     if (sigType != tlv::SignatureSha256WithRsa &&
-        sigType != tlv::SignatureSha256WithEcdsa)
+        sigType != tlv::SignatureSha256WithEcdsa &&
+        sigType != tlv::SignatureEd25519)
       {
         throw Error("FixedSigner is only meaningful for strong signature type");
       }
@@ -311,6 +316,7 @@ private:
           {
           case tlv::SignatureSha256WithRsa:
           case tlv::SignatureSha256WithEcdsa:
+          case tlv::SignatureEd25519:
             {
               if (!signature.hasKeyLocator()) {
                 onValidationFailed(packet.shared_from_this(),
@@ -512,7 +518,7 @@ private:
         shared_ptr<IdentityCertificate> idCert
           = io::load<IdentityCertificate>(certfilePath.c_str());
 
-        if (static_cast<bool>(idCert))
+        if (idCert != nullptr && idCert->isContentDecodable())
           return idCert;
         else
           throw Error("Cannot read certificate from file: " +
@@ -533,7 +539,7 @@ private:
 
         shared_ptr<IdentityCertificate> idCert = io::load<IdentityCertificate>(ss);
 
-        if (static_cast<bool>(idCert))
+        if (idCert != nullptr && idCert->isContentDecodable())
           return idCert;
         else
           throw Error("Cannot decode certificate from string");
@@ -549,6 +555,10 @@ private:
       return tlv::SignatureSha256WithRsa;
     else if (boost::iequals(sigType, "ecdsa-sha256"))
       return tlv::SignatureSha256WithEcdsa;
+    else if (boost::iequals(sigType, "ed25519"))
+      return tlv::SignatureEd25519;
+    else if (boost::iequals(sigType, "hmac-sha256"))
+      return tlv::SignatureHmacWithSha256;
     else if (boost::iequals(sigType, "sha256"))
       return tlv::DigestSha256;
     else
@@ -0,0 +1,260 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "crypto-backend-cryptopp.hpp"
+
+#include "../encoding/buffer-stream.hpp"
+#include "../encoding/oid.hpp"
+#include "cryptopp.hpp"
+
+namespace ndn {
+
+static const OID SECP256R1("1.2.840.10045.3.1.7");
+static const OID SECP384R1("1.3.132.0.34");
+
+std::string
+CryptoBackendCryptopp::getName() const
+{
+  return "cryptopp";
+}
+
+bool
+CryptoBackendCryptopp::isKeyTypeSupported(KeyType keyType) const
+{
+  return keyType == KEY_TYPE_RSA || keyType == KEY_TYPE_ECDSA;
+}
+
+void
+CryptoBackendCryptopp::generateKeyPair(KeyType keyType, uint32_t keySize,
+                                       std::string& privateKey, std::string& publicKey) const
+{
+  try
+    {
+      using namespace CryptoPP;
+      AutoSeededRandomPool rng;
+      StringSink privateKeySink(privateKey);
+      StringSink publicKeySink(publicKey);
+
+      switch (keyType)
+        {
+        case KEY_TYPE_RSA:
+          {
+            InvertibleRSAFunction key;
+            key.Initialize(rng, keySize);
+            key.DEREncode(privateKeySink);
+
+            RSAFunction pubKey(key);
+            pubKey.DEREncode(publicKeySink);
+            break;
+          }
+        case KEY_TYPE_ECDSA:
+          {
+            CryptoPP::OID curveName = keySize == 384 ? ASN1::secp384r1() : ASN1::secp256r1();
+
+            ECDSA<ECP, SHA256>::PrivateKey key;
+            DL_GroupParameters_EC<ECP> cryptoParams(curveName);
+            cryptoParams.SetEncodeAsOID(true);
+            key.Initialize(rng, cryptoParams);
+
+            ECDSA<ECP, SHA256>::PublicKey pubKey;
+            key.MakePublicKey(pubKey);
+            pubKey.AccessGroupParameters().SetEncodeAsOID(true);
+
+            key.DEREncode(privateKeySink);
+            pubKey.Save(publicKeySink);
+            break;
+          }
+        default:
+          throw Error("Unsupported key type");
+        }
+    }
+  catch (CryptoPP::Exception& e)
+    {
+      throw Error(e.what());
+    }
+}
+
+ConstBufferPtr
+CryptoBackendCryptopp::derivePublicKey(KeyType keyType,
+                                       const uint8_t* privateKey, size_t privateKeySize) const
+{
+  try
+    {
+      using namespace CryptoPP;
+      OBufferStream publicKeyOs;
+      FileSink publicKeySink(publicKeyOs);
+
+      switch (keyType)
+        {
+        case KEY_TYPE_RSA:
+          {
+            RSA::PrivateKey key;
+            key.Load(StringStore(privateKey, privateKeySize).Ref());
+            RSAFunction pubKey(key);
+
+            pubKey.DEREncode(publicKeySink);
+            break;
+          }
+        case KEY_TYPE_ECDSA:
+          {
+            ECDSA<ECP, SHA256>::PrivateKey key;
+            key.Load(StringStore(privateKey, privateKeySize).Ref());
+
+            ECDSA<ECP, SHA256>::PublicKey pubKey;
+            key.MakePublicKey(pubKey);
+            pubKey.AccessGroupParameters().SetEncodeAsOID(true);
+
+            pubKey.DEREncode(publicKeySink);
+            break;
+          }
+        default:
+          throw Error("Unsupported key type");
+        }
+
+      publicKeySink.MessageEnd();
+      return publicKeyOs.buf();
+    }
+  catch (CryptoPP::Exception& e)
+    {
+      throw Error(e.what());
+    }
+}
+
+ConstBufferPtr
+CryptoBackendCryptopp::sign(KeyType keyType, const uint8_t* privateKey, size_t privateKeySize,
+                            const uint8_t* data, size_t dataLength,
+                            DigestAlgorithm digestAlgorithm) const
+{
+  if (digestAlgorithm != DIGEST_ALGORITHM_SHA256)
+    throw Error("Unsupported digest algorithm");
+
+  try
+    {
+      using namespace CryptoPP;
+      AutoSeededRandomPool rng;
+      StringSource keySource(privateKey, privateKeySize, true);
+
+      switch (keyType)
+        {
+        case KEY_TYPE_RSA:
+          {
+            RSA::PrivateKey key;
+            key.Load(keySource);
+            RSASS<PKCS1v15, SHA256>::Signer signer(key);
+
+            OBufferStream os;
+            StringSource(data, dataLength, true, new SignerFilter(rng, signer, new FileSink(os)));
+            return os.buf();
+          }
+        case KEY_TYPE_ECDSA:
+          {
+            ECDSA<ECP, SHA256>::PrivateKey key;
+            key.Load(keySource);
+            ECDSA<ECP, SHA256>::Signer signer(key);
+
+            OBufferStream os;
+            StringSource(data, dataLength, true, new SignerFilter(rng, signer, new FileSink(os)));
+
+            uint8_t buf[200];
+            size_t bufSize = DSAConvertSignatureFormat(buf, sizeof(buf), DSA_DER,
+                                                       os.buf()->buf(), os.buf()->size(),
+                                                       DSA_P1363);
+            return make_shared<Buffer>(buf, bufSize);
+          }
+        default:
+          throw Error("Unsupported key type");
+        }
+    }
+  catch (CryptoPP::Exception& e)
+    {
+      throw Error(e.what());
+    }
+}
+
+bool
+CryptoBackendCryptopp::verify(KeyType keyType, const uint8_t* publicKey, size_t publicKeySize,
+                              const uint8_t* data, size_t dataLength,
+                              const uint8_t* sig, size_t sigLength,
+                              DigestAlgorithm digestAlgorithm) const
+{
+  if (digestAlgorithm != DIGEST_ALGORITHM_SHA256)
+    return false;
+
+  try
+    {
+      using namespace CryptoPP;
+
+      switch (keyType)
+        {
+        case KEY_TYPE_RSA:
+          {
+            RSA::PublicKey key;
+            StringSource keySource(publicKey, publicKeySize, true);
+            key.Load(keySource);
+
+            RSASS<PKCS1v15, SHA256>::Verifier verifier(key);
+            return verifier.VerifyMessage(data, dataLength, sig, sigLength);
+          }
+        case KEY_TYPE_ECDSA:
+          {
+            ECDSA<ECP, SHA256>::PublicKey key;
+            StringSource keySource(publicKey, publicKeySize, true);
+            key.Load(keySource);
+
+            ECDSA<ECP, SHA256>::Verifier verifier(key);
+
+            size_t length = 0;
+            StringSource src(publicKey, publicKeySize, true);
+            BERSequenceDecoder subjectPublicKeyInfo(src);
+            {
+              BERSequenceDecoder algorithmInfo(subjectPublicKeyInfo);
+              {
+                OID algorithm;
+                algorithm.decode(algorithmInfo);
+
+                OID curveId;
+                curveId.decode(algorithmInfo);
+
+                if (curveId == SECP256R1)
+                  length = 64;
+                else if (curveId == SECP384R1)
+                  length = 96;
+                else
+                  return false;
+              }
+            }
+
+            uint8_t buffer[96];
+            size_t usedSize = DSAConvertSignatureFormat(buffer, length, DSA_P1363,
+                                                        sig, sigLength, DSA_DER);
+            return verifier.VerifyMessage(data, dataLength, buffer, usedSize);
+          }
+        default:
+          return false;
+        }
+    }
+  catch (CryptoPP::Exception& e)
+    {
+      return false;
+    }
+}
+
+} // namespace ndn
@@ -0,0 +1,64 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_SECURITY_CRYPTO_BACKEND_CRYPTOPP_HPP
+#define NDN_SECURITY_CRYPTO_BACKEND_CRYPTOPP_HPP
+
+#include "crypto-backend.hpp"
+
+namespace ndn {
+
+/**
+ * @brief CryptoBackend implemented with CryptoPP
+ *
+ * Supports RSA and ECDSA keys.
+ */
+class CryptoBackendCryptopp : public CryptoBackend
+{
+public:
+  virtual std::string
+  getName() const NDN_CXX_DECL_OVERRIDE;
+
+  virtual bool
+  isKeyTypeSupported(KeyType keyType) const NDN_CXX_DECL_OVERRIDE;
+
+  virtual void
+  generateKeyPair(KeyType keyType, uint32_t keySize,
+                  std::string& privateKey, std::string& publicKey) const NDN_CXX_DECL_OVERRIDE;
+
+  virtual ConstBufferPtr
+  derivePublicKey(KeyType keyType, const uint8_t* privateKey,
+                  size_t privateKeySize) const NDN_CXX_DECL_OVERRIDE;
+
+  virtual ConstBufferPtr
+  sign(KeyType keyType, const uint8_t* privateKey, size_t privateKeySize,
+       const uint8_t* data, size_t dataLength,
+       DigestAlgorithm digestAlgorithm) const NDN_CXX_DECL_OVERRIDE;
+
+  virtual bool
+  verify(KeyType keyType, const uint8_t* publicKey, size_t publicKeySize,
+         const uint8_t* data, size_t dataLength, const uint8_t* sig, size_t sigLength,
+         DigestAlgorithm digestAlgorithm) const NDN_CXX_DECL_OVERRIDE;
+};
+
+} // namespace ndn
+
+#endif // NDN_SECURITY_CRYPTO_BACKEND_CRYPTOPP_HPP
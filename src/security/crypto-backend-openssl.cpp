@@ -0,0 +1,367 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "crypto-backend-openssl.hpp"
+#include "openssl.hpp"
+
+namespace ndn {
+
+struct EvpPkeyDeleter
+{
+  void
+  operator()(EVP_PKEY* key) const
+  {
+    EVP_PKEY_free(key);
+  }
+};
+
+struct EvpMdCtxDeleter
+{
+  void
+  operator()(EVP_MD_CTX* ctx) const
+  {
+    EVP_MD_CTX_destroy(ctx);
+  }
+};
+
+struct EvpPkeyCtxDeleter
+{
+  void
+  operator()(EVP_PKEY_CTX* ctx) const
+  {
+    EVP_PKEY_CTX_free(ctx);
+  }
+};
+
+struct Pkcs8PrivKeyInfoDeleter
+{
+  void
+  operator()(PKCS8_PRIV_KEY_INFO* info) const
+  {
+    PKCS8_PRIV_KEY_INFO_free(info);
+  }
+};
+
+typedef unique_ptr<EVP_PKEY, EvpPkeyDeleter> EvpPkeyPtr;
+typedef unique_ptr<EVP_MD_CTX, EvpMdCtxDeleter> EvpMdCtxPtr;
+typedef unique_ptr<EVP_PKEY_CTX, EvpPkeyCtxDeleter> EvpPkeyCtxPtr;
+typedef unique_ptr<PKCS8_PRIV_KEY_INFO, Pkcs8PrivKeyInfoDeleter> Pkcs8PrivKeyInfoPtr;
+
+static const EVP_MD*
+getDigest(DigestAlgorithm digestAlgorithm)
+{
+  switch (digestAlgorithm) {
+  case DIGEST_ALGORITHM_SHA256:
+    return EVP_sha256();
+  default:
+    return nullptr;
+  }
+}
+
+static bool
+isKeyType(const EvpPkeyPtr& key, KeyType keyType)
+{
+  switch (keyType) {
+  case KEY_TYPE_RSA:
+    return EVP_PKEY_base_id(key.get()) == EVP_PKEY_RSA;
+  case KEY_TYPE_ECDSA:
+    return EVP_PKEY_base_id(key.get()) == EVP_PKEY_EC;
+#ifdef EVP_PKEY_ED25519
+  case KEY_TYPE_ED25519:
+    return EVP_PKEY_base_id(key.get()) == EVP_PKEY_ED25519;
+#endif // EVP_PKEY_ED25519
+  default:
+    return false;
+  }
+}
+
+static EvpPkeyPtr
+decodePrivateKey(KeyType keyType, const uint8_t* privateKey, size_t privateKeySize)
+{
+  const unsigned char* keyBytes = privateKey;
+  EvpPkeyPtr key(d2i_AutoPrivateKey(nullptr, &keyBytes, privateKeySize));
+  if (key == nullptr) {
+    ERR_clear_error();
+    throw CryptoBackend::Error("Cannot decode private key");
+  }
+  if (!isKeyType(key, keyType))
+    throw CryptoBackend::Error("Unsupported key type");
+
+  return key;
+}
+
+static EvpPkeyPtr
+generateKey(KeyType keyType, uint32_t keySize)
+{
+  EVP_PKEY* key = nullptr;
+
+  switch (keyType) {
+  case KEY_TYPE_RSA: {
+    EvpPkeyCtxPtr ctx(EVP_PKEY_CTX_new_id(EVP_PKEY_RSA, nullptr));
+    if (ctx == nullptr ||
+        EVP_PKEY_keygen_init(ctx.get()) != 1 ||
+        EVP_PKEY_CTX_set_rsa_keygen_bits(ctx.get(), keySize) != 1 ||
+        EVP_PKEY_keygen(ctx.get(), &key) != 1)
+      return nullptr;
+    break;
+  }
+  case KEY_TYPE_ECDSA: {
+    int curve = keySize == 384 ? NID_secp384r1 : NID_X9_62_prime256v1;
+
+    EVP_PKEY* params = nullptr;
+    EvpPkeyCtxPtr paramCtx(EVP_PKEY_CTX_new_id(EVP_PKEY_EC, nullptr));
+    if (paramCtx == nullptr ||
+        EVP_PKEY_paramgen_init(paramCtx.get()) != 1 ||
+        EVP_PKEY_CTX_set_ec_paramgen_curve_nid(paramCtx.get(), curve) != 1 ||
+        EVP_PKEY_paramgen(paramCtx.get(), &params) != 1)
+      return nullptr;
+    EvpPkeyPtr paramsGuard(params);
+
+    EvpPkeyCtxPtr ctx(EVP_PKEY_CTX_new(params, nullptr));
+    if (ctx == nullptr ||
+        EVP_PKEY_keygen_init(ctx.get()) != 1 ||
+        EVP_PKEY_keygen(ctx.get(), &key) != 1)
+      return nullptr;
+
+#if OPENSSL_VERSION_NUMBER < 0x10100000L
+    // older versions encode explicit curve parameters, which CryptoPP-based code cannot load
+    EC_KEY* ecKey = EVP_PKEY_get1_EC_KEY(key);
+    EC_KEY_set_asn1_flag(ecKey, OPENSSL_EC_NAMED_CURVE);
+    EC_KEY_free(ecKey);
+#endif // OPENSSL_VERSION_NUMBER < 0x10100000L
+    break;
+  }
+#ifdef EVP_PKEY_ED25519
+  case KEY_TYPE_ED25519: {
+    EvpPkeyCtxPtr ctx(EVP_PKEY_CTX_new_id(EVP_PKEY_ED25519, nullptr));
+    if (ctx == nullptr ||
+        EVP_PKEY_keygen_init(ctx.get()) != 1 ||
+        EVP_PKEY_keygen(ctx.get(), &key) != 1)
+      return nullptr;
+    break;
+  }
+#endif // EVP_PKEY_ED25519
+  default:
+    throw CryptoBackend::Error("Unsupported key type");
+  }
+
+  return EvpPkeyPtr(key);
+}
+
+/**
+ * @brief Encode the public key as SubjectPublicKeyInfo
+ */
+static ConstBufferPtr
+encodePublicKey(const EvpPkeyPtr& key)
+{
+  int length = i2d_PUBKEY(key.get(), nullptr);
+  if (length <= 0) {
+    ERR_clear_error();
+    throw CryptoBackend::Error("Cannot encode public key");
+  }
+
+  shared_ptr<Buffer> publicKey = make_shared<Buffer>(length);
+  unsigned char* out = publicKey->buf();
+  if (i2d_PUBKEY(key.get(), &out) != length) {
+    ERR_clear_error();
+    throw CryptoBackend::Error("Cannot encode public key");
+  }
+
+  return publicKey;
+}
+
+/**
+ * @brief Encode the private key as PKCS #8 PrivateKeyInfo
+ */
+static ConstBufferPtr
+encodePrivateKey(const EvpPkeyPtr& key)
+{
+  Pkcs8PrivKeyInfoPtr info(EVP_PKEY2PKCS8(key.get()));
+  int length = info == nullptr ? 0 : i2d_PKCS8_PRIV_KEY_INFO(info.get(), nullptr);
+  if (length <= 0) {
+    ERR_clear_error();
+    throw CryptoBackend::Error("Cannot encode private key");
+  }
+
+  shared_ptr<Buffer> privateKey = make_shared<Buffer>(length);
+  unsigned char* out = privateKey->buf();
+  if (i2d_PKCS8_PRIV_KEY_INFO(info.get(), &out) != length) {
+    ERR_clear_error();
+    throw CryptoBackend::Error("Cannot encode private key");
+  }
+
+  return privateKey;
+}
+
+std::string
+CryptoBackendOpenssl::getName() const
+{
+  return "openssl";
+}
+
+bool
+CryptoBackendOpenssl::isKeyTypeSupported(KeyType keyType) const
+{
+  switch (keyType) {
+  case KEY_TYPE_RSA:
+  case KEY_TYPE_ECDSA:
+    return true;
+#ifdef EVP_PKEY_ED25519
+  case KEY_TYPE_ED25519:
+    return true;
+#endif // EVP_PKEY_ED25519
+  default:
+    return false;
+  }
+}
+
+bool
+CryptoBackendOpenssl::isThreadSafe() const
+{
+#if OPENSSL_VERSION_NUMBER < 0x10100000L
+  return false;
+#else
+  return true;
+#endif // OPENSSL_VERSION_NUMBER < 0x10100000L
+}
+
+void
+CryptoBackendOpenssl::generateKeyPair(KeyType keyType, uint32_t keySize,
+                                      std::string& privateKey, std::string& publicKey) const
+{
+  EvpPkeyPtr key = generateKey(keyType, keySize);
+  if (key == nullptr) {
+    ERR_clear_error();
+    throw Error("Cannot generate key pair");
+  }
+
+  ConstBufferPtr privateKeyBits = encodePrivateKey(key);
+  ConstBufferPtr publicKeyBits = encodePublicKey(key);
+  privateKey.assign(privateKeyBits->begin(), privateKeyBits->end());
+  publicKey.assign(publicKeyBits->begin(), publicKeyBits->end());
+}
+
+ConstBufferPtr
+CryptoBackendOpenssl::derivePublicKey(KeyType keyType,
+                                      const uint8_t* privateKey, size_t privateKeySize) const
+{
+  return encodePublicKey(decodePrivateKey(keyType, privateKey, privateKeySize));
+}
+
+ConstBufferPtr
+CryptoBackendOpenssl::sign(KeyType keyType, const uint8_t* privateKey, size_t privateKeySize,
+                           const uint8_t* data, size_t dataLength,
+                           DigestAlgorithm digestAlgorithm) const
+{
+  EvpPkeyPtr key = decodePrivateKey(keyType, privateKey, privateKeySize);
+
+#ifdef EVP_PKEY_ED25519
+  if (keyType == KEY_TYPE_ED25519) {
+    // Ed25519 hashes the message internally and only supports one-shot signing
+    EvpMdCtxPtr ctx(EVP_MD_CTX_create());
+    size_t sigLength = 0;
+    if (ctx == nullptr ||
+        EVP_DigestSignInit(ctx.get(), nullptr, nullptr, nullptr, key.get()) != 1 ||
+        EVP_DigestSign(ctx.get(), nullptr, &sigLength, data, dataLength) != 1) {
+      ERR_clear_error();
+      throw Error("Cannot sign data");
+    }
+
+    shared_ptr<Buffer> sig = make_shared<Buffer>(sigLength);
+    if (EVP_DigestSign(ctx.get(), sig->buf(), &sigLength, data, dataLength) != 1) {
+      ERR_clear_error();
+      throw Error("Cannot sign data");
+    }
+    sig->resize(sigLength);
+
+    return sig;
+  }
+#endif // EVP_PKEY_ED25519
+
+  const EVP_MD* md = getDigest(digestAlgorithm);
+  if (md == nullptr)
+    throw Error("Unsupported digest algorithm");
+
+  EvpMdCtxPtr ctx(EVP_MD_CTX_create());
+  size_t sigLength = 0;
+  if (ctx == nullptr ||
+      EVP_DigestSignInit(ctx.get(), nullptr, md, nullptr, key.get()) != 1 ||
+      EVP_DigestSignUpdate(ctx.get(), data, dataLength) != 1 ||
+      EVP_DigestSignFinal(ctx.get(), nullptr, &sigLength) != 1) {
+    ERR_clear_error();
+    throw Error("Cannot sign data");
+  }
+
+  // the maximum ECDSA signature length is returned, DER encoding of the actual one can be shorter
+  shared_ptr<Buffer> sig = make_shared<Buffer>(sigLength);
+  if (EVP_DigestSignFinal(ctx.get(), sig->buf(), &sigLength) != 1) {
+    ERR_clear_error();
+    throw Error("Cannot sign data");
+  }
+  sig->resize(sigLength);
+
+  return sig;
+}
+
+bool
+CryptoBackendOpenssl::verify(KeyType keyType, const uint8_t* publicKey, size_t publicKeySize,
+                             const uint8_t* data, size_t dataLength,
+                             const uint8_t* sig, size_t sigLength,
+                             DigestAlgorithm digestAlgorithm) const
+{
+  const unsigned char* keyBytes = publicKey;
+  EvpPkeyPtr key(d2i_PUBKEY(nullptr, &keyBytes, publicKeySize));
+  if (key == nullptr || !isKeyType(key, keyType)) {
+    ERR_clear_error();
+    return false;
+  }
+
+  EvpMdCtxPtr ctx(EVP_MD_CTX_create());
+
+#ifdef EVP_PKEY_ED25519
+  if (keyType == KEY_TYPE_ED25519) {
+    bool isValid = ctx != nullptr &&
+                   EVP_DigestVerifyInit(ctx.get(), nullptr, nullptr, nullptr, key.get()) == 1 &&
+                   EVP_DigestVerify(ctx.get(), sig, sigLength, data, dataLength) == 1;
+    if (!isValid)
+      ERR_clear_error();
+
+    return isValid;
+  }
+#endif // EVP_PKEY_ED25519
+
+  const EVP_MD* md = getDigest(digestAlgorithm);
+  if (md == nullptr)
+    return false;
+
+  bool isValid = ctx != nullptr &&
+                 EVP_DigestVerifyInit(ctx.get(), nullptr, md, nullptr, key.get()) == 1 &&
+                 EVP_DigestVerifyUpdate(ctx.get(), data, dataLength) == 1 &&
+                 EVP_DigestVerifyFinal(ctx.get(), sig, sigLength) == 1;
+  if (!isValid) {
+    // a bad signature leaves errors in the thread's error queue
+    ERR_clear_error();
+  }
+
+  return isValid;
+}
+
+} // namespace ndn
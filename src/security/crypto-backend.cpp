@@ -0,0 +1,87 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "crypto-backend.hpp"
+#include "crypto-backend-cryptopp.hpp"
+
+#ifdef NDN_CXX_HAVE_OPENSSL
+#include "crypto-backend-openssl.hpp"
+#endif // NDN_CXX_HAVE_OPENSSL
+
+#include <boost/lexical_cast.hpp>
+
+namespace ndn {
+
+CryptoBackend::~CryptoBackend()
+{
+}
+
+bool
+CryptoBackend::isThreadSafe() const
+{
+  return true;
+}
+
+const CryptoBackend&
+CryptoBackend::getDefault()
+{
+  static const CryptoBackend* backend = find(NDN_CXX_CRYPTO_BACKEND);
+  BOOST_ASSERT(backend != nullptr);
+  return *backend;
+}
+
+const CryptoBackend&
+CryptoBackend::getDefault(KeyType keyType)
+{
+  const CryptoBackend& backend = getDefault();
+  if (backend.isKeyTypeSupported(keyType))
+    return backend;
+
+  static const char* const NAMES[] = {"cryptopp", "openssl"};
+  for (const char* name : NAMES) {
+    const CryptoBackend* other = find(name);
+    if (other != nullptr && other->isKeyTypeSupported(keyType))
+      return *other;
+  }
+
+  throw Error("No crypto backend supports key type " +
+              boost::lexical_cast<std::string>(static_cast<int>(keyType)));
+}
+
+const CryptoBackend*
+CryptoBackend::find(const std::string& name)
+{
+  if (name == "cryptopp") {
+    static CryptoBackendCryptopp cryptopp;
+    return &cryptopp;
+  }
+
+#ifdef NDN_CXX_HAVE_OPENSSL
+  if (name == "openssl") {
+    static CryptoBackendOpenssl openssl;
+    return &openssl;
+  }
+#endif // NDN_CXX_HAVE_OPENSSL
+
+  return nullptr;
+}
+
+} // namespace ndn
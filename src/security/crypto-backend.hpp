@@ -0,0 +1,173 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_SECURITY_CRYPTO_BACKEND_HPP
+#define NDN_SECURITY_CRYPTO_BACKEND_HPP
+
+#include "../common.hpp"
+#include "../encoding/buffer.hpp"
+#include "security-common.hpp"
+
+namespace ndn {
+
+/**
+ * @brief Public key signature primitives used by SecTpmFile and Validator
+ *
+ * Keys are passed in the encodings stored by SecTpmFile and carried in certificates: private
+ * keys as DER-encoded PKCS #8 PrivateKeyInfo, public keys as DER-encoded SubjectPublicKeyInfo.
+ * RSA signatures are RSASSA-PKCS1-v1_5; ECDSA signature values are DER-encoded, as in
+ * SignatureSha256WithEcdsa; Ed25519 signatures are as defined in RFC 8032.
+ *
+ * The backend used by the library is selected at configure time with
+ * `./waf configure --crypto-backend=cryptopp|openssl`.  Key types that the selected backend
+ * does not support (Ed25519 with CryptoPP) are handled by another compiled-in backend, see
+ * getDefault(KeyType).  Backends are stateless, and their methods can be called from several
+ * threads concurrently unless isThreadSafe() returns false.
+ */
+class CryptoBackend : noncopyable
+{
+public:
+  class Error : public std::runtime_error
+  {
+  public:
+    explicit
+    Error(const std::string& what)
+      : std::runtime_error(what)
+    {
+    }
+  };
+
+  virtual
+  ~CryptoBackend();
+
+  /**
+   * @brief Get the name of the backend, e.g., "cryptopp"
+   */
+  virtual std::string
+  getName() const = 0;
+
+  /**
+   * @brief Check whether keys of @p keyType can be generated and used by this backend
+   */
+  virtual bool
+  isKeyTypeSupported(KeyType keyType) const = 0;
+
+  /**
+   * @brief Check whether the methods of this backend may be called from several threads
+   *        concurrently
+   *
+   * The default implementation returns true.
+   */
+  virtual bool
+  isThreadSafe() const;
+
+  /**
+   * @brief Generate a key pair
+   *
+   * @param keyType KEY_TYPE_RSA, KEY_TYPE_ECDSA or KEY_TYPE_ED25519
+   * @param keySize the key size in bits, which is ignored for Ed25519
+   * @param[out] privateKey the PKCS #8 encoded private key
+   * @param[out] publicKey the SubjectPublicKeyInfo encoded public key
+   * @throw Error the key type is not supported, or key generation fails
+   */
+  virtual void
+  generateKeyPair(KeyType keyType, uint32_t keySize,
+                  std::string& privateKey, std::string& publicKey) const = 0;
+
+  /**
+   * @brief Derive the public key from a private key
+   *
+   * @param keyType KEY_TYPE_RSA, KEY_TYPE_ECDSA or KEY_TYPE_ED25519
+   * @param privateKey the PKCS #8 encoded private key
+   * @param privateKeySize the size of the private key
+   * @return the SubjectPublicKeyInfo encoded public key
+   * @throw Error the key cannot be decoded or is not of @p keyType
+   */
+  virtual ConstBufferPtr
+  derivePublicKey(KeyType keyType, const uint8_t* privateKey, size_t privateKeySize) const = 0;
+
+  /**
+   * @brief Sign data with a private key
+   *
+   * The digest algorithm is ignored for Ed25519, which hashes the data internally.
+   *
+   * @param keyType KEY_TYPE_RSA, KEY_TYPE_ECDSA or KEY_TYPE_ED25519
+   * @param privateKey the PKCS #8 encoded private key
+   * @param privateKeySize the size of the private key
+   * @param data the data to sign
+   * @param dataLength the length of the data
+   * @param digestAlgorithm the digest algorithm
+   * @return the signature value
+   * @throw Error the key cannot be decoded or is not of @p keyType, or signing fails
+   */
+  virtual ConstBufferPtr
+  sign(KeyType keyType, const uint8_t* privateKey, size_t privateKeySize,
+       const uint8_t* data, size_t dataLength, DigestAlgorithm digestAlgorithm) const = 0;
+
+  /**
+   * @brief Verify a signature with a public key
+   *
+   * @param keyType KEY_TYPE_RSA, KEY_TYPE_ECDSA or KEY_TYPE_ED25519
+   * @param publicKey the SubjectPublicKeyInfo encoded public key
+   * @param publicKeySize the size of the public key
+   * @param data the signed data
+   * @param dataLength the length of the signed data
+   * @param sig the signature value
+   * @param sigLength the length of the signature value
+   * @param digestAlgorithm the digest algorithm
+   * @return true if the signature is valid; false if it is not, or if the key cannot be decoded
+   *         or is not of @p keyType
+   */
+  virtual bool
+  verify(KeyType keyType, const uint8_t* publicKey, size_t publicKeySize,
+         const uint8_t* data, size_t dataLength, const uint8_t* sig, size_t sigLength,
+         DigestAlgorithm digestAlgorithm) const = 0;
+
+public:
+  /**
+   * @brief Get the backend selected at configure time
+   */
+  static const CryptoBackend&
+  getDefault();
+
+  /**
+   * @brief Get the backend for keys of @p keyType
+   *
+   * This is the backend selected at configure time if it supports @p keyType, otherwise
+   * another compiled-in backend that does.
+   *
+   * @throw Error no compiled-in backend supports @p keyType
+   */
+  static const CryptoBackend&
+  getDefault(KeyType keyType);
+
+  /**
+   * @brief Get a backend by name
+   *
+   * @return the backend, or nullptr if there is no such backend or it is not compiled in
+   */
+  static const CryptoBackend*
+  find(const std::string& name);
+};
+
+} // namespace ndn
+
+#endif // NDN_SECURITY_CRYPTO_BACKEND_HPP
@@ -35,6 +35,55 @@
 namespace ndn {
 namespace security {
 
+/** @brief Keeps the key pairs of a key chain generated in advance, on top of the reserve of
+ *         the application, which is restored when the chain is built or fails
+ */
+class KeyPairReservation : noncopyable
+{
+public:
+  KeyPairReservation(KeyChain& keyChain, const shared_ptr<KeyParams>& params, size_t nKeys)
+    : m_keyChain(keyChain)
+    , m_params(params)
+    , m_nPrevious(0)
+  {
+    if (m_params == nullptr)
+      return;
+
+    m_nPrevious = m_keyChain.getKeyPairReserve(*m_params);
+    m_keyChain.reserveKeyPairs(*m_params, m_nPrevious + nKeys);
+  }
+
+  /** @brief Shrinks the reservation as the keys of the chain are generated, so that no key
+   *         pairs are generated beyond the chain
+   */
+  void
+  setRemaining(size_t nKeys)
+  {
+    if (m_params != nullptr)
+      m_keyChain.reserveKeyPairs(*m_params, m_nPrevious + nKeys);
+  }
+
+  ~KeyPairReservation()
+  {
+    if (m_params == nullptr)
+      return;
+
+    try
+      {
+        m_keyChain.reserveKeyPairs(*m_params, m_nPrevious);
+      }
+    catch (...)
+      {
+        // the reserve only saves time, its failure must not replace the outcome of the chain
+      }
+  }
+
+private:
+  KeyChain& m_keyChain;
+  shared_ptr<KeyParams> m_params;
+  size_t m_nPrevious;
+};
+
 KeyChainSchema::KeyChainSchema()
   : m_keyChain(make_shared<KeyChain>())
   , m_schemaInterpreter(make_shared<SchemaInterpreter>())
@@ -106,6 +155,11 @@ KeyChainSchema::sign(T& packet)
   shared_ptr<IdentityCertificate> certificate;
   bool isKsk = true;
 
+  // let the TPM generate the keys of the chain in the background
+  size_t nKeys = m_keyChainNameList.size() - 1;
+  KeyPairReservation reservation(*m_keyChain, makeKeyParams(signPolicy, sigReq.getKeySize()),
+                                 nKeys);
+
   for (++ rit; rit != m_keyChainNameList.rend(); ++rit)
     {
       certNamePattern = *rit;
@@ -122,6 +176,10 @@ KeyChainSchema::sign(T& packet)
       	  keyName = m_keyChain->generateEcdsaKeyPairAsDefault(identityName, isKsk,
       	  	sigReq.getKeySize());
         }
+      else if (signPolicy.find(tlv::SignatureEd25519) != signPolicy.end())
+        {
+          keyName = m_keyChain->generateEd25519KeyPairAsDefault(identityName, isKsk);
+        }
       else if (signPolicy.find(tlv::DigestSha256) != signPolicy.end())
         {
           throw Error("Current schema does not support pure sha-256 signature type.");
@@ -132,6 +190,7 @@ KeyChainSchema::sign(T& packet)
           throw Error("Current schema does not support the signature type you provide.");
           return;
         }
+      reservation.setRemaining(--nKeys);
       certificate =
         m_keyChain->prepareUnsignedIdentityCertificate(keyName, 
                                                     signerIdentityName,
@@ -151,6 +210,18 @@ KeyChainSchema::sign(ndn::Data& packet);
 template void
 KeyChainSchema::sign(ndn::Interest& packet);
 
+shared_ptr<KeyParams>
+KeyChainSchema::makeKeyParams(const std::unordered_set<uint32_t>& signPolicy, uint32_t keySize)
+{
+  if (signPolicy.find(tlv::SignatureSha256WithRsa) != signPolicy.end())
+    return make_shared<RsaKeyParams>(keySize);
+  else if (signPolicy.find(tlv::SignatureSha256WithEcdsa) != signPolicy.end())
+    return make_shared<EcdsaKeyParams>(keySize);
+  else if (signPolicy.find(tlv::SignatureEd25519) != signPolicy.end())
+    return make_shared<Ed25519KeyParams>();
+  return nullptr;
+}
+
 bool
 KeyChainSchema::deriveKeyChainNameList(const Name& packetName)
 {
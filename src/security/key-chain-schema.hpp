@@ -94,6 +94,12 @@ private:
   const std::string
   generateRandStr();
 
+  /** @return{ parameters of the keys generated for the signing policy, or nullptr if the
+   *           policy does not use asymmetric keys }
+   */
+  static shared_ptr<KeyParams>
+  makeKeyParams(const std::unordered_set<uint32_t>& signPolicy, uint32_t keySize);
+
 private:
   shared_ptr<KeyChain> m_keyChain;
   shared_ptr<SchemaInterpreter> m_schemaInterpreter;
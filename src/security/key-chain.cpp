@@ -23,6 +23,7 @@
 
 #include "key-chain.hpp"
 
+#include "../encoding/block-helpers.hpp"
 #include "../util/random.hpp"
 #include "../util/config-file.hpp"
 
@@ -34,6 +35,12 @@
 
 #include "sec-tpm-file.hpp"
 
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+#include <boost/asio/io_service.hpp>
+
 namespace ndn {
 
 // Use a GUID as a magic number of KeyChain::DEFAULT_PREFIX identifier
@@ -43,6 +50,34 @@ const RsaKeyParams KeyChain::DEFAULT_KEY_PARAMS;
 
 const std::string DEFAULT_PIB_SCHEME = "pib-sqlite3";
 
+/** @return{ expected size of SignatureValue block of a signature type, with the default
+ *           key size of the type }
+ *
+ *  Space of this size is reserved after the unsigned portion of Data for its SignatureValue.
+ *  Larger values still fit, at the cost of a reallocation.
+ */
+static size_t
+estimateSignatureValueSize(uint32_t signatureType)
+{
+  switch (signatureType) {
+  case tlv::DigestSha256:
+  case tlv::SignatureHmacWithSha256:
+    return 2 + 32;
+  case tlv::SignatureEd25519:
+    return 2 + 64;
+  case tlv::SignatureSha256WithEcdsa:
+    // DER-encoded signature with 256-bit key
+    return 2 + 72;
+  default:
+    // 2048-bit RSA
+    return 4 + 256;
+  }
+}
+
+/** @brief maximum number of cached signing contexts, after which the cache is emptied
+ */
+const size_t MAX_SIGNING_CONTEXTS = 256;
+
 #if defined(NDN_CXX_HAVE_OSX_SECURITY) and defined(NDN_CXX_WITH_OSX_KEYCHAIN)
 const std::string DEFAULT_TPM_SCHEME = "tpm-osxkeychain";
 #else
@@ -115,6 +150,7 @@ KeyChain::KeyChain()
   : m_pib(nullptr)
   , m_tpm(nullptr)
   , m_lastTimestamp(time::toUnixTimestamp(time::system_clock::now()))
+  , m_defaultSigningContext(nullptr)
 {
   ConfigFile config;
   const ConfigFile::Parsed& parsed = config.getParsedConfiguration();
@@ -131,6 +167,7 @@ KeyChain::KeyChain(const std::string& pibName,
   : m_pib(nullptr)
   , m_tpm(nullptr)
   , m_lastTimestamp(time::toUnixTimestamp(time::system_clock::now()))
+  , m_defaultSigningContext(nullptr)
 {
   initialize(pibName, tpmName, allowReset);
 }
@@ -188,7 +225,8 @@ KeyChain::initialize(const std::string& pibLocatorUri,
   // Create PIB
   m_pib = pibFactory->second.create(pibLocation);
 
-  std::string actualTpmLocator = tpmScheme + ":" + tpmLocation;
+  // parameters after '?' only tune the TPM and do not change which keys it holds
+  std::string actualTpmLocator = tpmScheme + ":" + tpmLocation.substr(0, tpmLocation.find('?'));
 
   // Create TPM, checking that it matches to the previously associated one
   try {
@@ -213,6 +251,8 @@ KeyChain::initialize(const std::string& pibLocatorUri,
 Name
 KeyChain::createIdentity(const Name& identityName, const KeyParams& params)
 {
+  invalidateSigningContexts();
+
   m_pib->addIdentity(identityName);
 
   Name keyName;
@@ -263,6 +303,13 @@ KeyChain::generateEcdsaKeyPair(const Name& identityName, bool isKsk, uint32_t ke
   return generateKeyPair(identityName, isKsk, params);
 }
 
+Name
+KeyChain::generateEd25519KeyPair(const Name& identityName, bool isKsk)
+{
+  Ed25519KeyParams params;
+  return generateKeyPair(identityName, isKsk, params);
+}
+
 Name
 KeyChain::generateRsaKeyPairAsDefault(const Name& identityName, bool isKsk, uint32_t keySize)
 {
@@ -270,11 +317,50 @@ KeyChain::generateRsaKeyPairAsDefault(const Name& identityName, bool isKsk, uint
 
   Name keyName = generateKeyPair(identityName, isKsk, params);
 
+  invalidateSigningContexts();
   m_pib->setDefaultKeyNameForIdentity(keyName);
 
   return keyName;
 }
 
+void
+KeyChain::generateKeyPairAsDefaultAsync(const Name& identityName, bool isKsk,
+                                        const KeyParams& params,
+                                        boost::asio::io_service& ioService,
+                                        const KeyPairGeneratedCallback& onGenerated,
+                                        const SecTpm::KeyPairGenerationFailedCallback& onFailed)
+{
+  Name keyName;
+  try
+    {
+      keyName = m_pib->getNewKeyName(identityName, isKsk);
+    }
+  catch (const SecPublicInfo::Error& e)
+    {
+      ioService.post(bind(onFailed, std::string(e.what())));
+      return;
+    }
+
+  m_tpm->generateKeyPairInTpmAsync(keyName, params, ioService,
+    [this, keyName, onGenerated, onFailed] {
+      try
+        {
+          shared_ptr<PublicKey> pubKey = m_tpm->getPublicKeyFromTpm(keyName);
+          m_pib->addKey(keyName, *pubKey);
+
+          invalidateSigningContexts();
+          m_pib->setDefaultKeyNameForIdentity(keyName);
+        }
+      catch (const std::exception& e)
+        {
+          onFailed(e.what());
+          return;
+        }
+      onGenerated(keyName);
+    },
+    onFailed);
+}
+
 Name
 KeyChain::generateEcdsaKeyPairAsDefault(const Name& identityName, bool isKsk, uint32_t keySize)
 {
@@ -282,6 +368,20 @@ KeyChain::generateEcdsaKeyPairAsDefault(const Name& identityName, bool isKsk, ui
 
   Name keyName = generateKeyPair(identityName, isKsk, params);
 
+  invalidateSigningContexts();
+  m_pib->setDefaultKeyNameForIdentity(keyName);
+
+  return keyName;
+}
+
+Name
+KeyChain::generateEd25519KeyPairAsDefault(const Name& identityName, bool isKsk)
+{
+  Ed25519KeyParams params;
+
+  Name keyName = generateKeyPair(identityName, isKsk, params);
+
+  invalidateSigningContexts();
   m_pib->setDefaultKeyNameForIdentity(keyName);
 
   return keyName;
@@ -385,25 +485,82 @@ KeyChain::prepareUnsignedIdentityCertificate(const Name& keyName,
   return certificate;
 }
 
-Signature
-KeyChain::sign(const uint8_t* buffer, size_t bufferLength, const Name& certificateName)
-{
-  shared_ptr<IdentityCertificate> certificate = m_pib->getCertificate(certificateName);
+std::vector<shared_ptr<IdentityCertificate>>
+KeyChain::issueCertificates(const std::vector<shared_ptr<IdentityCertificate>>& requests,
+                            const Name& signingIdentity,
+                            const time::system_clock::TimePoint& notBefore,
+                            const time::system_clock::TimePoint& notAfter,
+                            const std::vector<CertificateSubjectDescription>& subjectDescription,
+                            const Name& certPrefix,
+                            size_t nThreads)
+{
+  std::vector<shared_ptr<IdentityCertificate>> certificates(requests.size());
+  if (requests.empty())
+    return certificates;
+
+  const SigningContext& context =
+    getSigningContext(m_pib->getDefaultCertificateNameForIdentity(signingIdentity));
+
+  if (!m_tpm->isConcurrentSigningSupported())
+    nThreads = 1;
+  else if (nThreads == 0)
+    nThreads = std::max(std::thread::hardware_concurrency(), 1U);
+  nThreads = std::min(nThreads, requests.size());
+
+  // Workers claim requests one at a time; only the TPM is shared between them.
+  // The first error stops all workers and is rethrown to the caller.
+  std::atomic<size_t> nextRequest(0);
+  std::mutex errorMutex;
+  std::exception_ptr error;
+
+  auto issue = [&] (const Signature& signature) {
+    try {
+      for (size_t i = nextRequest++; i < requests.size(); i = nextRequest++) {
+        const IdentityCertificate& request = *requests[i];
+        shared_ptr<IdentityCertificate> certificate =
+          prepareUnsignedIdentityCertificate(request.getPublicKeyName(),
+                                             request.getPublicKeyInfo(),
+                                             signingIdentity, notBefore, notAfter,
+                                             subjectDescription, certPrefix);
+        if (certificate != nullptr)
+          signPacketWrapper(*certificate, signature, context.keyName, DIGEST_ALGORITHM_SHA256,
+                            context.signatureValueSize);
+        certificates[i] = certificate;
+      }
+    }
+    catch (...) {
+      nextRequest = requests.size();
+      std::lock_guard<std::mutex> lock(errorMutex);
+      if (error == nullptr)
+        error = std::current_exception();
+    }
+  };
 
-  KeyLocator keyLocator(certificate->getName().getPrefix(-1));
-  shared_ptr<Signature> sig =
-    determineSignatureWithPublicKey(keyLocator, certificate->getPublicKeyInfo().getKeyType());
+  // each worker gets its own copy of the signature template
+  std::vector<Signature> signatures(nThreads, *context.signature);
+  std::vector<std::thread> workers;
+  for (size_t i = 1; i < nThreads; ++i)
+    workers.emplace_back(issue, std::cref(signatures[i]));
+  issue(signatures[0]);
+  for (std::thread& worker : workers)
+    worker.join();
 
-  if (!static_cast<bool>(sig))
-    throw SecTpm::Error("unknown key type");
+  if (error != nullptr)
+    std::rethrow_exception(error);
 
+  return certificates;
+}
 
+Signature
+KeyChain::sign(const uint8_t* buffer, size_t bufferLength, const Name& certificateName)
+{
+  const SigningContext& context = getSigningContext(certificateName);
+
+  Signature sig = *context.signature;
   // For temporary usage, we support SHA256 only, but will support more.
-  sig->setValue(m_tpm->signInTpm(buffer, bufferLength,
-                                 certificate->getPublicKeyName(),
-                                 DIGEST_ALGORITHM_SHA256));
+  sig.setValue(m_tpm->signInTpm(buffer, bufferLength, context.keyName, DIGEST_ALGORITHM_SHA256));
 
-  return *sig;
+  return sig;
 }
 
 shared_ptr<IdentityCertificate>
@@ -451,7 +608,8 @@ KeyChain::selfSign(IdentityCertificate& cert)
   if (!static_cast<bool>(sig))
     throw SecTpm::Error("unknown key type");
 
-  signPacketWrapper(cert, *sig, keyName, DIGEST_ALGORITHM_SHA256);
+  signPacketWrapper(cert, *sig, keyName, DIGEST_ALGORITHM_SHA256,
+                    estimateSignatureValueSize(sig->getType()));
 }
 
 shared_ptr<SecuredBag>
@@ -480,6 +638,7 @@ KeyChain::exportIdentity(const Name& identity, const std::string& passwordStr)
   catch (SecPublicInfo::Error& e)
     {
       cert = selfSign(keyName);
+      invalidateSigningContexts();
       m_pib->addCertificateAsIdentityDefault(*cert);
     }
 
@@ -496,6 +655,8 @@ KeyChain::importIdentity(const SecuredBag& securedBag, const std::string& passwo
   Name keyName = IdentityCertificate::certificateNameToPublicKeyName(certificateName);
   Name identity = keyName.getPrefix(-1);
 
+  invalidateSigningContexts();
+
   // Add identity
   m_pib->addIdentity(identity);
 
@@ -536,14 +697,78 @@ KeyChain::determineSignatureWithPublicKey(const KeyLocator& keyLocator,
 
         return make_shared<SignatureSha256WithEcdsa>(keyLocator);
       }
+    case KEY_TYPE_ED25519:
+      {
+        // Ed25519 has its own built-in hash function
+        return make_shared<SignatureEd25519>(keyLocator);
+      }
     default:
       return shared_ptr<Signature>();
     }
 }
 
+const KeyChain::SigningContext&
+KeyChain::getSigningContext(const Name& certificateName)
+{
+  SigningContextMap::const_iterator it = m_signingContexts.find(certificateName);
+  if (it != m_signingContexts.end())
+    return it->second;
+
+  return addSigningContext(m_pib->getCertificate(certificateName));
+}
+
+const KeyChain::SigningContext&
+KeyChain::getDefaultSigningContext()
+{
+  if (m_defaultSigningContext != nullptr)
+    return *m_defaultSigningContext;
+
+  if (!static_cast<bool>(m_pib->getDefaultCertificate()))
+    setDefaultCertificateInternal();
+
+  shared_ptr<IdentityCertificate> certificate = m_pib->getDefaultCertificate();
+  SigningContextMap::const_iterator it = m_signingContexts.find(certificate->getName());
+  if (it != m_signingContexts.end())
+    m_defaultSigningContext = &it->second;
+  else
+    m_defaultSigningContext = &addSigningContext(certificate);
+
+  return *m_defaultSigningContext;
+}
+
+const KeyChain::SigningContext&
+KeyChain::addSigningContext(const shared_ptr<IdentityCertificate>& certificate)
+{
+  SigningContext context;
+  context.certificate = certificate;
+  context.keyType = certificate->getPublicKeyInfo().getKeyType();
+  context.keyName = certificate->getPublicKeyName();
+  KeyLocator keyLocator(certificate->getName().getPrefix(-1));
+  context.signature = determineSignatureWithPublicKey(keyLocator, context.keyType);
+  if (!static_cast<bool>(context.signature))
+    throw SecPublicInfo::Error("unknown key type!");
+
+  // encode SignatureInfo once, so that its wire is shared by all signed packets
+  context.signature->getInfo();
+  context.signatureValueSize = estimateSignatureValueSize(context.signature->getType());
+
+  if (m_signingContexts.size() >= MAX_SIGNING_CONTEXTS)
+    invalidateSigningContexts();
+
+  return m_signingContexts.insert(std::make_pair(certificate->getName(), context)).first->second;
+}
+
+void
+KeyChain::invalidateSigningContexts()
+{
+  m_signingContexts.clear();
+  m_defaultSigningContext = nullptr;
+}
+
 void
 KeyChain::setDefaultCertificateInternal()
 {
+  invalidateSigningContexts();
   m_pib->refreshDefaultCertificate();
 
   if (!static_cast<bool>(m_pib->getDefaultCertificate()))
@@ -579,17 +804,42 @@ KeyChain::generateKeyPair(const Name& identityName, bool isKsk, const KeyParams&
 }
 
 void
+KeyChain::signPacketWrapper(Data& data, const SigningContext& context)
+{
+  size_t signatureValueSize = signPacketWrapper(data, *context.signature, context.keyName,
+                                                DIGEST_ALGORITHM_SHA256,
+                                                context.signatureValueSize);
+  context.signatureValueSize = std::max(context.signatureValueSize, signatureValueSize);
+}
+
+void
+KeyChain::signPacketWrapper(Interest& interest, const SigningContext& context)
+{
+  signPacketWrapper(interest, *context.signature, context.keyName, DIGEST_ALGORITHM_SHA256);
+}
+
+size_t
 KeyChain::signPacketWrapper(Data& data, const Signature& signature,
-                            const Name& keyName, DigestAlgorithm digestAlgorithm)
+                            const Name& keyName, DigestAlgorithm digestAlgorithm,
+                            size_t signatureValueReserve)
 {
   data.setSignature(signature);
 
-  EncodingBuffer encoder;
+  EncodingEstimator estimator;
+  size_t unsignedPortionSize = data.wireEncode(estimator, true);
+  size_t headerSize = tlv::sizeOfVarNumber(tlv::Data) +
+                      tlv::sizeOfVarNumber(unsignedPortionSize + signatureValueReserve);
+
+  // leave room for the outer Data TLV header in front and for SignatureValue at the back,
+  // so that the whole packet is encoded in a single allocation
+  EncodingBuffer encoder(headerSize + unsignedPortionSize + signatureValueReserve,
+                         signatureValueReserve);
   data.wireEncode(encoder, true);
 
-  Block signatureValue = m_tpm->signInTpm(encoder.buf(), encoder.size(),
-                                          keyName, digestAlgorithm);
+  Block signatureValue = signBuffer(encoder.buf(), encoder.size(),
+                                    signature, keyName, digestAlgorithm);
   data.wireEncode(encoder, signatureValue);
+  return signatureValue.size();
 }
 
 void
@@ -608,15 +858,24 @@ KeyChain::signPacketWrapper(Interest& interest, const Signature& signature,
     .append(name::Component::fromNumber(random::generateWord64())) // nonce
     .append(signature.getInfo());                                  // signatureInfo
 
-  Block sigValue = m_tpm->signInTpm(signedName.wireEncode().value(),
-                                    signedName.wireEncode().value_size(),
-                                    keyName,
-                                    digestAlgorithm);
+  Block sigValue = signBuffer(signedName.wireEncode().value(),
+                              signedName.wireEncode().value_size(),
+                              signature, keyName, digestAlgorithm);
   sigValue.encode();
   signedName.append(sigValue);                                     // signatureValue
   interest.setName(signedName);
 }
 
+Block
+KeyChain::signBuffer(const uint8_t* buf, size_t size, const Signature& signature,
+                     const Name& keyName, DigestAlgorithm digestAlgorithm)
+{
+  if (signature.getType() == tlv::SignatureHmacWithSha256)
+    return m_tpm->signWithHmacInTpm(buf, size, keyName, digestAlgorithm);
+  else
+    return m_tpm->signInTpm(buf, size, keyName, digestAlgorithm);
+}
+
 Signature
 KeyChain::signByIdentity(const uint8_t* buffer, size_t bufferLength, const Name& identityName)
 {
@@ -643,11 +902,11 @@ KeyChain::signWithSha256(Data& data)
   DigestSha256 sig;
   data.setSignature(sig);
 
-  Block sigValue(tlv::SignatureValue,
-                 crypto::sha256(data.wireEncode().value(),
-                                data.wireEncode().value_size() -
-                                data.getSignature().getValue().size()));
-  data.setSignatureValue(sigValue);
+  uint8_t digest[crypto::SHA256_DIGEST_SIZE];
+  crypto::sha256(data.wireEncode().value(),
+                 data.wireEncode().value_size() - data.getSignature().getValue().size(),
+                 digest);
+  data.setSignatureValue(dataBlock(tlv::SignatureValue, digest, sizeof(digest)));
 }
 
 void
@@ -665,24 +924,40 @@ KeyChain::signWithSha256(Interest& interest)
     .append(name::Component::fromNumber(random::generateWord64())) // nonce
     .append(sig.getInfo());                                        // signatureInfo
 
-  Block sigValue(tlv::SignatureValue,
-                 crypto::sha256(signedName.wireEncode().value(),
-                                signedName.wireEncode().value_size()));
+  uint8_t digest[crypto::SHA256_DIGEST_SIZE];
+  crypto::sha256(signedName.wireEncode().value(), signedName.wireEncode().value_size(), digest);
 
-  sigValue.encode();
+  Block sigValue = dataBlock(tlv::SignatureValue, digest, sizeof(digest));
   signedName.append(sigValue);                                     // signatureValue
   interest.setName(signedName);
 }
 
+void
+KeyChain::signWithHmac(Data& data, const Name& keyName)
+{
+  SignatureHmacWithSha256 sig((KeyLocator(keyName)));
+  signPacketWrapper(data, sig, keyName, DIGEST_ALGORITHM_SHA256,
+                    estimateSignatureValueSize(tlv::SignatureHmacWithSha256));
+}
+
+void
+KeyChain::signWithHmac(Interest& interest, const Name& keyName)
+{
+  SignatureHmacWithSha256 sig((KeyLocator(keyName)));
+  signPacketWrapper(interest, sig, keyName, DIGEST_ALGORITHM_SHA256);
+}
+
 void
 KeyChain::deleteCertificate(const Name& certificateName)
 {
+  invalidateSigningContexts();
   m_pib->deleteCertificateInfo(certificateName);
 }
 
 void
 KeyChain::deleteKey(const Name& keyName)
 {
+  invalidateSigningContexts();
   m_pib->deletePublicKeyInfo(keyName);
   m_tpm->deleteKeyPairInTpm(keyName);
 }
@@ -690,6 +965,8 @@ KeyChain::deleteKey(const Name& keyName)
 void
 KeyChain::deleteIdentity(const Name& identity)
 {
+  invalidateSigningContexts();
+
   std::vector<Name> keyNames;
   m_pib->getAllKeyNamesOfIdentity(identity, keyNames, true);
   m_pib->getAllKeyNamesOfIdentity(identity, keyNames, false);
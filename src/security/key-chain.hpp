@@ -30,12 +30,15 @@
 #include "secured-bag.hpp"
 #include "signature-sha256-with-rsa.hpp"
 #include "signature-sha256-with-ecdsa.hpp"
+#include "signature-ed25519.hpp"
+#include "signature-hmac-with-sha256.hpp"
 #include "digest-sha256.hpp"
 
 #include "../interest.hpp"
 #include "../util/crypto.hpp"
 #include "../util/random.hpp"
 #include <initializer_list>
+#include <unordered_map>
 
 
 namespace ndn {
@@ -139,6 +142,19 @@ public:
 
   Name
   generateEcdsaKeyPair(const Name& identityName, bool isKsk = false, uint32_t keySize = 256);
+
+  /**
+   * @brief Generate an Ed25519 key pair for the specified identity.
+   *
+   * Ed25519 keys require the OpenSSL crypto backend.
+   *
+   * @param identityName The name of the identity.
+   * @param isKsk true for generating a Key-Signing-Key (KSK), false for a Data-Signing-Key (KSK).
+   * @return The generated key name.
+   */
+  Name
+  generateEd25519KeyPair(const Name& identityName, bool isKsk = false);
+
   /**
    * @brief Generate a pair of RSA keys for the specified identity and set it as default key for
    *        the identity.
@@ -155,6 +171,30 @@ public:
   Name
   generateEcdsaKeyPairAsDefault(const Name& identityName, bool isKsk, uint32_t keySize = 256);
 
+  Name
+  generateEd25519KeyPairAsDefault(const Name& identityName, bool isKsk = false);
+
+  typedef function<void(const Name& keyName)> KeyPairGeneratedCallback;
+
+  /**
+   * @brief Generate a key pair for the specified identity without waiting for the key
+   *        generation, and set it as default key for the identity
+   *
+   * The TPM generates the key pair in the background if it supports that
+   * (see SecTpm::generateKeyPairInTpmAsync).  The key is then added to the PIB from
+   * @p ioService, which also invokes @p onGenerated with the key name, or @p onFailed if
+   * the key cannot be generated.  KeyChain must outlive the key generation.
+   *
+   * @param identityName The name of the identity.
+   * @param isKsk true for generating a Key-Signing-Key (KSK), false for a Data-Signing-Key (KSK).
+   * @param params The parameter of the key.
+   */
+  void
+  generateKeyPairAsDefaultAsync(const Name& identityName, bool isKsk, const KeyParams& params,
+                                boost::asio::io_service& ioService,
+                                const KeyPairGeneratedCallback& onGenerated,
+                                const SecTpm::KeyPairGenerationFailedCallback& onFailed);
+
   /**
    * @brief prepare an unsigned identity certificate
    *
@@ -203,6 +243,36 @@ public:
     const std::vector<CertificateSubjectDescription>& subjectDescription,
     const Name& certPrefix = DEFAULT_PREFIX);
 
+  /**
+   * @brief Issue identity certificates for a batch of signing requests
+   *
+   * For every request, an identity certificate of the requested public key is prepared as
+   * in prepareUnsignedIdentityCertificate() and signed with the default certificate of
+   * @p signingIdentity.  If the TPM supports concurrent signing, requests are spread over
+   * @p nThreads threads.  The issued certificates are not added to the PIB, use
+   * addCertificates() for that.
+   *
+   * @param requests Signing requests, i.e., self-signed certificates of the keys to certify.
+   * @param signingIdentity The signing identity.
+   * @param notBefore Refer to IdentityCertificate.
+   * @param notAfter Refer to IdentityCertificate.
+   * @param subjectDescription Refer to IdentityCertificate.
+   * @param certPrefix Refer to prepareUnsignedIdentityCertificate().
+   * @param nThreads Maximum number of signing threads, 0 to use all hardware threads.
+   * @return Issued certificates, in the same order as @p requests.  The entry of a request
+   *         whose key name is not formatted correctly is a null pointer.
+   * @throws SecPublicInfo::Error if @p signingIdentity has no default certificate.
+   * @throws SecTpm::Error if signing fails.
+   */
+  std::vector<shared_ptr<IdentityCertificate>>
+  issueCertificates(const std::vector<shared_ptr<IdentityCertificate>>& requests,
+                    const Name& signingIdentity,
+                    const time::system_clock::TimePoint& notBefore,
+                    const time::system_clock::TimePoint& notAfter,
+                    const std::vector<CertificateSubjectDescription>& subjectDescription,
+                    const Name& certPrefix = DEFAULT_PREFIX,
+                    size_t nThreads = 0);
+
   /**
    * @brief Sign packet with default identity
    *
@@ -275,6 +345,26 @@ public:
   void
   signWithSha256(Interest& interest);
 
+  /**
+   * @brief Set HMAC-SHA256 signature for @p data
+   *
+   * @param data The packet to be signed.
+   * @param keyName The name of the symmetric key in the TPM, which is put in the KeyLocator.
+   * @throws SecTpm::Error if the key does not exist or signing fails.
+   */
+  void
+  signWithHmac(Data& data, const Name& keyName);
+
+  /**
+   * @brief Set HMAC-SHA256 signature for @p interest
+   *
+   * @param interest The packet to be signed.
+   * @param keyName The name of the symmetric key in the TPM, which is put in the KeyLocator.
+   * @throws SecTpm::Error if the key does not exist or signing fails.
+   */
+  void
+  signWithHmac(Interest& interest, const Name& keyName);
+
   /**
    * @brief Generate a self-signed certificate for a public key.
    *
@@ -340,9 +430,16 @@ public:
   void
   importIdentity(const SecuredBag& securedBag, const std::string& passwordStr);
 
+  /**
+   * @brief Get the PIB for direct access
+   *
+   * Because the PIB may be modified through the returned reference, cached signing contexts
+   * are discarded.
+   */
   SecPublicInfo&
   getPib()
   {
+    invalidateSigningContexts();
     return *m_pib;
   }
 
@@ -376,6 +473,7 @@ public:
   void
   addIdentity(const Name& identityName)
   {
+    invalidateSigningContexts();
     return m_pib->addIdentity(identityName);
   }
 
@@ -388,12 +486,14 @@ public:
   void
   addPublicKey(const Name& keyName, KeyType keyType, const PublicKey& publicKeyDer)
   {
+    invalidateSigningContexts();
     return m_pib->addKey(keyName, publicKeyDer);
   }
 
   void
   addKey(const Name& keyName, const PublicKey& publicKeyDer)
   {
+    invalidateSigningContexts();
     return m_pib->addKey(keyName, publicKeyDer);
   }
 
@@ -412,9 +512,17 @@ public:
   void
   addCertificate(const IdentityCertificate& certificate)
   {
+    invalidateSigningContexts();
     return m_pib->addCertificate(certificate);
   }
 
+  void
+  addCertificates(const std::vector<shared_ptr<IdentityCertificate>>& certificates)
+  {
+    invalidateSigningContexts();
+    return m_pib->addCertificates(certificates);
+  }
+
   shared_ptr<IdentityCertificate>
   getCertificate(const Name& certificateName) const
   {
@@ -474,36 +582,42 @@ public:
   void
   deleteCertificateInfo(const Name& certificateName)
   {
+    invalidateSigningContexts();
     return m_pib->deleteCertificateInfo(certificateName);
   }
 
   void
   deletePublicKeyInfo(const Name& keyName)
   {
+    invalidateSigningContexts();
     return m_pib->deletePublicKeyInfo(keyName);
   }
 
   void
   deleteIdentityInfo(const Name& identity)
   {
+    invalidateSigningContexts();
     return m_pib->deleteIdentityInfo(identity);
   }
 
   void
   setDefaultIdentity(const Name& identityName)
   {
+    invalidateSigningContexts();
     return m_pib->setDefaultIdentity(identityName);
   }
 
   void
   setDefaultKeyNameForIdentity(const Name& keyName)
   {
+    invalidateSigningContexts();
     return m_pib->setDefaultKeyNameForIdentity(keyName);
   }
 
   void
   setDefaultCertificateNameForKey(const Name& certificateName)
   {
+    invalidateSigningContexts();
     return m_pib->setDefaultCertificateNameForKey(certificateName);
   }
 
@@ -528,18 +642,21 @@ public:
   void
   addCertificateAsKeyDefault(const IdentityCertificate& certificate)
   {
+    invalidateSigningContexts();
     return m_pib->addCertificateAsKeyDefault(certificate);
   }
 
   void
   addCertificateAsIdentityDefault(const IdentityCertificate& certificate)
   {
+    invalidateSigningContexts();
     return m_pib->addCertificateAsIdentityDefault(certificate);
   }
 
   void
   addCertificateAsSystemDefault(const IdentityCertificate& certificate)
   {
+    invalidateSigningContexts();
     return m_pib->addCertificateAsSystemDefault(certificate);
   }
 
@@ -555,6 +672,7 @@ public:
   void
   refreshDefaultCertificate()
   {
+    invalidateSigningContexts();
     return m_pib->refreshDefaultCertificate();
   }
 
@@ -604,6 +722,18 @@ public:
     return m_tpm->generateKeyPairInTpm(keyName, params);
   }
 
+  void
+  reserveKeyPairs(const KeyParams& params, size_t nKeyPairs)
+  {
+    return m_tpm->reserveKeyPairs(params, nKeyPairs);
+  }
+
+  size_t
+  getKeyPairReserve(const KeyParams& params) const
+  {
+    return m_tpm->getKeyPairReserve(params);
+  }
+
   void
   deleteKeyPairInTpm(const Name& keyName)
   {
@@ -642,6 +772,26 @@ public:
     return m_tpm->generateSymmetricKeyInTpm(keyName, params);
   }
 
+  Block
+  signWithHmacInTpm(const uint8_t* data, size_t dataLength,
+                    const Name& keyName,
+                    DigestAlgorithm digestAlgorithm)
+  {
+    return m_tpm->signWithHmacInTpm(data, dataLength, keyName, digestAlgorithm);
+  }
+
+  ConstBufferPtr
+  exportSymmetricKeyFromTpm(const Name& keyName)
+  {
+    return m_tpm->exportSymmetricKeyFromTpm(keyName);
+  }
+
+  bool
+  importSymmetricKeyIntoTpm(const Name& keyName, const uint8_t* buf, size_t size)
+  {
+    return m_tpm->importSymmetricKeyIntoTpm(keyName, buf, size);
+  }
+
   bool
   doesKeyExistInTpm(const Name& keyName, KeyClass keyClass) const
   {
@@ -697,14 +847,49 @@ private:
   setDefaultCertificateInternal();
 
   /**
-   * @brief Sign a packet using a pariticular certificate.
+   * @brief State derived from a signing certificate, reused by every signing operation
+   *        with the same certificate
+   */
+  struct SigningContext
+  {
+    shared_ptr<IdentityCertificate> certificate;
+    KeyType keyType;
+    /// name of the private key in the TPM
+    Name keyName;
+    /// signature with prebuilt SignatureInfo, to be completed with the SignatureValue
+    shared_ptr<Signature> signature;
+    /// size of the largest SignatureValue block made with the key so far, reserved
+    /// when encoding the next signed Data
+    mutable size_t signatureValueSize;
+  };
+
+  /**
+   * @brief Get the signing context of a certificate, looking it up in the PIB on first use
    *
-   * @param packet The packet to be signed.
-   * @param certificate The signing certificate.
+   * @throws SecPublicInfo::Error if certificate does not exist or its key type is unknown
+   */
+  const SigningContext&
+  getSigningContext(const Name& certificateName);
+
+  /**
+   * @brief Get the signing context of the default certificate
+   *
+   * If default identity does not exist, a temporary identity will be created and set as default.
+   */
+  const SigningContext&
+  getDefaultSigningContext();
+
+  const SigningContext&
+  addSigningContext(const shared_ptr<IdentityCertificate>& certificate);
+
+  /**
+   * @brief Discard all signing contexts
+   *
+   * Must be called whenever the PIB is modified.  Changes made to the PIB outside of this
+   * KeyChain instance (e.g., by another process) are not detected.
    */
-  template<typename T>
   void
-  sign(T& packet, const IdentityCertificate& certificate);
+  invalidateSigningContexts();
 
   /**
    * @brief Generate a key pair for the specified identity.
@@ -718,6 +903,20 @@ private:
   generateKeyPair(const Name& identityName, bool isKsk = false,
                   const KeyParams& params = DEFAULT_KEY_PARAMS);
 
+  /**
+   * @brief Sign the data with the key of a signing context
+   * @throws Tpm::Error
+   */
+  void
+  signPacketWrapper(Data& data, const SigningContext& context);
+
+  /**
+   * @brief Sign the interest with the key of a signing context
+   * @throws Tpm::Error
+   */
+  void
+  signPacketWrapper(Interest& interest, const SigningContext& context);
+
   /**
    * @brief Sign the data using a particular key.
    *
@@ -725,11 +924,14 @@ private:
    * @param signature Signature to be added.
    * @param keyName The name of the signing key.
    * @param digestAlgorithm the digest algorithm.
+   * @param signatureValueReserve space reserved in the encoding buffer for SignatureValue.
+   * @return size of the SignatureValue block.
    * @throws Tpm::Error
    */
-  void
+  size_t
   signPacketWrapper(Data& data, const Signature& signature,
-                    const Name& keyName, DigestAlgorithm digestAlgorithm);
+                    const Name& keyName, DigestAlgorithm digestAlgorithm,
+                    size_t signatureValueReserve);
 
   /**
    * @brief Sign the interest using a particular key.
@@ -744,6 +946,16 @@ private:
   signPacketWrapper(Interest& interest, const Signature& signature,
                     const Name& keyName, DigestAlgorithm digestAlgorithm);
 
+  /**
+   * @brief Sign the buffer with the TPM operation matching the type of @p signature
+   *
+   * @return The SignatureValue block.
+   * @throws Tpm::Error
+   */
+  Block
+  signBuffer(const uint8_t* buf, size_t size, const Signature& signature,
+             const Name& keyName, DigestAlgorithm digestAlgorithm);
+
   static void
   registerPibImpl(const std::string& canonicalName,
                   std::initializer_list<std::string> aliases, PibCreateFunc createFunc);
@@ -761,24 +973,25 @@ private:
   std::unique_ptr<SecPublicInfo> m_pib;
   std::unique_ptr<SecTpm> m_tpm;
   time::milliseconds m_lastTimestamp;
+
+  typedef std::unordered_map<Name, SigningContext> SigningContextMap;
+  SigningContextMap m_signingContexts;
+  /// points into m_signingContexts, or is nullptr if not yet determined
+  const SigningContext* m_defaultSigningContext;
 };
 
 template<typename T>
 void
 KeyChain::sign(T& packet)
 {
-  if (!static_cast<bool>(m_pib->getDefaultCertificate()))
-    setDefaultCertificateInternal();
-
-  sign(packet, *m_pib->getDefaultCertificate());
+  signPacketWrapper(packet, getDefaultSigningContext());
 }
 
 template<typename T>
 void
 KeyChain::sign(T& packet, const Name& certificateName)
 {
-  shared_ptr<IdentityCertificate> certificate = m_pib->getCertificate(certificateName);
-  sign(packet, *certificate);
+  signPacketWrapper(packet, getSigningContext(certificateName));
 }
 
 template<typename T>
@@ -802,25 +1015,6 @@ KeyChain::signByIdentity(T& packet, const Name& identityName)
   sign(packet, signingCertificateName);
 }
 
-template<typename T>
-void
-KeyChain::sign(T& packet, const IdentityCertificate& certificate)
-{
-  KeyLocator keyLocator(certificate.getName().getPrefix(-1));
-
-  shared_ptr<Signature> signature =
-    determineSignatureWithPublicKey(keyLocator, certificate.getPublicKeyInfo().getKeyType());
-
-  if (!static_cast<bool>(signature))
-    throw SecPublicInfo::Error("unknown key type!");
-
-  signPacketWrapper(packet, *signature,
-                    certificate.getPublicKeyName(),
-                    DIGEST_ALGORITHM_SHA256);
-
-  return;
-}
-
 template<class PibType>
 inline void
 KeyChain::registerPib(std::initializer_list<std::string> aliases)
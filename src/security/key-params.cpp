@@ -63,6 +63,19 @@ EcdsaKeyParamsInfo::getDefaultSize()
 }
 
 
+uint32_t
+Ed25519KeyParamsInfo::checkKeySize(uint32_t)
+{
+  return getDefaultSize();
+}
+
+uint32_t
+Ed25519KeyParamsInfo::getDefaultSize()
+{
+  return 256;
+}
+
+
 uint32_t
 AesKeyParamsInfo::checkKeySize(uint32_t size)
 {
@@ -80,4 +93,18 @@ AesKeyParamsInfo::getDefaultSize()
   return AES_KEY_SIZES[0];
 }
 
+uint32_t
+HmacKeyParamsInfo::checkKeySize(uint32_t size)
+{
+  if (size > 0 && size % 8 == 0)
+    return size;
+  return getDefaultSize();
+}
+
+uint32_t
+HmacKeyParamsInfo::getDefaultSize()
+{
+  return 256;
+}
+
 } // namespace ndn
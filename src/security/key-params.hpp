@@ -104,6 +104,25 @@ public:
   getDefaultSize();
 };
 
+/// @brief Ed25519KeyParamsInfo is used to initialize a SimplePublicKeyParams template for
+///        Ed25519 key.
+class Ed25519KeyParamsInfo
+{
+public:
+  static KeyType
+  getType()
+  {
+    return KEY_TYPE_ED25519;
+  }
+
+  /// @brief Ed25519 keys have a fixed size, so the default key size is always returned.
+  static uint32_t
+  checkKeySize(uint32_t size);
+
+  static uint32_t
+  getDefaultSize();
+};
+
 
 /// @brief SimplePublicKeyParams is a template for public keys with only one parameter: size.
 template<typename KeyParamsInfo>
@@ -160,6 +179,9 @@ typedef SimplePublicKeyParams<RsaKeyParamsInfo> RsaKeyParams;
 /// @brief EcdsaKeyParams carries parameters for ECDSA key.
 typedef SimplePublicKeyParams<EcdsaKeyParamsInfo> EcdsaKeyParams;
 
+/// @brief Ed25519KeyParams carries parameters for Ed25519 key.
+typedef SimplePublicKeyParams<Ed25519KeyParamsInfo> Ed25519KeyParams;
+
 
 /// @brief AesKeyParamsInfo is used to initialize a SimpleSymmetricKeyParams template for AES key.
 class AesKeyParamsInfo
@@ -231,6 +253,29 @@ private:
 
 typedef SimpleSymmetricKeyParams<AesKeyParamsInfo> AesKeyParams;
 
+
+/// @brief HmacKeyParamsInfo is used to initialize a SimpleSymmetricKeyParams template for
+///        HMAC key.
+class HmacKeyParamsInfo
+{
+public:
+  static KeyType
+  getType()
+  {
+    return KEY_TYPE_HMAC;
+  }
+
+  /// @brief check if size is a non-zero number of octets, otherwise return the default key size.
+  static uint32_t
+  checkKeySize(uint32_t size);
+
+  static uint32_t
+  getDefaultSize();
+};
+
+/// @brief HmacKeyParams carries parameters for HMAC key.
+typedef SimpleSymmetricKeyParams<HmacKeyParamsInfo> HmacKeyParams;
+
 } // namespace ndn
 
 #endif // NDN_SECURITY_KEY_PARAMS_HPP
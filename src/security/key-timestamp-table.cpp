@@ -0,0 +1,97 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "key-timestamp-table.hpp"
+
+namespace ndn {
+namespace security {
+
+KeyTimestampTable::KeyTimestampTable(size_t maxKeys, const time::system_clock::Duration& ttl)
+  : m_maxKeys(maxKeys)
+  , m_ttl(ttl)
+  , m_nHits(0)
+  , m_nMisses(0)
+  , m_nEvictions(0)
+  , m_nExpirations(0)
+{
+}
+
+bool
+KeyTimestampTable::find(const Name& keyName, time::system_clock::TimePoint& timestamp)
+{
+  EntryTable::index<byKeyName>::type::iterator it = m_entries.get<byKeyName>().find(keyName);
+  if (it == m_entries.get<byKeyName>().end()) {
+    ++m_nMisses;
+    return false;
+  }
+
+  if (time::system_clock::now() - it->lastUpdated > m_ttl) {
+    m_entries.get<byKeyName>().erase(it);
+    ++m_nExpirations;
+    ++m_nMisses;
+    return false;
+  }
+
+  ++m_nHits;
+  timestamp = it->timestamp;
+  return true;
+}
+
+void
+KeyTimestampTable::update(const Name& keyName, const time::system_clock::TimePoint& timestamp)
+{
+  time::system_clock::TimePoint now = time::system_clock::now();
+
+  EntryTable::index<byKeyName>::type::iterator it = m_entries.get<byKeyName>().find(keyName);
+  if (it != m_entries.get<byKeyName>().end()) {
+    it->timestamp = timestamp;
+    it->lastUpdated = now;
+
+    EntryTable::index<byLastUpdated>::type& byUpdate = m_entries.get<byLastUpdated>();
+    byUpdate.relocate(byUpdate.end(), m_entries.project<byLastUpdated>(it));
+    return;
+  }
+
+  this->expire(now);
+
+  if (m_maxKeys == 0)
+    return;
+
+  if (m_entries.size() >= m_maxKeys) {
+    m_entries.get<byLastUpdated>().pop_front();
+    ++m_nEvictions;
+  }
+
+  m_entries.get<byLastUpdated>().push_back(Entry{keyName, timestamp, now});
+}
+
+void
+KeyTimestampTable::expire(const time::system_clock::TimePoint& now)
+{
+  EntryTable::index<byLastUpdated>::type& byUpdate = m_entries.get<byLastUpdated>();
+  while (!byUpdate.empty() && now - byUpdate.front().lastUpdated > m_ttl) {
+    byUpdate.pop_front();
+    ++m_nExpirations;
+  }
+}
+
+} // namespace security
+} // namespace ndn
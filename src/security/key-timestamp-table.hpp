@@ -0,0 +1,152 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_SECURITY_KEY_TIMESTAMP_TABLE_HPP
+#define NDN_SECURITY_KEY_TIMESTAMP_TABLE_HPP
+
+#include "../common.hpp"
+#include "../name.hpp"
+
+#include <boost/multi_index_container.hpp>
+#include <boost/multi_index/hashed_index.hpp>
+#include <boost/multi_index/sequenced_index.hpp>
+#include <boost/multi_index/member.hpp>
+
+namespace ndn {
+namespace security {
+
+/**
+ * @brief Table of the last command Interest timestamp of each signing key
+ *
+ * Keys are kept in a hash table and in a list ordered by the time of their last update, so
+ * that looking up, updating, and forgetting a key take constant time.  A key is forgotten
+ * when it has not been updated for longer than the TTL, or when the table is full and the key
+ * is the least recently updated one.
+ */
+class KeyTimestampTable : noncopyable
+{
+public:
+  /**
+   * @param maxKeys maximum number of tracked keys
+   * @param ttl period after the last update when a key is forgotten
+   */
+  KeyTimestampTable(size_t maxKeys, const time::system_clock::Duration& ttl);
+
+  /**
+   * @brief Look up the last timestamp of a key
+   * @param keyName name of the signing key
+   * @param[out] timestamp last timestamp of the key, if found
+   * @return whether the key is tracked; a key whose TTL has passed is forgotten and not found
+   */
+  bool
+  find(const Name& keyName, time::system_clock::TimePoint& timestamp);
+
+  /**
+   * @brief Record the timestamp of the latest accepted command Interest of a key
+   */
+  void
+  update(const Name& keyName, const time::system_clock::TimePoint& timestamp);
+
+  size_t
+  size() const
+  {
+    return m_entries.size();
+  }
+
+  /**
+   * @return number of lookups that found the key
+   */
+  uint64_t
+  getNHits() const
+  {
+    return m_nHits;
+  }
+
+  /**
+   * @return number of lookups that did not find the key
+   */
+  uint64_t
+  getNMisses() const
+  {
+    return m_nMisses;
+  }
+
+  /**
+   * @return number of keys forgotten because the table was full
+   */
+  uint64_t
+  getNEvictions() const
+  {
+    return m_nEvictions;
+  }
+
+  /**
+   * @return number of keys forgotten because their TTL had passed
+   */
+  uint64_t
+  getNExpirations() const
+  {
+    return m_nExpirations;
+  }
+
+private:
+  void
+  expire(const time::system_clock::TimePoint& now);
+
+private:
+  struct Entry
+  {
+    Name keyName;
+    mutable time::system_clock::TimePoint timestamp;
+    mutable time::system_clock::TimePoint lastUpdated;
+  };
+
+  class byKeyName;
+  class byLastUpdated;
+
+  typedef boost::multi_index_container<
+    Entry,
+    boost::multi_index::indexed_by<
+      boost::multi_index::hashed_unique<
+        boost::multi_index::tag<byKeyName>,
+        boost::multi_index::member<Entry, Name, &Entry::keyName>,
+        std::hash<Name>
+      >,
+      boost::multi_index::sequenced<
+        boost::multi_index::tag<byLastUpdated>
+      >
+    >
+  > EntryTable;
+
+  EntryTable m_entries;
+  size_t m_maxKeys;
+  time::system_clock::Duration m_ttl;
+
+  uint64_t m_nHits;
+  uint64_t m_nMisses;
+  uint64_t m_nEvictions;
+  uint64_t m_nExpirations;
+};
+
+} // namespace security
+} // namespace ndn
+
+#endif // NDN_SECURITY_KEY_TIMESTAMP_TABLE_HPP
@@ -38,8 +38,13 @@
 
 
 #include <openssl/ssl.h>
+#include <openssl/err.h>
+#include <openssl/evp.h>
 #include <openssl/sha.h>
+#include <openssl/hmac.h>
 #include <openssl/rsa.h>
+#include <openssl/ec.h>
+#include <openssl/x509.h>
 
 
 #endif // NDN_SECURITY_OPENSSL_HPP
@@ -24,6 +24,7 @@
 
 #include "public-key.hpp"
 
+#include "../encoding/block-helpers.hpp"
 #include "../encoding/oid.hpp"
 #include "../util/crypto.hpp"
 #include "cryptopp.hpp"
@@ -51,8 +52,9 @@ PublicKey::computeDigest() const
   if (m_digest.hasWire())
     return m_digest;
   else {
-    m_digest = Block(tlv::KeyDigest, crypto::sha256(m_key.buf(), m_key.size()));
-    m_digest.encode();
+    uint8_t digest[crypto::SHA256_DIGEST_SIZE];
+    crypto::sha256(m_key.buf(), m_key.size(), digest);
+    m_digest = dataBlock(tlv::KeyDigest, digest, sizeof(digest));
     return m_digest;
   }
 }
@@ -109,8 +111,10 @@ PublicKey::decode(CryptoPP::BufferedTransformation& in)
             m_type = KEY_TYPE_RSA;
           else if (algorithm == oid::ECDSA)
             m_type = KEY_TYPE_ECDSA;
+          else if (algorithm == oid::ED25519)
+            m_type = KEY_TYPE_ED25519;
           else
-            throw Error("Only RSA/ECDSA public keys are supported for now (" +
+            throw Error("Only RSA/ECDSA/Ed25519 public keys are supported for now (" +
                         algorithm.toString() + " requested)");
         }
       }
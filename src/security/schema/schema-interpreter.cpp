@@ -99,6 +99,9 @@ SchemaInterpreter::load(const SchemaSection& schemaSection,
     else if (boost::iequals(sectionName, "anchor")) {
       onConfigTrustAnchor(section, filename);
     }
+    else if (boost::iequals(sectionName, "shared-key")) {
+      onConfigSharedKey(section, filename);
+    }
     else if (boost::iequals(sectionName, "sig-req")) {
       m_sigReq = make_shared<SignatureRequirement>(section);
     }
@@ -119,6 +122,7 @@ SchemaInterpreter::reset()
   m_dataRules.clear();
   m_staticAnchors.clear();
   m_dynamicAnchors.clear();
+  m_sharedKeys.clear();
   m_checkFlag = true;
 }
 
@@ -225,7 +229,8 @@ bool
 SchemaInterpreter::isEmpty()
 {
   return (m_interestRules.empty() && m_dataRules.empty() &&
-          m_staticAnchors.empty() && m_dynamicAnchors.empty());
+          m_staticAnchors.empty() && m_dynamicAnchors.empty() &&
+          m_sharedKeys.empty());
 }
 
 void
@@ -478,6 +483,62 @@ SchemaInterpreter::onConfigTrustAnchor(const SchemaSection& schemaSection,
     throw Error("Unsupported trust-anchor.type: " + type);
 }
 
+void
+SchemaInterpreter::onConfigSharedKey(const SchemaSection& schemaSection,
+                                     const std::string& filename)
+{
+  using namespace boost::filesystem;
+
+  SchemaSection::const_iterator propertyIt = schemaSection.begin();
+
+  if (propertyIt == schemaSection.end() || !boost::iequals(propertyIt->first, "prefix"))
+    throw Error("Expect <shared-key.prefix>!");
+
+  Name prefix(propertyIt->second.data());
+  propertyIt++;
+
+  if (propertyIt == schemaSection.end() || !boost::iequals(propertyIt->first, "name"))
+    throw Error("Expect <shared-key.name>!");
+
+  Name keyName(propertyIt->second.data());
+  propertyIt++;
+
+  if (propertyIt == schemaSection.end())
+    throw Error("Expect more properties!");
+
+  std::string type = propertyIt->first.data();
+  std::string base64Key;
+
+  if (boost::iequals(type, "file")) {
+    path keyFilePath = absolute(propertyIt->second.data(), path(filename).parent_path());
+
+    std::ifstream keyFile(keyFilePath.c_str());
+    if (!keyFile.good())
+      throw Error("Cannot read shared key from file: " + keyFilePath.string());
+
+    std::stringstream ss;
+    ss << keyFile.rdbuf();
+    base64Key = ss.str();
+  }
+  else if (boost::iequals(type, "base64")) {
+    base64Key = propertyIt->second.data();
+  }
+  else
+    throw Error("Unsupported shared-key.type: " + type);
+  propertyIt++;
+
+  // Check other stuff
+  if (propertyIt != schemaSection.end())
+    throw Error("Expect the end of shared-key!");
+
+  try {
+    m_sharedKeys.insert(prefix, keyName, base64Key);
+  }
+  catch (SharedKeyContainer::Error& e) {
+    throw Error(e.what());
+  }
+}
+
 time::nanoseconds
 SchemaInterpreter::getRefreshPeriod(std::string inputString)
 {
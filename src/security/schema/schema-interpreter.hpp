@@ -28,6 +28,7 @@
 #include "rule.hpp"
 #include "common.hpp"
 #include "trust-anchor-container.hpp"
+#include "../shared-key-container.hpp"
 
 namespace ndn {
 namespace security {
@@ -113,6 +114,9 @@ public:
   shared_ptr<const SignatureRequirement>
   getSigReq();
 
+  SharedKeyContainer&
+  getSharedKeys();
+
   void
   refreshAnchors();
 
@@ -136,6 +140,10 @@ private:
   onConfigTrustAnchor(const SchemaSection& schemaSection,
                       const std::string& filename);
 
+  void
+  onConfigSharedKey(const SchemaSection& schemaSection,
+                    const std::string& filename);
+
   time::nanoseconds
   getRefreshPeriod(std::string refreshString);
 
@@ -148,6 +156,7 @@ private:
   TrustAnchorContainer m_staticAnchors;
   DynamicTrustAnchorContainer m_dynamicAnchors;
   shared_ptr<SignatureRequirement> m_sigReq;
+  SharedKeyContainer m_sharedKeys;
   bool m_checkFlag;
 };
 
@@ -187,6 +196,12 @@ SchemaInterpreter::getSigReq()
   return m_sigReq;
 }
 
+inline SharedKeyContainer&
+SchemaInterpreter::getSharedKeys()
+{
+  return m_sharedKeys;
+}
+
 } // namespace security
 } // namespace ndn
 #endif // NDN_SECURITY_SCHEMA_INTERPRETER_H
@@ -52,6 +52,8 @@ SignatureRequirement::SignatureRequirement(const SchemaSection& schemaSection)
     m_signingPolicies.insert(tlv::DigestSha256);
     m_signingPolicies.insert(tlv::SignatureSha256WithRsa);
     m_signingPolicies.insert(tlv::SignatureSha256WithEcdsa);
+    m_signingPolicies.insert(tlv::SignatureEd25519);
+    m_signingPolicies.insert(tlv::SignatureHmacWithSha256);
   }
   else {
     std::remove_if(signing.begin(),
@@ -74,6 +76,10 @@ SignatureRequirement::SignatureRequirement(const SchemaSection& schemaSection)
         m_signingPolicies.insert(tlv::SignatureSha256WithRsa);
       else if (boost::iequals(policy, "ecdsa"))
         m_signingPolicies.insert(tlv::SignatureSha256WithEcdsa);
+      else if (boost::iequals(policy, "ed25519"))
+        m_signingPolicies.insert(tlv::SignatureEd25519);
+      else if (boost::iequals(policy, "hmac"))
+        m_signingPolicies.insert(tlv::SignatureHmacWithSha256);
       else
         throw Error("Do not support other signing policy");
     }
@@ -120,6 +126,14 @@ SignatureRequirement::check(const Signature& sig)
     // currently we do not check the keysize of ecdsa
     return true;
   }
+  case tlv::SignatureEd25519: {
+    // Ed25519 has a fixed strength of 128 bits
+    return m_keySize <= 128;
+  }
+  case tlv::SignatureHmacWithSha256: {
+    // the length of the shared key is not visible in the signature
+    return true;
+  }
   default:
     return false;
   }
@@ -43,12 +43,12 @@ struct NameHash
   std::size_t
   operator()(const Name& prefix) const
   {
-    ndn::ConstBufferPtr buffer =
-      ndn::crypto::sha256(prefix.wireEncode().wire(), prefix.wireEncode().size());
+    uint8_t digest[ndn::crypto::SHA256_DIGEST_SIZE];
+    ndn::crypto::sha256(prefix.wireEncode().wire(), prefix.wireEncode().size(), digest);
 
-    BOOST_ASSERT(buffer->size() > sizeof(std::size_t));
-
-    return *reinterpret_cast<const std::size_t*>(buffer->buf());
+    std::size_t hash;
+    std::memcpy(&hash, digest, sizeof(hash));
+    return hash;
   }
 };
 
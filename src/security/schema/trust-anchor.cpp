@@ -38,7 +38,7 @@ TrustAnchor::TrustAnchor(const std::string& id, const std::string& regex, const
   shared_ptr<IdentityCertificate> idCert =
     io::load<IdentityCertificate>(certfilePath);
 
-  if (static_cast<bool>(idCert)) {
+  if (idCert != nullptr && idCert->isContentDecodable()) {
     BOOST_ASSERT(idCert->getName().size() >= 1);
     m_cert = idCert;
     m_keyName = idCert->getName().getPrefix(-1);
@@ -60,7 +60,7 @@ TrustAnchor::TrustAnchor(const std::string& id, const std::string& regex, const
 {
   std::stringstream ss(base64Str);
   shared_ptr<IdentityCertificate> idCert = io::load<IdentityCertificate>(ss);
-  if (static_cast<bool>(idCert)) {
+  if (idCert != nullptr && idCert->isContentDecodable()) {
     BOOST_ASSERT(idCert->getName().size() >= 1);
     m_cert = idCert;
     m_keyName = idCert->getName().getPrefix(-1);
@@ -76,7 +76,7 @@ TrustAnchor::refresh()
 
   shared_ptr<IdentityCertificate> idCert =
     io::load<IdentityCertificate>(m_path);
-  if (static_cast<bool>(idCert))
+  if (idCert != nullptr && idCert->isContentDecodable())
     m_cert = idCert;
 }
 
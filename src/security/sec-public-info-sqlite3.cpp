@@ -109,6 +109,96 @@ sqlite3_column_string(sqlite3_stmt* statement, int column)
                 sqlite3_column_bytes(statement, column));
 }
 
+/**
+ * Executes a statement that updates the database.
+ * @throws SecPublicInfo::Error if the statement does not run to completion
+ */
+static void
+sqlite3_step_done(sqlite3_stmt* statement)
+{
+  if (sqlite3_step(statement) != SQLITE_DONE)
+    throw SecPublicInfo::Error("cannot update PIB: " +
+                               string(sqlite3_errmsg(sqlite3_db_handle(statement))));
+}
+
+/**
+ * @brief Cached prepared statement, reset for reuse when it goes out of scope
+ */
+class ScopedStatement : noncopyable
+{
+public:
+  explicit
+  ScopedStatement(sqlite3_stmt* statement)
+    : m_statement(statement)
+  {
+  }
+
+  ~ScopedStatement()
+  {
+    sqlite3_reset(m_statement);
+    sqlite3_clear_bindings(m_statement);
+  }
+
+  operator sqlite3_stmt*() const
+  {
+    return m_statement;
+  }
+
+private:
+  sqlite3_stmt* m_statement;
+};
+
+/**
+ * @brief Groups several updates, so that they are applied atomically and with a single commit
+ *
+ * Transactions are implemented with savepoints, and thus can be nested.  Unless commit() is
+ * called, all updates are rolled back when the transaction goes out of scope.
+ */
+class SecPublicInfoSqlite3::Transaction : ndn::noncopyable
+{
+public:
+  explicit
+  Transaction(SecPublicInfoSqlite3& pib)
+    : m_pib(pib)
+    , m_rollback(m_pib.prepare("ROLLBACK TO pib_update"))
+    , m_release(m_pib.prepare("RELEASE pib_update"))
+    , m_isCommitted(false)
+  {
+    // the statements needed to end the transaction are prepared before it starts,
+    // so that the destructor does not have to prepare (and possibly fail)
+    ScopedStatement statement(m_pib.prepare("SAVEPOINT pib_update"));
+    if (sqlite3_step(statement) != SQLITE_DONE)
+      throw Error("cannot start transaction: " + string(sqlite3_errmsg(m_pib.m_database)));
+  }
+
+  ~Transaction()
+  {
+    if (m_isCommitted)
+      return;
+
+    // errors are ignored: there is no way to report them from here
+    sqlite3_step(m_rollback);
+    sqlite3_reset(m_rollback);
+    sqlite3_step(m_release);
+    sqlite3_reset(m_release);
+  }
+
+  void
+  commit()
+  {
+    ScopedStatement statement(m_release);
+    if (sqlite3_step(statement) != SQLITE_DONE)
+      throw Error("cannot commit transaction: " + string(sqlite3_errmsg(m_pib.m_database)));
+    m_isCommitted = true;
+  }
+
+private:
+  SecPublicInfoSqlite3& m_pib;
+  sqlite3_stmt* m_rollback;
+  sqlite3_stmt* m_release;
+  bool m_isCommitted;
+};
+
 SecPublicInfoSqlite3::SecPublicInfoSqlite3(const std::string& dir)
   : SecPublicInfo(dir)
   , m_database(nullptr)
@@ -135,6 +225,18 @@ SecPublicInfoSqlite3::SecPublicInfoSqlite3(const std::string& dir)
 
   BOOST_ASSERT(m_database != nullptr);
 
+#ifndef NDN_CXX_DISABLE_SQLITE3_FS_LOCKING
+  // Write-ahead logging needs one fsync per transaction instead of several, and does not block
+  // readers while updating.  It relies on shared memory, which unix-dotfile locking lacks.
+  // With WAL, synchronous=NORMAL keeps the database consistent, although the last
+  // transactions may be lost on power failure.
+  sqlite3_exec(m_database,
+               "PRAGMA journal_mode=WAL;"
+               "PRAGMA synchronous=NORMAL;",
+               nullptr, nullptr, nullptr);
+#endif // NDN_CXX_DISABLE_SQLITE3_FS_LOCKING
+  sqlite3_exec(m_database, "PRAGMA temp_store=MEMORY;", nullptr, nullptr, nullptr);
+
   initializeTable("TpmInfo", INIT_TPM_INFO_TABLE); // Check if TpmInfo table exists;
   initializeTable("Identity", INIT_ID_TABLE);      // Check if Identity table exists;
   initializeTable("Key", INIT_KEY_TABLE);          // Check if Key table exists;
@@ -143,10 +245,31 @@ SecPublicInfoSqlite3::SecPublicInfoSqlite3(const std::string& dir)
 
 SecPublicInfoSqlite3::~SecPublicInfoSqlite3()
 {
+  for (const auto& statement : m_statements)
+    sqlite3_finalize(statement.second);
+  m_statements.clear();
+
   sqlite3_close(m_database);
   m_database = nullptr;
 }
 
+sqlite3_stmt*
+SecPublicInfoSqlite3::prepare(const char* sql)
+{
+  auto it = m_statements.find(sql);
+  if (it != m_statements.end())
+    return it->second;
+
+  sqlite3_stmt* statement = nullptr;
+  if (sqlite3_prepare_v2(m_database, sql, -1, &statement, 0) != SQLITE_OK) {
+    sqlite3_finalize(statement);
+    throw Error("cannot prepare statement: " + string(sqlite3_errmsg(m_database)));
+  }
+
+  m_statements.insert(std::make_pair(sql, statement));
+  return statement;
+}
+
 bool
 SecPublicInfoSqlite3::doesTableExist(const string& tableName)
 {
@@ -191,8 +314,10 @@ SecPublicInfoSqlite3::deleteTable(const string& tableName)
   sqlite3_stmt* statement = nullptr;
   sqlite3_prepare_v2(m_database, query.c_str(), -1, &statement, 0);
 
-  sqlite3_step(statement);
+  int res = sqlite3_step(statement);
   sqlite3_finalize(statement);
+  if (res != SQLITE_DONE)
+    throw Error("cannot delete table " + tableName + ": " + string(sqlite3_errmsg(m_database)));
 }
 
 void
@@ -216,28 +341,22 @@ SecPublicInfoSqlite3::setTpmLocator(const string& tpmLocator)
 string
 SecPublicInfoSqlite3::getTpmLocator()
 {
-  sqlite3_stmt* statement = nullptr;
-  sqlite3_prepare_v2(m_database, "SELECT tpm_locator FROM TpmInfo", -1, &statement, 0);
+  ScopedStatement statement(prepare("SELECT tpm_locator FROM TpmInfo"));
 
   int res = sqlite3_step(statement);
 
-  if (res == SQLITE_ROW) {
-    string tpmLocator = sqlite3_column_string(statement, 0);
-    sqlite3_finalize(statement);
-    return tpmLocator;
-  }
-  else {
-    sqlite3_finalize(statement);
+  if (res == SQLITE_ROW)
+    return sqlite3_column_string(statement, 0);
+  else
     throw SecPublicInfo::Error("TPM info does not exist");
-  }
 }
 
 void
 SecPublicInfoSqlite3::setTpmLocatorInternal(const string& tpmLocator, bool needReset)
 {
-  sqlite3_stmt* statement = nullptr;
-
   if (needReset) {
+    Transaction transaction(*this);
+
     deleteTable("Identity");
     deleteTable("Key");
     deleteTable("Certificate");
@@ -246,19 +365,18 @@ SecPublicInfoSqlite3::setTpmLocatorInternal(const string& tpmLocator, bool needR
     initializeTable("Key", INIT_KEY_TABLE);
     initializeTable("Certificate", INIT_CERT_TABLE);
 
-    sqlite3_prepare_v2(m_database, "UPDATE TpmInfo SET tpm_locator = ?",
-                       -1, &statement, 0);
+    ScopedStatement statement(prepare("UPDATE TpmInfo SET tpm_locator = ?"));
     sqlite3_bind_string(statement, 1, tpmLocator, SQLITE_TRANSIENT);
+    sqlite3_step_done(statement);
+
+    transaction.commit();
   }
   else {
     // no reset implies there is no tpmLocator record, insert one
-    sqlite3_prepare_v2(m_database, "INSERT INTO TpmInfo (tpm_locator) VALUES (?)",
-                       -1, &statement, 0);
+    ScopedStatement statement(prepare("INSERT INTO TpmInfo (tpm_locator) VALUES (?)"));
     sqlite3_bind_string(statement, 1, tpmLocator, SQLITE_TRANSIENT);
+    sqlite3_step_done(statement);
   }
-
-  sqlite3_step(statement);
-  sqlite3_finalize(statement);
 }
 
 std::string
@@ -272,10 +390,7 @@ SecPublicInfoSqlite3::doesIdentityExist(const Name& identityName)
 {
   bool result = false;
 
-  sqlite3_stmt* statement = nullptr;
-  sqlite3_prepare_v2(m_database,
-                     "SELECT count(*) FROM Identity WHERE identity_name=?",
-                     -1, &statement, 0);
+  ScopedStatement statement(prepare("SELECT count(*) FROM Identity WHERE identity_name=?"));
 
   sqlite3_bind_string(statement, 1, identityName.toUri(), SQLITE_TRANSIENT);
   int res = sqlite3_step(statement);
@@ -286,8 +401,6 @@ SecPublicInfoSqlite3::doesIdentityExist(const Name& identityName)
       result = true;
   }
 
-  sqlite3_finalize(statement);
-
   return result;
 }
 
@@ -297,17 +410,11 @@ SecPublicInfoSqlite3::addIdentity(const Name& identityName)
   if (doesIdentityExist(identityName))
     return;
 
-  sqlite3_stmt* statement = nullptr;
-
-  sqlite3_prepare_v2(m_database,
-                     "INSERT OR REPLACE INTO Identity (identity_name) values (?)",
-                     -1, &statement, 0);
+  ScopedStatement statement(prepare("INSERT OR REPLACE INTO Identity (identity_name) values (?)"));
 
   sqlite3_bind_string(statement, 1, identityName.toUri(), SQLITE_TRANSIENT);
 
-  sqlite3_step(statement);
-
-  sqlite3_finalize(statement);
+  sqlite3_step_done(statement);
 }
 
 bool
@@ -326,10 +433,8 @@ SecPublicInfoSqlite3::doesPublicKeyExist(const Name& keyName)
   string keyId = keyName.get(-1).toUri();
   Name identityName = keyName.getPrefix(-1);
 
-  sqlite3_stmt* statement = nullptr;
-  sqlite3_prepare_v2(m_database,
-                     "SELECT count(*) FROM Key WHERE identity_name=? AND key_identifier=?",
-                     -1, &statement, 0);
+  ScopedStatement statement(
+    prepare("SELECT count(*) FROM Key WHERE identity_name=? AND key_identifier=?"));
 
   sqlite3_bind_string(statement, 1, identityName.toUri(), SQLITE_TRANSIENT);
   sqlite3_bind_string(statement, 2, keyId, SQLITE_TRANSIENT);
@@ -343,8 +448,6 @@ SecPublicInfoSqlite3::doesPublicKeyExist(const Name& keyName)
       keyIdExist = true;
   }
 
-  sqlite3_finalize(statement);
-
   return keyIdExist;
 }
 
@@ -355,6 +458,8 @@ SecPublicInfoSqlite3::addKey(const Name& keyName,
   if (keyName.empty())
     return;
 
+  Transaction transaction(*this);
+
   if (doesPublicKeyExist(keyName))
     return;
 
@@ -363,24 +468,23 @@ SecPublicInfoSqlite3::addKey(const Name& keyName,
 
   addIdentity(identityName);
 
-  sqlite3_stmt* statement = nullptr;
-  sqlite3_prepare_v2(m_database,
-                     "INSERT OR REPLACE INTO Key \
-                      (identity_name, key_identifier, key_type, public_key) \
-                      values (?, ?, ?, ?)",
-                     -1, &statement, 0);
+  {
+    ScopedStatement statement(prepare("INSERT OR REPLACE INTO Key \
+                                       (identity_name, key_identifier, key_type, public_key) \
+                                       values (?, ?, ?, ?)"));
 
-  sqlite3_bind_string(statement, 1, identityName.toUri(), SQLITE_TRANSIENT);
-  sqlite3_bind_string(statement, 2, keyId, SQLITE_TRANSIENT);
-  sqlite3_bind_int(statement, 3, publicKeyDer.getKeyType());
-  sqlite3_bind_blob(statement, 4,
-                    publicKeyDer.get().buf(),
-                    publicKeyDer.get().size(),
-                    SQLITE_STATIC);
+    sqlite3_bind_string(statement, 1, identityName.toUri(), SQLITE_TRANSIENT);
+    sqlite3_bind_string(statement, 2, keyId, SQLITE_TRANSIENT);
+    sqlite3_bind_int(statement, 3, publicKeyDer.getKeyType());
+    sqlite3_bind_blob(statement, 4,
+                      publicKeyDer.get().buf(),
+                      publicKeyDer.get().size(),
+                      SQLITE_STATIC);
 
-  sqlite3_step(statement);
+    sqlite3_step_done(statement);
+  }
 
-  sqlite3_finalize(statement);
+  transaction.commit();
 }
 
 shared_ptr<PublicKey>
@@ -392,27 +496,19 @@ SecPublicInfoSqlite3::getPublicKey(const Name& keyName)
   string keyId = keyName.get(-1).toUri();
   Name identityName = keyName.getPrefix(-1);
 
-  sqlite3_stmt* statement = nullptr;
-  sqlite3_prepare_v2(m_database,
-                     "SELECT public_key FROM Key WHERE identity_name=? AND key_identifier=?",
-                     -1, &statement, 0);
+  ScopedStatement statement(
+    prepare("SELECT public_key FROM Key WHERE identity_name=? AND key_identifier=?"));
 
   sqlite3_bind_string(statement, 1, identityName.toUri(), SQLITE_TRANSIENT);
   sqlite3_bind_string(statement, 2, keyId, SQLITE_TRANSIENT);
 
   int res = sqlite3_step(statement);
 
-  shared_ptr<PublicKey> result;
-  if (res == SQLITE_ROW) {
-    result = make_shared<PublicKey>(static_cast<const uint8_t*>(sqlite3_column_blob(statement, 0)),
-                                    sqlite3_column_bytes(statement, 0));
-    sqlite3_finalize(statement);
-    return result;
-  }
-  else {
-    sqlite3_finalize(statement);
+  if (res == SQLITE_ROW)
+    return make_shared<PublicKey>(static_cast<const uint8_t*>(sqlite3_column_blob(statement, 0)),
+                                  sqlite3_column_bytes(statement, 0));
+  else
     throw Error("SecPublicInfoSqlite3::getPublicKey  public key does not exist");
-  }
 }
 
 KeyType
@@ -424,34 +520,24 @@ SecPublicInfoSqlite3::getPublicKeyType(const Name& keyName)
   string keyId = keyName.get(-1).toUri();
   Name identityName = keyName.getPrefix(-1);
 
-  sqlite3_stmt* statement = nullptr;
-  sqlite3_prepare_v2(m_database,
-                     "SELECT key_type FROM Key WHERE identity_name=? AND key_identifier=?",
-                     -1, &statement, 0);
+  ScopedStatement statement(
+    prepare("SELECT key_type FROM Key WHERE identity_name=? AND key_identifier=?"));
 
   sqlite3_bind_string(statement, 1, identityName.toUri(), SQLITE_TRANSIENT);
   sqlite3_bind_string(statement, 2, keyId, SQLITE_TRANSIENT);
 
   int res = sqlite3_step(statement);
 
-  if (res == SQLITE_ROW) {
-    int typeValue = sqlite3_column_int(statement, 0);
-    sqlite3_finalize(statement);
-    return static_cast<KeyType>(typeValue);
-  }
-  else {
-    sqlite3_finalize(statement);
+  if (res == SQLITE_ROW)
+    return static_cast<KeyType>(sqlite3_column_int(statement, 0));
+  else
     return KEY_TYPE_NULL;
-  }
 }
 
 bool
 SecPublicInfoSqlite3::doesCertificateExist(const Name& certificateName)
 {
-  sqlite3_stmt* statement = nullptr;
-  sqlite3_prepare_v2(m_database,
-                     "SELECT count(*) FROM Certificate WHERE cert_name=?",
-                     -1, &statement, 0);
+  ScopedStatement statement(prepare("SELECT count(*) FROM Certificate WHERE cert_name=?"));
 
   sqlite3_bind_string(statement, 1, certificateName.toUri(), SQLITE_TRANSIENT);
 
@@ -464,8 +550,6 @@ SecPublicInfoSqlite3::doesCertificateExist(const Name& certificateName)
       certExist = true;
   }
 
-  sqlite3_finalize(statement);
-
   return certExist;
 }
 
@@ -477,61 +561,75 @@ SecPublicInfoSqlite3::addCertificate(const IdentityCertificate& certificate)
   Name keyName =
     IdentityCertificate::certificateNameToPublicKeyName(certificate.getName());
 
+  Transaction transaction(*this);
+
   addKey(keyName, certificate.getPublicKeyInfo());
 
-  if (doesCertificateExist(certificateName))
+  if (doesCertificateExist(certificateName)) {
+    transaction.commit();
     return;
+  }
 
   string keyId = keyName.get(-1).toUri();
   Name identity = keyName.getPrefix(-1);
 
-  // Insert the certificate
-  sqlite3_stmt* statement = nullptr;
-  sqlite3_prepare_v2(m_database,
-                     "INSERT OR REPLACE INTO Certificate \
-                      (cert_name, cert_issuer, identity_name, key_identifier, \
-                       not_before, not_after, certificate_data) \
-                      values (?, ?, ?, ?, datetime(?, 'unixepoch'), datetime(?, 'unixepoch'), ?)",
-                      -1, &statement, 0);
-
-  sqlite3_bind_string(statement, 1, certificateName.toUri(), SQLITE_TRANSIENT);
-
+  std::string signerName;
   try {
     // this will throw an exception if the signature is not the standard one
     // or there is no key locator present
-    std::string signerName = certificate.getSignature().getKeyLocator().getName().toUri();
-    sqlite3_bind_string(statement, 2, signerName, SQLITE_TRANSIENT);
+    signerName = certificate.getSignature().getKeyLocator().getName().toUri();
   }
   catch (tlv::Error&) {
+    // the key is kept even though the certificate is not added
+    transaction.commit();
     return;
   }
 
-  sqlite3_bind_string(statement, 3, identity.toUri(), SQLITE_TRANSIENT);
-  sqlite3_bind_string(statement, 4, keyId, SQLITE_STATIC);
+  {
+    // Insert the certificate
+    ScopedStatement statement(
+      prepare("INSERT OR REPLACE INTO Certificate \
+               (cert_name, cert_issuer, identity_name, key_identifier, \
+                not_before, not_after, certificate_data) \
+               values (?, ?, ?, ?, datetime(?, 'unixepoch'), datetime(?, 'unixepoch'), ?)"));
 
-  sqlite3_bind_int64(statement, 5,
-    static_cast<sqlite3_int64>(time::toUnixTimestamp(certificate.getNotBefore()).count()));
-  sqlite3_bind_int64(statement, 6,
-    static_cast<sqlite3_int64>(time::toUnixTimestamp(certificate.getNotAfter()).count()));
+    sqlite3_bind_string(statement, 1, certificateName.toUri(), SQLITE_TRANSIENT);
+    sqlite3_bind_string(statement, 2, signerName, SQLITE_TRANSIENT);
+    sqlite3_bind_string(statement, 3, identity.toUri(), SQLITE_TRANSIENT);
+    sqlite3_bind_string(statement, 4, keyId, SQLITE_STATIC);
 
-  sqlite3_bind_blob(statement, 7,
-                    certificate.wireEncode().wire(),
-                    certificate.wireEncode().size(),
-                    SQLITE_TRANSIENT);
+    sqlite3_bind_int64(statement, 5,
+      static_cast<sqlite3_int64>(time::toUnixTimestamp(certificate.getNotBefore()).count()));
+    sqlite3_bind_int64(statement, 6,
+      static_cast<sqlite3_int64>(time::toUnixTimestamp(certificate.getNotAfter()).count()));
 
-  sqlite3_step(statement);
+    sqlite3_bind_blob(statement, 7,
+                      certificate.wireEncode().wire(),
+                      certificate.wireEncode().size(),
+                      SQLITE_TRANSIENT);
 
-  sqlite3_finalize(statement);
+    sqlite3_step_done(statement);
+  }
+
+  transaction.commit();
+}
+
+void
+SecPublicInfoSqlite3::addCertificates(const std::vector<shared_ptr<IdentityCertificate>>& certificates)
+{
+  Transaction transaction(*this);
+
+  // each addCertificate opens a nested savepoint, which is only a marker inside this transaction
+  for (const auto& certificate : certificates)
+    addCertificate(*certificate);
+
+  transaction.commit();
 }
 
 shared_ptr<IdentityCertificate>
 SecPublicInfoSqlite3::getCertificate(const Name& certificateName)
 {
-  sqlite3_stmt* statement = nullptr;
-
-  sqlite3_prepare_v2(m_database,
-                     "SELECT certificate_data FROM Certificate WHERE cert_name=?",
-                     -1, &statement, 0);
+  ScopedStatement statement(prepare("SELECT certificate_data FROM Certificate WHERE cert_name=?"));
 
   sqlite3_bind_string(statement, 1, certificateName.toUri(), SQLITE_TRANSIENT);
 
@@ -544,15 +642,12 @@ SecPublicInfoSqlite3::getCertificate(const Name& certificateName)
                                     sqlite3_column_bytes(statement, 0)));
     }
     catch (tlv::Error&) {
-      sqlite3_finalize(statement);
       throw Error("SecPublicInfoSqlite3::getCertificate  certificate cannot be decoded");
     }
 
-    sqlite3_finalize(statement);
     return certificate;
   }
   else {
-    sqlite3_finalize(statement);
     throw Error("SecPublicInfoSqlite3::getCertificate  certificate does not exist");
   }
 }
@@ -561,60 +656,49 @@ SecPublicInfoSqlite3::getCertificate(const Name& certificateName)
 Name
 SecPublicInfoSqlite3::getDefaultIdentity()
 {
-  sqlite3_stmt* statement = nullptr;
-  sqlite3_prepare_v2(m_database,
-                     "SELECT identity_name FROM Identity WHERE default_identity=1",
-                     -1, &statement, 0);
+  ScopedStatement statement(prepare("SELECT identity_name FROM Identity WHERE default_identity=1"));
 
   int res = sqlite3_step(statement);
 
-  if (res == SQLITE_ROW) {
-    Name identity(sqlite3_column_string(statement, 0));
-    sqlite3_finalize(statement);
-    return identity;
-  }
-  else {
-    sqlite3_finalize(statement);
+  if (res == SQLITE_ROW)
+    return Name(sqlite3_column_string(statement, 0));
+  else
     throw Error("SecPublicInfoSqlite3::getDefaultIdentity  no default identity");
-  }
 }
 
 void
 SecPublicInfoSqlite3::setDefaultIdentityInternal(const Name& identityName)
 {
-  addIdentity(identityName);
+  Transaction transaction(*this);
 
-  sqlite3_stmt* statement = nullptr;
-
-  //Reset previous default identity
-  sqlite3_prepare_v2(m_database,
-                     "UPDATE Identity SET default_identity=0 WHERE default_identity=1",
-                     -1, &statement, 0);
+  addIdentity(identityName);
 
-  while (sqlite3_step(statement) == SQLITE_ROW)
-    ;
+  {
+    //Reset previous default identity
+    ScopedStatement statement(
+      prepare("UPDATE Identity SET default_identity=0 WHERE default_identity=1"));
 
-  sqlite3_finalize(statement);
+    sqlite3_step_done(statement);
+  }
 
-  //Set current default identity
-  sqlite3_prepare_v2(m_database,
-                     "UPDATE Identity SET default_identity=1 WHERE identity_name=?",
-                     -1, &statement, 0);
+  {
+    //Set current default identity
+    ScopedStatement statement(
+      prepare("UPDATE Identity SET default_identity=1 WHERE identity_name=?"));
 
-  sqlite3_bind_string(statement, 1, identityName.toUri(), SQLITE_TRANSIENT);
+    sqlite3_bind_string(statement, 1, identityName.toUri(), SQLITE_TRANSIENT);
 
-  sqlite3_step(statement);
+    sqlite3_step_done(statement);
+  }
 
-  sqlite3_finalize(statement);
+  transaction.commit();
 }
 
 Name
 SecPublicInfoSqlite3::getDefaultKeyNameForIdentity(const Name& identityName)
 {
-  sqlite3_stmt* statement = nullptr;
-  sqlite3_prepare_v2(m_database,
-                     "SELECT key_identifier FROM Key WHERE identity_name=? AND default_key=1",
-                     -1, &statement, 0);
+  ScopedStatement statement(
+    prepare("SELECT key_identifier FROM Key WHERE identity_name=? AND default_key=1"));
 
   sqlite3_bind_string(statement, 1, identityName.toUri(), SQLITE_TRANSIENT);
 
@@ -624,11 +708,9 @@ SecPublicInfoSqlite3::getDefaultKeyNameForIdentity(const Name& identityName)
     Name keyName = identityName;
     keyName.append(string(reinterpret_cast<const char*>(sqlite3_column_text(statement, 0)),
                           sqlite3_column_bytes(statement, 0)));
-    sqlite3_finalize(statement);
     return keyName;
   }
   else {
-    sqlite3_finalize(statement);
     throw Error("SecPublicInfoSqlite3::getDefaultKeyNameForIdentity key not found");
   }
 }
@@ -636,37 +718,36 @@ SecPublicInfoSqlite3::getDefaultKeyNameForIdentity(const Name& identityName)
 void
 SecPublicInfoSqlite3::setDefaultKeyNameForIdentityInternal(const Name& keyName)
 {
+  Transaction transaction(*this);
+
   if (!doesPublicKeyExist(keyName))
     throw Error("Key does not exist:" + keyName.toUri());
 
   string keyId = keyName.get(-1).toUri();
   Name identityName = keyName.getPrefix(-1);
 
-  sqlite3_stmt* statement = nullptr;
+  {
+    //Reset previous default Key
+    ScopedStatement statement(
+      prepare("UPDATE Key SET default_key=0 WHERE default_key=1 and identity_name=?"));
 
-  //Reset previous default Key
-  sqlite3_prepare_v2(m_database,
-                     "UPDATE Key SET default_key=0 WHERE default_key=1 and identity_name=?",
-                     -1, &statement, 0);
+    sqlite3_bind_string(statement, 1, identityName.toUri(), SQLITE_TRANSIENT);
 
-  sqlite3_bind_string(statement, 1, identityName.toUri(), SQLITE_TRANSIENT);
-
-  while (sqlite3_step(statement) == SQLITE_ROW)
-    ;
-
-  sqlite3_finalize(statement);
+    sqlite3_step_done(statement);
+  }
 
-  //Set current default Key
-  sqlite3_prepare_v2(m_database,
-                     "UPDATE Key SET default_key=1 WHERE identity_name=? AND key_identifier=?",
-                     -1, &statement, 0);
+  {
+    //Set current default Key
+    ScopedStatement statement(
+      prepare("UPDATE Key SET default_key=1 WHERE identity_name=? AND key_identifier=?"));
 
-  sqlite3_bind_string(statement, 1, identityName.toUri(), SQLITE_TRANSIENT);
-  sqlite3_bind_string(statement, 2, keyId, SQLITE_TRANSIENT);
+    sqlite3_bind_string(statement, 1, identityName.toUri(), SQLITE_TRANSIENT);
+    sqlite3_bind_string(statement, 2, keyId, SQLITE_TRANSIENT);
 
-  sqlite3_step(statement);
+    sqlite3_step_done(statement);
+  }
 
-  sqlite3_finalize(statement);
+  transaction.commit();
 }
 
 Name
@@ -678,32 +759,27 @@ SecPublicInfoSqlite3::getDefaultCertificateNameForKey(const Name& keyName)
   string keyId = keyName.get(-1).toUri();
   Name identityName = keyName.getPrefix(-1);
 
-  sqlite3_stmt* statement = nullptr;
-  sqlite3_prepare_v2(m_database,
-                     "SELECT cert_name FROM Certificate \
-                      WHERE identity_name=? AND key_identifier=? AND default_cert=1",
-                     -1, &statement, 0);
+  ScopedStatement statement(
+    prepare("SELECT cert_name FROM Certificate \
+             WHERE identity_name=? AND key_identifier=? AND default_cert=1"));
 
   sqlite3_bind_string(statement, 1, identityName.toUri(), SQLITE_TRANSIENT);
   sqlite3_bind_string(statement, 2, keyId, SQLITE_TRANSIENT);
 
   int res = sqlite3_step(statement);
 
-  if (res == SQLITE_ROW) {
-    Name certName(string(reinterpret_cast<const char*>(sqlite3_column_text(statement, 0)),
-                         sqlite3_column_bytes(statement, 0)));
-    sqlite3_finalize(statement);
-    return certName;
-  }
-  else {
-    sqlite3_finalize(statement);
+  if (res == SQLITE_ROW)
+    return Name(string(reinterpret_cast<const char*>(sqlite3_column_text(statement, 0)),
+                       sqlite3_column_bytes(statement, 0)));
+  else
     throw Error("certificate not found");
-  }
 }
 
 void
 SecPublicInfoSqlite3::setDefaultCertificateNameForKeyInternal(const Name& certificateName)
 {
+  Transaction transaction(*this);
+
   if (!doesCertificateExist(certificateName))
     throw Error("certificate does not exist:" + certificateName.toUri());
 
@@ -711,70 +787,52 @@ SecPublicInfoSqlite3::setDefaultCertificateNameForKeyInternal(const Name& certif
   string keyId = keyName.get(-1).toUri();
   Name identityName = keyName.getPrefix(-1);
 
-  sqlite3_stmt* statement = nullptr;
-
-  //Reset previous default Key
-  sqlite3_prepare_v2(m_database,
-                     "UPDATE Certificate SET default_cert=0 \
-                      WHERE default_cert=1 AND identity_name=? AND key_identifier=?",
-                     -1, &statement, 0);
-
-  sqlite3_bind_string(statement, 1, identityName.toUri(), SQLITE_TRANSIENT);
-  sqlite3_bind_string(statement, 2, keyId, SQLITE_TRANSIENT);
+  {
+    //Reset previous default Key
+    ScopedStatement statement(
+      prepare("UPDATE Certificate SET default_cert=0 \
+               WHERE default_cert=1 AND identity_name=? AND key_identifier=?"));
 
-  while (sqlite3_step(statement) == SQLITE_ROW)
-    ;
+    sqlite3_bind_string(statement, 1, identityName.toUri(), SQLITE_TRANSIENT);
+    sqlite3_bind_string(statement, 2, keyId, SQLITE_TRANSIENT);
 
-  sqlite3_finalize(statement);
+    sqlite3_step_done(statement);
+  }
 
-  //Set current default Key
-  sqlite3_prepare_v2(m_database,
-                     "UPDATE Certificate SET default_cert=1 \
-                      WHERE identity_name=? AND key_identifier=? AND cert_name=?",
-                     -1, &statement, 0);
+  {
+    //Set current default Key
+    ScopedStatement statement(
+      prepare("UPDATE Certificate SET default_cert=1 \
+               WHERE identity_name=? AND key_identifier=? AND cert_name=?"));
 
-  sqlite3_bind_string(statement, 1, identityName.toUri(), SQLITE_TRANSIENT);
-  sqlite3_bind_string(statement, 2, keyId, SQLITE_TRANSIENT);
-  sqlite3_bind_string(statement, 3, certificateName.toUri(), SQLITE_TRANSIENT);
+    sqlite3_bind_string(statement, 1, identityName.toUri(), SQLITE_TRANSIENT);
+    sqlite3_bind_string(statement, 2, keyId, SQLITE_TRANSIENT);
+    sqlite3_bind_string(statement, 3, certificateName.toUri(), SQLITE_TRANSIENT);
 
-  sqlite3_step(statement);
+    sqlite3_step_done(statement);
+  }
 
-  sqlite3_finalize(statement);
+  transaction.commit();
 }
 
 void
 SecPublicInfoSqlite3::getAllIdentities(vector<Name>& nameList, bool isDefault)
 {
-  sqlite3_stmt* stmt;
-  if (isDefault)
-    sqlite3_prepare_v2(m_database,
-                       "SELECT identity_name FROM Identity WHERE default_identity=1",
-                       -1, &stmt, 0);
-  else
-    sqlite3_prepare_v2(m_database,
-                       "SELECT identity_name FROM Identity WHERE default_identity=0",
-                       -1, &stmt, 0);
+  ScopedStatement stmt(prepare(isDefault ?
+                               "SELECT identity_name FROM Identity WHERE default_identity=1" :
+                               "SELECT identity_name FROM Identity WHERE default_identity=0"));
 
   while (sqlite3_step(stmt) == SQLITE_ROW)
     nameList.push_back(Name(string(reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0)),
                                    sqlite3_column_bytes(stmt, 0))));
-
-  sqlite3_finalize(stmt);
 }
 
 void
 SecPublicInfoSqlite3::getAllKeyNames(vector<Name>& nameList, bool isDefault)
 {
-  sqlite3_stmt* stmt;
-
-  if (isDefault)
-    sqlite3_prepare_v2(m_database,
-                       "SELECT identity_name, key_identifier FROM Key WHERE default_key=1",
-                       -1, &stmt, 0);
-  else
-    sqlite3_prepare_v2(m_database,
-                       "SELECT identity_name, key_identifier FROM Key WHERE default_key=0",
-                       -1, &stmt, 0);
+  ScopedStatement stmt(prepare(isDefault ?
+    "SELECT identity_name, key_identifier FROM Key WHERE default_key=1" :
+    "SELECT identity_name, key_identifier FROM Key WHERE default_key=0"));
 
   while (sqlite3_step(stmt) == SQLITE_ROW) {
     Name keyName(string(reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0)),
@@ -783,7 +841,6 @@ SecPublicInfoSqlite3::getAllKeyNames(vector<Name>& nameList, bool isDefault)
                           sqlite3_column_bytes(stmt, 1)));
     nameList.push_back(keyName);
   }
-  sqlite3_finalize(stmt);
 }
 
 void
@@ -791,16 +848,9 @@ SecPublicInfoSqlite3::getAllKeyNamesOfIdentity(const Name& identity,
                                                vector<Name>& nameList,
                                                bool isDefault)
 {
-  sqlite3_stmt* stmt;
-
-  if (isDefault)
-    sqlite3_prepare_v2(m_database,
-                       "SELECT key_identifier FROM Key WHERE default_key=1 and identity_name=?",
-                       -1, &stmt, 0);
-  else
-    sqlite3_prepare_v2(m_database,
-                       "SELECT key_identifier FROM Key WHERE default_key=0 and identity_name=?",
-                       -1, &stmt, 0);
+  ScopedStatement stmt(prepare(isDefault ?
+    "SELECT key_identifier FROM Key WHERE default_key=1 and identity_name=?" :
+    "SELECT key_identifier FROM Key WHERE default_key=0 and identity_name=?"));
 
   sqlite3_bind_string(stmt, 1, identity.toUri(), SQLITE_TRANSIENT);
 
@@ -810,28 +860,18 @@ SecPublicInfoSqlite3::getAllKeyNamesOfIdentity(const Name& identity,
                           sqlite3_column_bytes(stmt, 0)));
     nameList.push_back(keyName);
   }
-  sqlite3_finalize(stmt);
 }
 
 void
 SecPublicInfoSqlite3::getAllCertificateNames(vector<Name>& nameList, bool isDefault)
 {
-  sqlite3_stmt* stmt;
-
-  if (isDefault)
-    sqlite3_prepare_v2(m_database,
-                       "SELECT cert_name FROM Certificate WHERE default_cert=1",
-                       -1, &stmt, 0);
-  else
-    sqlite3_prepare_v2(m_database,
-                       "SELECT cert_name FROM Certificate WHERE default_cert=0",
-                       -1, &stmt, 0);
+  ScopedStatement stmt(prepare(isDefault ?
+                               "SELECT cert_name FROM Certificate WHERE default_cert=1" :
+                               "SELECT cert_name FROM Certificate WHERE default_cert=0"));
 
   while (sqlite3_step(stmt) == SQLITE_ROW)
     nameList.push_back(string(reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0)),
                               sqlite3_column_bytes(stmt, 0)));
-
-  sqlite3_finalize(stmt);
 }
 
 void
@@ -842,17 +882,11 @@ SecPublicInfoSqlite3::getAllCertificateNamesOfKey(const Name& keyName,
   if (keyName.empty())
     return;
 
-  sqlite3_stmt* stmt;
-  if (isDefault)
-    sqlite3_prepare_v2(m_database,
-                       "SELECT cert_name FROM Certificate \
-                        WHERE default_cert=1 and identity_name=? and key_identifier=?",
-                       -1, &stmt, 0);
-  else
-    sqlite3_prepare_v2(m_database,
-                       "SELECT cert_name FROM Certificate \
-                        WHERE default_cert=0 and identity_name=? and key_identifier=?",
-                       -1, &stmt, 0);
+  ScopedStatement stmt(prepare(isDefault ?
+    "SELECT cert_name FROM Certificate \
+     WHERE default_cert=1 and identity_name=? and key_identifier=?" :
+    "SELECT cert_name FROM Certificate \
+     WHERE default_cert=0 and identity_name=? and key_identifier=?"));
 
   Name identity = keyName.getPrefix(-1);
   sqlite3_bind_string(stmt, 1, identity.toUri(), SQLITE_TRANSIENT);
@@ -863,8 +897,6 @@ SecPublicInfoSqlite3::getAllCertificateNamesOfKey(const Name& keyName,
   while (sqlite3_step(stmt) == SQLITE_ROW)
     nameList.push_back(string(reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0)),
                               sqlite3_column_bytes(stmt, 0)));
-
-  sqlite3_finalize(stmt);
 }
 
 void
@@ -873,11 +905,9 @@ SecPublicInfoSqlite3::deleteCertificateInfo(const Name& certName)
   if (certName.empty())
     return;
 
-  sqlite3_stmt* stmt;
-  sqlite3_prepare_v2(m_database, "DELETE FROM Certificate WHERE cert_name=?", -1, &stmt, 0);
+  ScopedStatement stmt(prepare("DELETE FROM Certificate WHERE cert_name=?"));
   sqlite3_bind_string(stmt, 1, certName.toUri(), SQLITE_TRANSIENT);
-  sqlite3_step(stmt);
-  sqlite3_finalize(stmt);
+  sqlite3_step_done(stmt);
 }
 
 void
@@ -889,22 +919,24 @@ SecPublicInfoSqlite3::deletePublicKeyInfo(const Name& keyName)
   string identity = keyName.getPrefix(-1).toUri();
   string keyId = keyName.get(-1).toUri();
 
-  sqlite3_stmt* stmt;
-  sqlite3_prepare_v2(m_database,
-                     "DELETE FROM Certificate WHERE identity_name=? and key_identifier=?",
-                     -1, &stmt, 0);
-  sqlite3_bind_string(stmt, 1, identity, SQLITE_TRANSIENT);
-  sqlite3_bind_string(stmt, 2, keyId, SQLITE_TRANSIENT);
-  sqlite3_step(stmt);
-  sqlite3_finalize(stmt);
+  Transaction transaction(*this);
 
-  sqlite3_prepare_v2(m_database,
-                     "DELETE FROM Key WHERE identity_name=? and key_identifier=?",
-                     -1, &stmt, 0);
-  sqlite3_bind_string(stmt, 1, identity, SQLITE_TRANSIENT);
-  sqlite3_bind_string(stmt, 2, keyId, SQLITE_TRANSIENT);
-  sqlite3_step(stmt);
-  sqlite3_finalize(stmt);
+  {
+    ScopedStatement stmt(
+      prepare("DELETE FROM Certificate WHERE identity_name=? and key_identifier=?"));
+    sqlite3_bind_string(stmt, 1, identity, SQLITE_TRANSIENT);
+    sqlite3_bind_string(stmt, 2, keyId, SQLITE_TRANSIENT);
+    sqlite3_step_done(stmt);
+  }
+
+  {
+    ScopedStatement stmt(prepare("DELETE FROM Key WHERE identity_name=? and key_identifier=?"));
+    sqlite3_bind_string(stmt, 1, identity, SQLITE_TRANSIENT);
+    sqlite3_bind_string(stmt, 2, keyId, SQLITE_TRANSIENT);
+    sqlite3_step_done(stmt);
+  }
+
+  transaction.commit();
 }
 
 void
@@ -912,21 +944,27 @@ SecPublicInfoSqlite3::deleteIdentityInfo(const Name& identityName)
 {
   string identity = identityName.toUri();
 
-  sqlite3_stmt* stmt;
-  sqlite3_prepare_v2(m_database, "DELETE FROM Certificate WHERE identity_name=?", -1, &stmt, 0);
-  sqlite3_bind_string(stmt, 1, identity, SQLITE_TRANSIENT);
-  sqlite3_step(stmt);
-  sqlite3_finalize(stmt);
-
-  sqlite3_prepare_v2(m_database, "DELETE FROM Key WHERE identity_name=?", -1, &stmt, 0);
-  sqlite3_bind_string(stmt, 1, identity, SQLITE_TRANSIENT);
-  sqlite3_step(stmt);
-  sqlite3_finalize(stmt);
-
-  sqlite3_prepare_v2(m_database, "DELETE FROM Identity WHERE identity_name=?", -1, &stmt, 0);
-  sqlite3_bind_string(stmt, 1, identity, SQLITE_TRANSIENT);
-  sqlite3_step(stmt);
-  sqlite3_finalize(stmt);
+  Transaction transaction(*this);
+
+  {
+    ScopedStatement stmt(prepare("DELETE FROM Certificate WHERE identity_name=?"));
+    sqlite3_bind_string(stmt, 1, identity, SQLITE_TRANSIENT);
+    sqlite3_step_done(stmt);
+  }
+
+  {
+    ScopedStatement stmt(prepare("DELETE FROM Key WHERE identity_name=?"));
+    sqlite3_bind_string(stmt, 1, identity, SQLITE_TRANSIENT);
+    sqlite3_step_done(stmt);
+  }
+
+  {
+    ScopedStatement stmt(prepare("DELETE FROM Identity WHERE identity_name=?"));
+    sqlite3_bind_string(stmt, 1, identity, SQLITE_TRANSIENT);
+    sqlite3_step_done(stmt);
+  }
+
+  transaction.commit();
 }
 
 std::string
@@ -28,7 +28,10 @@
 #include "../common.hpp"
 #include "sec-public-info.hpp"
 
+#include <unordered_map>
+
 struct sqlite3;
+struct sqlite3_stmt;
 
 namespace ndn {
 
@@ -91,6 +94,12 @@ public:
   virtual void
   addCertificate(const IdentityCertificate& certificate);
 
+  /**
+   * @brief Add all certificates in a single transaction
+   */
+  virtual void
+  addCertificates(const std::vector<shared_ptr<IdentityCertificate>>& certificates);
+
   virtual shared_ptr<IdentityCertificate>
   getCertificate(const Name& certificateName);
 
@@ -130,6 +139,21 @@ public:
   deleteIdentityInfo(const Name& identity);
 
 private:
+  class Transaction;
+
+  /**
+   * @brief Get the prepared statement of @p sql
+   *
+   * The statement is prepared on first use and kept until the database is closed, so a
+   * statement must not be used again before the previous use has been reset.
+   *
+   * @param sql a string literal; statements are cached by its address, not by its text
+   *
+   * @throws Error if the statement cannot be prepared
+   */
+  sqlite3_stmt*
+  prepare(const char* sql);
+
   bool
   initializeTable(const std::string& tableName, const std::string& initCommand);
 
@@ -160,6 +184,8 @@ public:
 
 private:
   sqlite3* m_database;
+  /// prepared statements, keyed by the address of the SQL literal
+  std::unordered_map<const char*, sqlite3_stmt*> m_statements;
 };
 
 } // namespace ndn
@@ -103,6 +103,13 @@ SecPublicInfo::getNewKeyName(const Name& identityName, bool useKsk)
   return keyName;
 }
 
+void
+SecPublicInfo::addCertificates(const std::vector<shared_ptr<IdentityCertificate>>& certificates)
+{
+  for (const auto& certificate : certificates)
+    addCertificate(*certificate);
+}
+
 void
 SecPublicInfo::addCertificateAsKeyDefault(const IdentityCertificate& certificate)
 {
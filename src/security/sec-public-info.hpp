@@ -182,6 +182,17 @@ public:
   virtual void
   addCertificate(const IdentityCertificate& certificate) = 0;
 
+  /**
+   * @brief Add a batch of certificates to the identity storage.
+   *
+   * The default implementation calls addCertificate() for each certificate.  Implementations
+   * may override it to store the whole batch at once.
+   *
+   * @param certificates The certificates to be added
+   */
+  virtual void
+  addCertificates(const std::vector<shared_ptr<IdentityCertificate>>& certificates);
+
   /**
    * @brief Get a shared pointer to identity certificate object from the identity storage
    *
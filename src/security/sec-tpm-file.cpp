@@ -24,11 +24,16 @@
  */
 
 #include "sec-tpm-file.hpp"
+#include "crypto-backend.hpp"
 
 #include "../encoding/buffer-stream.hpp"
+#include "../encoding/block-helpers.hpp"
+#include "../util/crypto.hpp"
 
 #include <boost/filesystem.hpp>
 #include <boost/algorithm/string.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
+#include <boost/asio/io_service.hpp>
 
 #include "cryptopp.hpp"
 
@@ -36,20 +41,43 @@
 #include <sys/stat.h>
 
 #include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <thread>
 
 namespace ndn {
 
 using std::string;
-using std::ostringstream;
 using std::ofstream;
 
 const std::string SecTpmFile::SCHEME("tpm-file");
 
+/** @brief first byte of every DER-encoded key (SEQUENCE), which is never found in base64 text
+ */
+const uint8_t DER_SEQUENCE = 0x30;
+
+/** @return whether SecTpmFile can generate and sign with key pairs of @p keyType
+ */
+static bool
+isAsymmetricKeyType(KeyType keyType)
+{
+  return keyType == KEY_TYPE_RSA || keyType == KEY_TYPE_ECDSA || keyType == KEY_TYPE_ED25519;
+}
+
 class SecTpmFile::Impl
 {
 public:
-  explicit
-  Impl(const string& dir)
+  /// encoding of newly written key files
+  enum KeyFormat {
+    KEY_FORMAT_BASE64,
+    KEY_FORMAT_DER
+  };
+
+  Impl(const string& dir, KeyFormat keyFormat)
+    : m_keyFormat(keyFormat)
+    , m_isStopping(false)
   {
     if (dir.empty())
       m_keystorePath = boost::filesystem::path(getenv("HOME")) / ".ndn" / "ndnsec-tpm-file";
@@ -91,14 +119,496 @@ public:
     return keyFileName;
   }
 
+  /**
+   * @brief Get the key format selected by the `format` parameter of a TPM location
+   *
+   * @throws Error if the location has an unknown parameter
+   */
+  static KeyFormat
+  parseKeyFormat(const string& location)
+  {
+    size_t pos = location.find('?');
+    if (pos == string::npos)
+      return KEY_FORMAT_BASE64;
+
+    string parameters = location.substr(pos + 1);
+    if (parameters == "format=base64")
+      return KEY_FORMAT_BASE64;
+    else if (parameters == "format=der")
+      return KEY_FORMAT_DER;
+    else
+      throw Error("Unsupported parameters in TPM locator: " + parameters);
+  }
+
+  /**
+   * @brief Store the DER-encoded key @p der in file @p fileName in the configured format
+   */
+  void
+  writeKey(const string& fileName, const uint8_t* der, size_t size)
+  {
+    using namespace CryptoPP;
+
+    if (m_keyFormat == KEY_FORMAT_DER)
+      StringSource(der, size, true, new FileSink(fileName.c_str(), true));
+    else
+      StringSource(der, size, true, new Base64Encoder(new FileSink(fileName.c_str())));
+  }
+
+  /**
+   * @brief Write the raw bits of a symmetric key to file @p fileName
+   *
+   * Symmetric keys have no DER structure that tells the formats apart, so they are always
+   * base64-encoded, whatever format is selected for key pairs.
+   */
+  void
+  writeSymmetricKey(const string& fileName, const uint8_t* key, size_t size)
+  {
+    using namespace CryptoPP;
+
+    StringSource(key, size, true, new Base64Encoder(new FileSink(fileName.c_str())));
+  }
+
+  /**
+   * @brief Pass the raw bits of the symmetric key in file @p path to @p sink
+   */
+  void
+  readSymmetricKey(const boost::filesystem::path& path, CryptoPP::BufferedTransformation& sink)
+  {
+    using namespace CryptoPP;
+
+    FileSource(path.string().c_str(), true,
+               new Base64Decoder(new Redirector(sink, Redirector::DATA_ONLY)));
+    sink.MessageEnd();
+  }
+
+  /**
+   * @brief Get the bits of symmetric key @p keyName if signWithHmacInTpm() has read them before
+   * @return the key bits, or nullptr if they are not cached
+   */
+  ConstBufferPtr
+  findSymmetricKey(const Name& keyName)
+  {
+    std::lock_guard<std::mutex> lock(m_symmetricKeysMutex);
+    std::map<Name, ConstBufferPtr>::const_iterator it = m_symmetricKeys.find(keyName);
+    if (it == m_symmetricKeys.end())
+      return nullptr;
+    return it->second;
+  }
+
+  void
+  cacheSymmetricKey(const Name& keyName, const ConstBufferPtr& key)
+  {
+    std::lock_guard<std::mutex> lock(m_symmetricKeysMutex);
+    m_symmetricKeys[keyName] = key;
+  }
+
+  /**
+   * @brief Drop the cached bits of symmetric key @p keyName, which has been deleted or replaced
+   */
+  void
+  forgetSymmetricKey(const Name& keyName)
+  {
+    std::lock_guard<std::mutex> lock(m_symmetricKeysMutex);
+    m_symmetricKeys.erase(keyName);
+  }
+
+  /**
+   * @brief DER encoding of the key in a key file
+   *
+   * Keys in either format are accepted: a DER-encoded key is used in place from a memory
+   * mapping of the file, a base64-encoded key is decoded into a buffer.
+   */
+  class KeyFile : ndn::noncopyable
+  {
+  public:
+    explicit
+    KeyFile(const boost::filesystem::path& path)
+    {
+      using namespace CryptoPP;
+
+      try
+        {
+          m_file.open(path.string());
+        }
+      catch (const std::exception& e)
+        {
+          throw Error("Cannot read key file " + path.string() + ": " + e.what());
+        }
+
+      const uint8_t* data = reinterpret_cast<const uint8_t*>(m_file.data());
+      if (m_file.size() > 0 && data[0] == DER_SEQUENCE)
+        return;
+
+      OBufferStream os;
+      StringSource(data, m_file.size(), true, new Base64Decoder(new FileSink(os)));
+      m_decoded = os.buf();
+      m_file.close();
+    }
+
+    const uint8_t*
+    data() const
+    {
+      if (m_decoded != nullptr)
+        return m_decoded->buf();
+      return reinterpret_cast<const uint8_t*>(m_file.data());
+    }
+
+    size_t
+    size() const
+    {
+      if (m_decoded != nullptr)
+        return m_decoded->size();
+      return m_file.size();
+    }
+
+  private:
+    boost::iostreams::mapped_file_source m_file;
+    ConstBufferPtr m_decoded;
+  };
+
+  /**
+   * @brief DER encodings of a key pair that is not yet stored under a key name
+   */
+  struct KeyPair
+  {
+    string privateKey;
+    string publicKey;
+  };
+
+  /**
+   * @brief Get a key pair for @p params
+   *
+   * A pre-generated key pair is used if the reserve of @p params has one or is about to
+   * have one, otherwise the key pair is generated on the calling thread.
+   */
+  KeyPair
+  takeKeyPair(const KeyParams& params)
+  {
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      Reserve& reserve = m_reserves[getReserveKey(params)];
+      while (reserve.keyPairs.empty() && reserve.nPending > 0)
+        m_keyPairReady.wait(lock);
+
+      if (!reserve.keyPairs.empty())
+        {
+          KeyPair keyPair = std::move(reserve.keyPairs.front());
+          reserve.keyPairs.pop_front();
+          m_needKeyPair.notify_one();
+          return keyPair;
+        }
+    }
+
+    return generateKeyPair(getReserveKey(params));
+  }
+
+  typedef function<void(const KeyPair& keyPair)> KeyPairCallback;
+  typedef function<void(const std::string& reason)> KeyPairErrorCallback;
+
+  /**
+   * @brief Get a key pair for @p params without waiting for the key generation
+   *
+   * A pre-generated key pair is passed to @p onKeyPair right away, otherwise the key pair is
+   * generated by a background thread, which then calls @p onKeyPair or @p onError.
+   */
+  void
+  takeKeyPairAsync(const KeyParams& params,
+                   const KeyPairCallback& onKeyPair, const KeyPairErrorCallback& onError)
+  {
+    ReserveKey reserveKey = getReserveKey(params);
+    bool isThreadSafe = false;
+    try
+      {
+        isThreadSafe = CryptoBackend::getDefault(reserveKey.first).isThreadSafe();
+      }
+    catch (const CryptoBackend::Error& e)
+      {
+        onError(e.what());
+        return;
+      }
+
+    KeyPair keyPair;
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      Reserve& reserve = m_reserves[reserveKey];
+      if (!reserve.keyPairs.empty())
+        {
+          keyPair = std::move(reserve.keyPairs.front());
+          reserve.keyPairs.pop_front();
+          m_needKeyPair.notify_one();
+        }
+      else if (isThreadSafe)
+        {
+          Request request = {reserveKey, onKeyPair, onError};
+          m_requests.push_back(request);
+          if (m_workers.empty())
+            m_workers.emplace_back(&Impl::runWorker, this);
+          m_needKeyPair.notify_one();
+          return;
+        }
+    }
+
+    if (keyPair.privateKey.empty())
+      {
+        // the backend cannot generate key pairs on another thread
+        try
+          {
+            keyPair = generateKeyPair(reserveKey);
+          }
+        catch (const Error& e)
+          {
+            onError(e.what());
+            return;
+          }
+      }
+    onKeyPair(keyPair);
+  }
+
+  /**
+   * @brief Keep @p nKeyPairs key pairs for @p params generated in the background
+   */
+  void
+  reserveKeyPairs(const KeyParams& params, size_t nKeyPairs)
+  {
+    try
+      {
+        // the workers generate key pairs concurrently with each other and with signing
+        if (!CryptoBackend::getDefault(params.getKeyType()).isThreadSafe())
+          return;
+      }
+    catch (const CryptoBackend::Error& e)
+      {
+        throw Error(e.what());
+      }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Reserve& reserve = m_reserves[getReserveKey(params)];
+    reserve.size = nKeyPairs;
+    while (reserve.keyPairs.size() > nKeyPairs)
+      reserve.keyPairs.pop_back();
+
+    size_t nWanted = 0;
+    for (const auto& entry : m_reserves)
+      nWanted += entry.second.size;
+    size_t nThreads = std::min<size_t>(nWanted, std::max(std::thread::hardware_concurrency(), 1U));
+    while (m_workers.size() < nThreads)
+      m_workers.emplace_back(&Impl::runWorker, this);
+
+    m_needKeyPair.notify_all();
+  }
+
+  size_t
+  getReserveSize(const KeyParams& params) const
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_reserves.find(getReserveKey(params));
+    return it == m_reserves.end() ? 0 : it->second.size;
+  }
+
+  /**
+   * @brief Write the key files of a key pair under @p keyName
+   */
+  void
+  storeKeyPair(const Name& keyName, const KeyPair& keyPair)
+  {
+    string keyFileName = maintainMapping(keyName.toUri());
+
+    try
+      {
+        string privateKeyFileName = keyFileName + ".pri";
+        writeKey(privateKeyFileName,
+                 reinterpret_cast<const uint8_t*>(keyPair.privateKey.data()),
+                 keyPair.privateKey.size());
+
+        string publicKeyFileName = keyFileName + ".pub";
+        writeKey(publicKeyFileName,
+                 reinterpret_cast<const uint8_t*>(keyPair.publicKey.data()),
+                 keyPair.publicKey.size());
+
+        /*set file permission*/
+        chmod(privateKeyFileName.c_str(), 0000400);
+        chmod(publicKeyFileName.c_str(), 0000444);
+      }
+    catch (CryptoPP::Exception& e)
+      {
+        throw Error(e.what());
+      }
+  }
+
+  ~Impl()
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_isStopping = true;
+    }
+    m_needKeyPair.notify_all();
+    for (std::thread& worker : m_workers)
+      worker.join();
+  }
+
+private:
+  /// key type and key size
+  typedef std::pair<KeyType, uint32_t> ReserveKey;
+
+  struct Reserve
+  {
+    Reserve()
+      : size(0)
+      , nPending(0)
+    {
+    }
+
+    /// number of key pairs to keep ready
+    size_t size;
+    /// number of key pairs being generated by the workers
+    size_t nPending;
+    std::deque<KeyPair> keyPairs;
+  };
+
+  /// key pair requested by takeKeyPairAsync
+  struct Request
+  {
+    ReserveKey reserveKey;
+    KeyPairCallback onKeyPair;
+    KeyPairErrorCallback onError;
+  };
+
+  static ReserveKey
+  getReserveKey(const KeyParams& params)
+  {
+    if (params.getKeyType() == KEY_TYPE_RSA)
+      return ReserveKey(KEY_TYPE_RSA, static_cast<const RsaKeyParams&>(params).getKeySize());
+
+    if (params.getKeyType() == KEY_TYPE_ED25519)
+      return ReserveKey(KEY_TYPE_ED25519, Ed25519KeyParams().getKeySize());
+
+    uint32_t keySize = static_cast<const EcdsaKeyParams&>(params).getKeySize();
+    return ReserveKey(KEY_TYPE_ECDSA, keySize == 384 ? 384 : 256);
+  }
+
+  static KeyPair
+  generateKeyPair(const ReserveKey& reserveKey)
+  {
+    KeyPair keyPair;
+    try
+      {
+        CryptoBackend::getDefault(reserveKey.first)
+          .generateKeyPair(reserveKey.first, reserveKey.second,
+                           keyPair.privateKey, keyPair.publicKey);
+      }
+    catch (CryptoBackend::Error& e)
+      {
+        throw Error(e.what());
+      }
+
+    return keyPair;
+  }
+
+  /**
+   * @brief Find a reserve that is short of key pairs, or nullptr if there is none
+   */
+  std::pair<const ReserveKey, Reserve>*
+  findShortReserve()
+  {
+    for (auto& entry : m_reserves)
+      if (entry.second.keyPairs.size() + entry.second.nPending < entry.second.size)
+        return &entry;
+    return nullptr;
+  }
+
+  void
+  runWorker()
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (!m_isStopping)
+      {
+        // requests are served first, as their callers are waiting for the key pairs
+        if (!m_requests.empty())
+          {
+            Request request = std::move(m_requests.front());
+            m_requests.pop_front();
+            lock.unlock();
+
+            KeyPair keyPair;
+            try
+              {
+                keyPair = generateKeyPair(request.reserveKey);
+              }
+            catch (const Error& e)
+              {
+                request.onError(e.what());
+                lock.lock();
+                continue;
+              }
+            request.onKeyPair(keyPair);
+
+            lock.lock();
+            continue;
+          }
+
+        std::pair<const ReserveKey, Reserve>* entry = findShortReserve();
+        if (entry == nullptr)
+          {
+            m_needKeyPair.wait(lock);
+            continue;
+          }
+
+        // map entries are never erased, so the entry outlives the unlocked section
+        Reserve& reserve = entry->second;
+        ++reserve.nPending;
+        lock.unlock();
+
+        KeyPair keyPair;
+        bool isGenerated = true;
+        try
+          {
+            keyPair = generateKeyPair(entry->first);
+          }
+        catch (const Error&)
+          {
+            isGenerated = false;
+          }
+
+        lock.lock();
+        --reserve.nPending;
+        if (isGenerated)
+          {
+            // the reserve may have been reduced while the key pair was being generated
+            if (reserve.keyPairs.size() < reserve.size)
+              reserve.keyPairs.push_back(std::move(keyPair));
+          }
+        else
+          reserve.size = 0; // do not retry a key type that cannot be generated
+        m_keyPairReady.notify_all();
+      }
+  }
+
 public:
   boost::filesystem::path m_keystorePath;
+
+private:
+  KeyFormat m_keyFormat;
+
+  mutable std::mutex m_mutex;
+  /// signaled when a reserve may have become short of key pairs, a key pair is requested,
+  /// or on shutdown
+  std::condition_variable m_needKeyPair;
+  /// signaled when a worker has finished generating a key pair
+  std::condition_variable m_keyPairReady;
+  std::map<ReserveKey, Reserve> m_reserves;
+  std::deque<Request> m_requests;
+  std::vector<std::thread> m_workers;
+  bool m_isStopping;
+
+  std::mutex m_symmetricKeysMutex;
+  /// symmetric keys used for signing, so that their files are not read for every packet
+  std::map<Name, ConstBufferPtr> m_symmetricKeys;
 };
 
 
 SecTpmFile::SecTpmFile(const string& location)
-  : SecTpm(location)
-  , m_impl(new Impl(location))
+  : SecTpm(location.substr(0, location.find('?')))
+  , m_impl(new Impl(location.substr(0, location.find('?')), Impl::parseKeyFormat(location)))
   , m_inTerminal(false)
 {
 }
@@ -110,101 +620,81 @@ SecTpmFile::~SecTpmFile()
 void
 SecTpmFile::generateKeyPairInTpm(const Name& keyName, const KeyParams& params)
 {
-  string keyURI = keyName.toUri();
-
   if (doesKeyExistInTpm(keyName, KEY_CLASS_PUBLIC))
     throw Error("public key exists");
   if (doesKeyExistInTpm(keyName, KEY_CLASS_PRIVATE))
     throw Error("private key exists");
 
-  string keyFileName = m_impl->maintainMapping(keyURI);
+  if (!isAsymmetricKeyType(params.getKeyType()))
+    throw Error("Unsupported key type!");
 
-  try
-    {
-      switch (params.getKeyType())
-        {
-        case KEY_TYPE_RSA:
-          {
-            using namespace CryptoPP;
-
-            const RsaKeyParams& rsaParams = static_cast<const RsaKeyParams&>(params);
-            AutoSeededRandomPool rng;
-            InvertibleRSAFunction privateKey;
-            privateKey.Initialize(rng, rsaParams.getKeySize());
-
-            string privateKeyFileName = keyFileName + ".pri";
-            Base64Encoder privateKeySink(new FileSink(privateKeyFileName.c_str()));
-            privateKey.DEREncode(privateKeySink);
-            privateKeySink.MessageEnd();
-
-            RSAFunction publicKey(privateKey);
-            string publicKeyFileName = keyFileName + ".pub";
-            Base64Encoder publicKeySink(new FileSink(publicKeyFileName.c_str()));
-            publicKey.DEREncode(publicKeySink);
-            publicKeySink.MessageEnd();
-
-            /*set file permission*/
-            chmod(privateKeyFileName.c_str(), 0000400);
-            chmod(publicKeyFileName.c_str(), 0000444);
-            return;
-          }
-        case KEY_TYPE_ECDSA:
-          {
-            using namespace CryptoPP;
+  Impl::KeyPair keyPair = m_impl->takeKeyPair(params);
+  m_impl->storeKeyPair(keyName, keyPair);
+}
 
-            const EcdsaKeyParams& ecdsaParams = static_cast<const EcdsaKeyParams&>(params);
+void
+SecTpmFile::generateKeyPairInTpmAsync(const Name& keyName, const KeyParams& params,
+                                      boost::asio::io_service& ioService,
+                                      const KeyPairGeneratedCallback& onGenerated,
+                                      const KeyPairGenerationFailedCallback& onFailed)
+{
+  if (doesKeyExistInTpm(keyName, KEY_CLASS_PUBLIC) ||
+      doesKeyExistInTpm(keyName, KEY_CLASS_PRIVATE))
+    {
+      ioService.post(bind(onFailed, "key exists"));
+      return;
+    }
 
-            CryptoPP::OID curveName;
-            switch (ecdsaParams.getKeySize())
-              {
-              case 256:
-                curveName = ASN1::secp256r1();
-                break;
-              case 384:
-                curveName = ASN1::secp384r1();
-                break;
-              default:
-                curveName = ASN1::secp256r1();
-              }
+  if (!isAsymmetricKeyType(params.getKeyType()))
+    {
+      ioService.post(bind(onFailed, "Unsupported key type!"));
+      return;
+    }
 
-            AutoSeededRandomPool rng;
+  m_impl->takeKeyPairAsync(params,
+    [this, &ioService, keyName, onGenerated, onFailed] (const Impl::KeyPair& keyPair) {
+      ioService.post([this, keyName, keyPair, onGenerated, onFailed] {
+          // the key may have been created since the generation was requested
+          if (doesKeyExistInTpm(keyName, KEY_CLASS_PUBLIC) ||
+              doesKeyExistInTpm(keyName, KEY_CLASS_PRIVATE))
+            {
+              onFailed("key exists");
+              return;
+            }
 
-            ECDSA<ECP, SHA256>::PrivateKey privateKey;
-            DL_GroupParameters_EC<ECP> cryptoParams(curveName);
-            cryptoParams.SetEncodeAsOID(true);
-            privateKey.Initialize(rng, cryptoParams);
+          try
+            {
+              m_impl->storeKeyPair(keyName, keyPair);
+            }
+          catch (const Error& e)
+            {
+              onFailed(e.what());
+              return;
+            }
+          onGenerated();
+        });
+    },
+    [&ioService, onFailed] (const std::string& reason) {
+      ioService.post(bind(onFailed, reason));
+    });
+}
 
-            ECDSA<ECP, SHA256>::PublicKey publicKey;
-            privateKey.MakePublicKey(publicKey);
-            publicKey.AccessGroupParameters().SetEncodeAsOID(true);
+void
+SecTpmFile::reserveKeyPairs(const KeyParams& params, size_t nKeyPairs)
+{
+  if (!isAsymmetricKeyType(params.getKeyType()))
+    throw Error("Unsupported key type!");
 
-            string privateKeyFileName = keyFileName + ".pri";
-            Base64Encoder privateKeySink(new FileSink(privateKeyFileName.c_str()));
-            privateKey.DEREncode(privateKeySink);
-            privateKeySink.MessageEnd();
+  m_impl->reserveKeyPairs(params, nKeyPairs);
+}
 
-            string publicKeyFileName = keyFileName + ".pub";
-            Base64Encoder publicKeySink(new FileSink(publicKeyFileName.c_str()));
-            publicKey.Save(publicKeySink);
-            publicKeySink.MessageEnd();
+size_t
+SecTpmFile::getKeyPairReserve(const KeyParams& params) const
+{
+  if (!isAsymmetricKeyType(params.getKeyType()))
+    return 0;
 
-            /*set file permission*/
-            chmod(privateKeyFileName.c_str(), 0000400);
-            chmod(publicKeyFileName.c_str(), 0000444);
-            return;
-          }
-        default:
-          throw Error("Unsupported key type!");
-        }
-    }
-  catch (KeyParams::Error& e)
-    {
-      throw Error(e.what());
-    }
-  catch (CryptoPP::Exception& e)
-    {
-      throw Error(e.what());
-    }
+  return m_impl->getReserveSize(params);
 }
 
 void
@@ -212,12 +702,18 @@ SecTpmFile::deleteKeyPairInTpm(const Name& keyName)
 {
   boost::filesystem::path publicKeyPath(m_impl->transformName(keyName.toUri(), ".pub"));
   boost::filesystem::path privateKeyPath(m_impl->transformName(keyName.toUri(), ".pri"));
+  boost::filesystem::path symmetricKeyPath(m_impl->transformName(keyName.toUri(), ".key"));
 
   if (boost::filesystem::exists(publicKeyPath))
     boost::filesystem::remove(publicKeyPath);
 
   if (boost::filesystem::exists(privateKeyPath))
     boost::filesystem::remove(privateKeyPath);
+
+  if (boost::filesystem::exists(symmetricKeyPath))
+    boost::filesystem::remove(symmetricKeyPath);
+
+  m_impl->forgetSymmetricKey(keyName);
 }
 
 shared_ptr<PublicKey>
@@ -228,21 +724,15 @@ SecTpmFile::getPublicKeyFromTpm(const Name&  keyName)
   if (!doesKeyExistInTpm(keyName, KEY_CLASS_PUBLIC))
     throw Error("Public Key does not exist");
 
-  ostringstream os;
   try
     {
-      using namespace CryptoPP;
-      FileSource(m_impl->transformName(keyURI, ".pub").string().c_str(),
-                 true,
-                 new Base64Decoder(new FileSink(os)));
+      Impl::KeyFile key(m_impl->transformName(keyURI, ".pub"));
+      return make_shared<PublicKey>(key.data(), key.size());
     }
   catch (CryptoPP::Exception& e)
     {
       throw Error(e.what());
     }
-
-  return make_shared<PublicKey>(reinterpret_cast<const uint8_t*>(os.str().c_str()),
-                                os.str().size());
 }
 
 std::string
@@ -254,11 +744,8 @@ SecTpmFile::getScheme()
 ConstBufferPtr
 SecTpmFile::exportPrivateKeyPkcs8FromTpm(const Name& keyName)
 {
-  OBufferStream privateKeyOs;
-  CryptoPP::FileSource(m_impl->transformName(keyName.toUri(), ".pri").string().c_str(), true,
-                       new CryptoPP::Base64Decoder(new CryptoPP::FileSink(privateKeyOs)));
-
-  return privateKeyOs.buf();
+  Impl::KeyFile key(m_impl->transformName(keyName.toUri(), ".pri"));
+  return make_shared<Buffer>(key.data(), key.size());
 }
 
 bool
@@ -266,13 +753,9 @@ SecTpmFile::importPrivateKeyPkcs8IntoTpm(const Name& keyName, const uint8_t* buf
 {
   try
     {
-      using namespace CryptoPP;
-
       string keyFileName = m_impl->maintainMapping(keyName.toUri());
       keyFileName.append(".pri");
-      StringSource(buf, size,
-                   true,
-                   new Base64Encoder(new FileSink(keyFileName.c_str())));
+      m_impl->writeKey(keyFileName, buf, size);
       return true;
     }
   catch (CryptoPP::Exception& e)
@@ -286,13 +769,9 @@ SecTpmFile::importPublicKeyPkcs1IntoTpm(const Name& keyName, const uint8_t* buf,
 {
   try
     {
-      using namespace CryptoPP;
-
       string keyFileName = m_impl->maintainMapping(keyName.toUri());
       keyFileName.append(".pub");
-      StringSource(buf, size,
-                   true,
-                   new Base64Encoder(new FileSink(keyFileName.c_str())));
+      m_impl->writeKey(keyFileName, buf, size);
       return true;
     }
   catch (CryptoPP::Exception& e)
@@ -310,93 +789,57 @@ SecTpmFile::signInTpm(const uint8_t* data, size_t dataLength,
   if (!doesKeyExistInTpm(keyName, KEY_CLASS_PRIVATE))
     throw Error("private key doesn't exists");
 
+  if (digestAlgorithm != DIGEST_ALGORITHM_SHA256)
+    throw Error("Unsupported digest algorithm!");
+
   try
     {
-      using namespace CryptoPP;
-      AutoSeededRandomPool rng;
-
       //Read public key
       shared_ptr<PublicKey> pubkeyPtr;
       pubkeyPtr = getPublicKeyFromTpm(keyName);
 
-      switch (pubkeyPtr->getKeyType())
-        {
-          case KEY_TYPE_RSA:
-            {
-              //Read private key
-              ByteQueue bytes;
-              FileSource file(m_impl->transformName(keyURI, ".pri").string().c_str(),
-                              true, new Base64Decoder);
-              file.TransferTo(bytes);
-              bytes.MessageEnd();
-              RSA::PrivateKey privateKey;
-              privateKey.Load(bytes);
-
-              //Sign message
-              switch (digestAlgorithm)
-                {
-                case DIGEST_ALGORITHM_SHA256:
-                  {
-                    RSASS<PKCS1v15, SHA256>::Signer signer(privateKey);
-
-                    OBufferStream os;
-                    StringSource(data, dataLength,
-                                 true,
-                                 new SignerFilter(rng, signer, new FileSink(os)));
-
-                    return Block(tlv::SignatureValue, os.buf());
-                  }
-                default:
-                  throw Error("Unsupported digest algorithm!");
-                }
-            }
-        case KEY_TYPE_ECDSA:
-          {
-            //Read private key
-            ByteQueue bytes;
-            FileSource file(m_impl->transformName(keyURI, ".pri").string().c_str(),
-                            true, new Base64Decoder);
-            file.TransferTo(bytes);
-            bytes.MessageEnd();
-
-            //Sign message
-            switch (digestAlgorithm)
-              {
-              case DIGEST_ALGORITHM_SHA256:
-                {
-                  ECDSA<ECP, SHA256>::PrivateKey privateKey;
-                  privateKey.Load(bytes);
-                  ECDSA<ECP, SHA256>::Signer signer(privateKey);
-
-                  OBufferStream os;
-                  StringSource(data, dataLength,
-                               true,
-                               new SignerFilter(rng, signer, new FileSink(os)));
-
-                  uint8_t buf[200];
-                  size_t bufSize = DSAConvertSignatureFormat(buf, 200, DSA_DER,
-                                                             os.buf()->buf(), os.buf()->size(),
-                                                             DSA_P1363);
-
-                  shared_ptr<Buffer> sigBuffer = make_shared<Buffer>(buf, bufSize);
-
-                  return Block(tlv::SignatureValue, sigBuffer);
-                }
-              default:
-                throw Error("Unsupported digest algorithm!");
-              }
-          }
-        default:
-          throw Error("Unsupported key type!");
-        }
+      KeyType keyType = pubkeyPtr->getKeyType();
+      if (!isAsymmetricKeyType(keyType))
+        throw Error("Unsupported key type!");
+
+      //Read private key
+      Impl::KeyFile privateKey(m_impl->transformName(keyURI, ".pri"));
+
+      //Sign message
+      const CryptoBackend& backend = CryptoBackend::getDefault(keyType);
+      return Block(tlv::SignatureValue,
+                   backend.sign(keyType, privateKey.data(), privateKey.size(),
+                                data, dataLength, digestAlgorithm));
     }
   catch (CryptoPP::Exception& e)
     {
       throw Error(e.what());
     }
+  catch (CryptoBackend::Error& e)
+    {
+      throw Error(e.what());
+    }
 }
 
 
+bool
+SecTpmFile::isConcurrentSigningSupported() const
+{
+  for (KeyType keyType : {KEY_TYPE_RSA, KEY_TYPE_ECDSA, KEY_TYPE_ED25519})
+    {
+      try
+        {
+          if (!CryptoBackend::getDefault(keyType).isThreadSafe())
+            return false;
+        }
+      catch (const CryptoBackend::Error&)
+        {
+          // keys of this type cannot be used at all
+        }
+    }
+  return true;
+}
+
 ConstBufferPtr
 SecTpmFile::decryptInTpm(const uint8_t* data, size_t dataLength,
                          const Name& keyName, bool isSymmetric)
@@ -525,36 +968,94 @@ SecTpmFile::encryptInTpm(const uint8_t* data, size_t dataLength,
 void
 SecTpmFile::generateSymmetricKeyInTpm(const Name& keyName, const KeyParams& params)
 {
-  throw Error("SecTpmFile::generateSymmetricKeyInTpm is not supported!");
-  // string keyURI = keyName.toUri();
+  if (doesKeyExistInTpm(keyName, KEY_CLASS_SYMMETRIC))
+    throw Error("symmetric key exists");
 
-  // if (doesKeyExistInTpm(keyName, KEY_CLASS_SYMMETRIC))
-  //   throw Error("symmetric key exists");
+  uint32_t keySize = 0;
+  switch (params.getKeyType())
+    {
+    case KEY_TYPE_AES:
+      keySize = static_cast<const AesKeyParams&>(params).getKeySize();
+      break;
+    case KEY_TYPE_HMAC:
+      keySize = static_cast<const HmacKeyParams&>(params).getKeySize();
+      break;
+    default:
+      throw Error("Unsupported symmetric key type!");
+    }
 
-  // string keyFileName = m_impl->maintainMapping(keyURI);
-  // string symKeyFileName = keyFileName + ".key";
+  Buffer key(keySize / 8);
+  if (!generateRandomBlock(key.buf(), key.size()))
+    throw Error("Cannot generate symmetric key");
 
-  // try{
-  //   switch (keyType){
-  //   case KEY_TYPE_AES:
-  //     {
-  //       using namespace CryptoPP;
-  //       AutoSeededRandomPool rng;
+  if (!importSymmetricKeyIntoTpm(keyName, key.buf(), key.size()))
+    throw Error("Cannot write symmetric key");
+}
 
-  //       SecByteBlock key(0x00, keySize);
-  //       rng.GenerateBlock(key, keySize);
+Block
+SecTpmFile::signWithHmacInTpm(const uint8_t* data, size_t dataLength,
+                              const Name& keyName, DigestAlgorithm digestAlgorithm)
+{
+  if (digestAlgorithm != DIGEST_ALGORITHM_SHA256)
+    throw Error("Unsupported digest algorithm!");
 
-  //       StringSource(key, key.size(), true, new HexEncoder(new FileSink(symKeyFileName.c_str())));
+  ConstBufferPtr key = m_impl->findSymmetricKey(keyName);
+  if (key == nullptr)
+    {
+      key = exportSymmetricKeyFromTpm(keyName);
+      m_impl->cacheSymmetricKey(keyName, key);
+    }
 
-  //       chmod(symKeyFileName.c_str(), 0000400);
-  //       return;
-  //     }
-  //   default:
-  //     throw Error("Unsupported symmetric key type!");
-  //   }
-  // }catch (CryptoPP::Exception& e){
-  //   throw Error(e.what());
-  // }
+  uint8_t hmac[crypto::SHA256_DIGEST_SIZE];
+  try
+    {
+      crypto::hmacSha256(key->buf(), key->size(), data, dataLength, hmac);
+    }
+  catch (crypto::Error& e)
+    {
+      throw Error(e.what());
+    }
+
+  return dataBlock(tlv::SignatureValue, hmac, sizeof(hmac));
+}
+
+ConstBufferPtr
+SecTpmFile::exportSymmetricKeyFromTpm(const Name& keyName)
+{
+  if (!doesKeyExistInTpm(keyName, KEY_CLASS_SYMMETRIC))
+    throw Error("symmetric key doesn't exist");
+
+  OBufferStream keyOs;
+  try
+    {
+      CryptoPP::FileSink sink(keyOs);
+      m_impl->readSymmetricKey(m_impl->transformName(keyName.toUri(), ".key"), sink);
+    }
+  catch (CryptoPP::Exception& e)
+    {
+      throw Error(e.what());
+    }
+
+  return keyOs.buf();
+}
+
+bool
+SecTpmFile::importSymmetricKeyIntoTpm(const Name& keyName, const uint8_t* buf, size_t size)
+{
+  try
+    {
+      string keyFileName = m_impl->maintainMapping(keyName.toUri());
+      keyFileName.append(".key");
+      m_impl->writeSymmetricKey(keyFileName, buf, size);
+      m_impl->forgetSymmetricKey(keyName);
+
+      chmod(keyFileName.c_str(), 0000400);
+      return true;
+    }
+  catch (CryptoPP::Exception& e)
+    {
+      return false;
+    }
 }
 
 bool
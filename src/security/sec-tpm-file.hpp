@@ -88,6 +88,30 @@ public:
   virtual void
   generateKeyPairInTpm(const Name& keyName, const KeyParams& params);
 
+  /**
+   * @brief Keep key pairs with @p params generated by a pool of background threads
+   *
+   * The key pairs are held in memory only and are written to the key store when
+   * generateKeyPairInTpm() assigns them a key name.
+   */
+  virtual void
+  reserveKeyPairs(const KeyParams& params, size_t nKeyPairs);
+
+  virtual size_t
+  getKeyPairReserve(const KeyParams& params) const;
+
+  /**
+   * @brief Generate a pair of asymmetric keys on the background threads
+   *
+   * A key pair kept in advance by reserveKeyPairs() is used if there is one.  The key files
+   * are written by the @p ioService thread.
+   */
+  virtual void
+  generateKeyPairInTpmAsync(const Name& keyName, const KeyParams& params,
+                            boost::asio::io_service& ioService,
+                            const KeyPairGeneratedCallback& onGenerated,
+                            const KeyPairGenerationFailedCallback& onFailed);
+
   virtual void
   deleteKeyPairInTpm(const Name& keyName);
 
@@ -98,15 +122,40 @@ public:
   signInTpm(const uint8_t* data, size_t dataLength,
             const Name& keyName, DigestAlgorithm digestAlgorithm);
 
+  /**
+   * @brief signInTpm() keeps no state of its own, so it may be invoked concurrently if the
+   *        crypto backends are thread-safe
+   */
+  virtual bool
+  isConcurrentSigningSupported() const;
+
   virtual ConstBufferPtr
   decryptInTpm(const uint8_t* data, size_t dataLength, const Name& keyName, bool isSymmetric);
 
   virtual ConstBufferPtr
   encryptInTpm(const uint8_t* data, size_t dataLength, const Name& keyName, bool isSymmetric);
 
+  /**
+   * @brief Generate an AES or HMAC key, which is stored base64-encoded in the key store
+   */
   virtual void
   generateSymmetricKeyInTpm(const Name& keyName, const KeyParams& params);
 
+  /**
+   * @brief Sign with an HMAC key, whose file is read only on its first use
+   *
+   * The key stays cached until it is deleted or replaced through this TPM.
+   */
+  virtual Block
+  signWithHmacInTpm(const uint8_t* data, size_t dataLength,
+                    const Name& keyName, DigestAlgorithm digestAlgorithm);
+
+  virtual ConstBufferPtr
+  exportSymmetricKeyFromTpm(const Name& keyName);
+
+  virtual bool
+  importSymmetricKeyIntoTpm(const Name& keyName, const uint8_t* buf, size_t size);
+
   virtual bool
   doesKeyExistInTpm(const Name& keyName, KeyClass keyClass);
 
@@ -22,12 +22,15 @@
  */
 
 #include "sec-tpm.hpp"
+#include "crypto-backend.hpp"
 
 #include "../encoding/oid.hpp"
 #include "../encoding/buffer-stream.hpp"
 #include "cryptopp.hpp"
 #include <unistd.h>
 
+#include <boost/asio/io_service.hpp>
+
 namespace ndn {
 
 using std::string;
@@ -41,12 +44,50 @@ SecTpm::~SecTpm()
 {
 }
 
+void
+SecTpm::generateKeyPairInTpmAsync(const Name& keyName, const KeyParams& params,
+                                  boost::asio::io_service& ioService,
+                                  const KeyPairGeneratedCallback& onGenerated,
+                                  const KeyPairGenerationFailedCallback& onFailed)
+{
+  try
+    {
+      generateKeyPairInTpm(keyName, params);
+    }
+  catch (const Error& e)
+    {
+      ioService.post(bind(onFailed, std::string(e.what())));
+      return;
+    }
+
+  ioService.post(onGenerated);
+}
+
 std::string
 SecTpm::getTpmLocator()
 {
   return this->getScheme() + ":" + m_location;
 }
 
+Block
+SecTpm::signWithHmacInTpm(const uint8_t* data, size_t dataLength,
+                          const Name& keyName, DigestAlgorithm digestAlgorithm)
+{
+  throw Error("HMAC signing is not supported by this TPM");
+}
+
+ConstBufferPtr
+SecTpm::exportSymmetricKeyFromTpm(const Name& keyName)
+{
+  throw Error("Symmetric key export is not supported by this TPM");
+}
+
+bool
+SecTpm::importSymmetricKeyIntoTpm(const Name& keyName, const uint8_t* buf, size_t size)
+{
+  return false;
+}
+
 ConstBufferPtr
 SecTpm::exportPrivateKeyPkcs5FromTpm(const Name& keyName, const string& passwordStr)
 {
@@ -308,6 +349,8 @@ SecTpm::importPrivateKeyPkcs5IntoTpm(const Name& keyName,
         publicKeyType = KEY_TYPE_RSA;
       else if (keyTypeOID == oid::ECDSA)
         publicKeyType = KEY_TYPE_ECDSA;
+      else if (keyTypeOID == oid::ED25519)
+        publicKeyType = KEY_TYPE_ED25519;
       else
         return false; // Unsupported key type;
     }
@@ -315,44 +358,17 @@ SecTpm::importPrivateKeyPkcs5IntoTpm(const Name& keyName,
 
 
   //derive public key
-  OBufferStream publicKeyOs;
-
+  ConstBufferPtr publicKey;
   try {
-    switch (publicKeyType) {
-    case KEY_TYPE_RSA:
-      {
-        RSA::PrivateKey privateKey;
-        privateKey.Load(StringStore(privateKeyOs.buf()->buf(), privateKeyOs.buf()->size()).Ref());
-        RSAFunction publicKey(privateKey);
-
-        FileSink publicKeySink(publicKeyOs);
-        publicKey.DEREncode(publicKeySink);
-        publicKeySink.MessageEnd();
-        break;
-      }
-    case KEY_TYPE_ECDSA:
-      {
-        ECDSA<ECP, SHA256>::PrivateKey privateKey;
-        privateKey.Load(StringStore(privateKeyOs.buf()->buf(), privateKeyOs.buf()->size()).Ref());
-
-        ECDSA<ECP, SHA256>::PublicKey publicKey;
-        privateKey.MakePublicKey(publicKey);
-        publicKey.AccessGroupParameters().SetEncodeAsOID(true);
-
-        FileSink publicKeySink(publicKeyOs);
-        publicKey.DEREncode(publicKeySink);
-        publicKeySink.MessageEnd();
-        break;
-      }
-    default:
-      return false;
-    }
+    const CryptoBackend& backend = CryptoBackend::getDefault(publicKeyType);
+    publicKey = backend.derivePublicKey(publicKeyType,
+                                        privateKeyOs.buf()->buf(), privateKeyOs.buf()->size());
   }
-  catch (CryptoPP::Exception& e) {
-      return false;
+  catch (CryptoBackend::Error& e) {
+    return false;
   }
 
-  if (!importPublicKeyPkcs1IntoTpm(keyName, publicKeyOs.buf()->buf(), publicKeyOs.buf()->size()))
+  if (!importPublicKeyPkcs1IntoTpm(keyName, publicKey->buf(), publicKey->size()))
     return false;
 
   return true;
@@ -31,6 +31,12 @@
 #include "public-key.hpp"
 #include "key-params.hpp"
 
+namespace boost {
+namespace asio {
+class io_service;
+}
+}
+
 namespace ndn {
 
 /**
@@ -121,6 +127,50 @@ public:
   virtual void
   generateKeyPairInTpm(const Name& keyName, const KeyParams& params) = 0;
 
+  /**
+   * @brief Keep key pairs with @p params generated in advance
+   *
+   * Asks the TPM to keep up to @p nKeyPairs key pairs with @p params generated in the
+   * background, so that generateKeyPairInTpm() with the same parameters does not need to wait
+   * for the key generation.  Setting @p nKeyPairs to 0 stops the pre-generation.
+   * The default implementation does nothing.
+   *
+   * @throws SecTpm::Error if the key type is not supported.
+   */
+  virtual void
+  reserveKeyPairs(const KeyParams& params, size_t nKeyPairs)
+  {
+  }
+
+  /**
+   * @brief Get the number of key pairs with @p params kept generated in advance
+   * @sa reserveKeyPairs
+   */
+  virtual size_t
+  getKeyPairReserve(const KeyParams& params) const
+  {
+    return 0;
+  }
+
+  typedef function<void()> KeyPairGeneratedCallback;
+  typedef function<void(const std::string& reason)> KeyPairGenerationFailedCallback;
+
+  /**
+   * @brief Generate a pair of asymmetric keys without waiting for the key generation
+   *
+   * Once the key pair is stored under @p keyName, @p onGenerated is dispatched to
+   * @p ioService.  If the key pair cannot be generated, @p onFailed is dispatched instead.
+   * The TPM must outlive the key generation; callbacks of a key generation still in progress
+   * when the TPM is destroyed are not invoked.
+   *
+   * The default implementation generates the key pair on the calling thread.
+   */
+  virtual void
+  generateKeyPairInTpmAsync(const Name& keyName, const KeyParams& params,
+                            boost::asio::io_service& ioService,
+                            const KeyPairGeneratedCallback& onGenerated,
+                            const KeyPairGenerationFailedCallback& onFailed);
+
   /**
    * @brief Delete a key pair of asymmetric keys.
    *
@@ -154,6 +204,17 @@ public:
             const Name& keyName,
             DigestAlgorithm digestAlgorithm) = 0;
 
+  /**
+   * @brief Check if signInTpm() may be invoked concurrently from multiple threads
+   *
+   * The default implementation returns false.
+   */
+  virtual bool
+  isConcurrentSigningSupported() const
+  {
+    return false;
+  }
+
   /**
    * @brief Decrypt data.
    *
@@ -190,6 +251,48 @@ public:
   virtual void
   generateSymmetricKeyInTpm(const Name& keyName, const KeyParams& params) = 0;
 
+  /**
+   * @brief Compute the HMAC of data with a symmetric key.
+   *
+   * The default implementation throws SecTpm::Error.
+   *
+   * @param data Pointer to the byte array to be signed.
+   * @param dataLength The length of data.
+   * @param keyName The name of the symmetric key.
+   * @param digestAlgorithm the digest algorithm of the HMAC.
+   * @return The signature block.
+   * @throws SecTpm::Error if the key does not exist or signing fails.
+   */
+  virtual Block
+  signWithHmacInTpm(const uint8_t* data, size_t dataLength,
+                    const Name& keyName,
+                    DigestAlgorithm digestAlgorithm);
+
+  /**
+   * @brief Export a symmetric key, so that it can be given to the validators sharing it.
+   *
+   * The default implementation throws SecTpm::Error.
+   *
+   * @param keyName The name of the symmetric key.
+   * @return The raw key bits.
+   * @throws SecTpm::Error if the key does not exist or cannot be exported.
+   */
+  virtual ConstBufferPtr
+  exportSymmetricKeyFromTpm(const Name& keyName);
+
+  /**
+   * @brief Import a symmetric key.
+   *
+   * The default implementation returns false.
+   *
+   * @param keyName The name of the symmetric key.
+   * @param buf The raw key bits.
+   * @param size The size of the key.
+   * @return False if import fails.
+   */
+  virtual bool
+  importSymmetricKeyIntoTpm(const Name& keyName, const uint8_t* buf, size_t size);
+
   /**
    * @brief Check if a particular key exists.
    *
@@ -40,8 +40,10 @@ enum {
 enum KeyType {
   KEY_TYPE_RSA   = 0,
   KEY_TYPE_ECDSA = 1,
+  KEY_TYPE_ED25519 = 2,
   // KEY_TYPE_DSA,
   KEY_TYPE_AES   = 128,
+  KEY_TYPE_HMAC  = 129,
   // KEY_TYPE_DES,
   // KEY_TYPE_RC4,
   // KEY_TYPE_RC2
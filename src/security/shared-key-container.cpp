@@ -0,0 +1,67 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "shared-key-container.hpp"
+#include "../encoding/buffer-stream.hpp"
+#include "cryptopp.hpp"
+
+namespace ndn {
+namespace security {
+
+void
+SharedKeyContainer::insert(const Name& prefix, const Name& keyName, ConstBufferPtr key)
+{
+  if (key == nullptr || key->empty())
+    throw Error("Shared key " + keyName.toUri() + " is empty");
+
+  Entry& entry = m_keys[keyName];
+  entry.prefix = prefix;
+  entry.key = key;
+}
+
+void
+SharedKeyContainer::insert(const Name& prefix, const Name& keyName, const std::string& base64Key)
+{
+  using namespace CryptoPP;
+
+  OBufferStream os;
+  try {
+    StringSource(base64Key, true, new Base64Decoder(new FileSink(os)));
+  }
+  catch (const CryptoPP::Exception& e) {
+    throw Error("Cannot decode shared key " + keyName.toUri() + ": " + e.what());
+  }
+
+  insert(prefix, keyName, os.buf());
+}
+
+ConstBufferPtr
+SharedKeyContainer::find(const Name& keyName, const Name& packetName) const
+{
+  std::unordered_map<Name, Entry>::const_iterator it = m_keys.find(keyName);
+  if (it == m_keys.end() || !it->second.prefix.isPrefixOf(packetName))
+    return ConstBufferPtr();
+
+  return it->second.key;
+}
+
+} // namespace security
+} // namespace ndn
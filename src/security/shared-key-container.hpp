@@ -0,0 +1,112 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_SECURITY_SHARED_KEY_CONTAINER_HPP
+#define NDN_SECURITY_SHARED_KEY_CONTAINER_HPP
+
+#include "../common.hpp"
+#include "../name.hpp"
+#include "../encoding/buffer.hpp"
+
+#include <unordered_map>
+
+namespace ndn {
+namespace security {
+
+/**
+ * @brief Symmetric keys shared with the signers of HMAC signatures
+ *
+ * Each key is known by the name carried in the KeyLocator of the signatures, and may only
+ * be used to verify packets under the name prefix it has been given for.
+ */
+class SharedKeyContainer
+{
+public:
+  class Error : public std::runtime_error
+  {
+  public:
+    explicit
+    Error(const std::string& what)
+      : std::runtime_error(what)
+    {
+    }
+  };
+
+  /**
+   * @brief Add a shared key, replacing any key with the same name
+   *
+   * @param prefix name prefix of the packets the key may sign
+   * @param keyName name of the key in the KeyLocator of the signatures
+   * @param key raw key bits
+   * @throw Error the key is empty
+   */
+  void
+  insert(const Name& prefix, const Name& keyName, ConstBufferPtr key);
+
+  /**
+   * @brief Add a shared key given as a base64 string
+   * @throw Error the key cannot be decoded or is empty
+   */
+  void
+  insert(const Name& prefix, const Name& keyName, const std::string& base64Key);
+
+  /**
+   * @brief Find the key that can verify the signature of a packet
+   *
+   * @param keyName name of the key in the KeyLocator of the signature
+   * @param packetName name of the signed packet
+   * @return the key, or nullptr if the key is unknown or @p packetName is not under its prefix
+   */
+  ConstBufferPtr
+  find(const Name& keyName, const Name& packetName) const;
+
+  void
+  clear()
+  {
+    m_keys.clear();
+  }
+
+  bool
+  empty() const
+  {
+    return m_keys.empty();
+  }
+
+  size_t
+  size() const
+  {
+    return m_keys.size();
+  }
+
+private:
+  struct Entry
+  {
+    Name prefix;
+    ConstBufferPtr key;
+  };
+
+  std::unordered_map<Name, Entry> m_keys;
+};
+
+} // namespace security
+} // namespace ndn
+
+#endif // NDN_SECURITY_SHARED_KEY_CONTAINER_HPP
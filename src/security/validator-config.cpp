@@ -23,6 +23,7 @@
 
 #include "validator-config.hpp"
 #include "certificate-cache-ttl.hpp"
+#include "shared-key-container.hpp"
 #include "../util/io.hpp"
 
 #include <boost/filesystem.hpp>
@@ -47,8 +48,7 @@ ValidatorConfig::ValidatorConfig(Face* face,
   , m_certificateCache(certificateCache)
   , m_graceInterval(graceInterval < time::milliseconds::zero() ?
                     DEFAULT_GRACE_INTERVAL : graceInterval)
-  , m_maxTrackedKeys(maxTrackedKeys)
-  , m_keyTimestampTtl(keyTimestampTtl)
+  , m_keyTimestamps(maxTrackedKeys, keyTimestampTtl)
 {
   if (!static_cast<bool>(m_certificateCache) && face != nullptr)
     m_certificateCache = make_shared<CertificateCacheTtl>(ref(face->getIoService()));
@@ -66,8 +66,7 @@ ValidatorConfig::ValidatorConfig(Face& face,
   , m_certificateCache(certificateCache)
   , m_graceInterval(graceInterval < time::milliseconds::zero() ?
                     DEFAULT_GRACE_INTERVAL : graceInterval)
-  , m_maxTrackedKeys(maxTrackedKeys)
-  , m_keyTimestampTtl(keyTimestampTtl)
+  , m_keyTimestamps(maxTrackedKeys, keyTimestampTtl)
 {
   if (!static_cast<bool>(m_certificateCache))
     m_certificateCache = make_shared<CertificateCacheTtl>(ref(face.getIoService()));
@@ -147,6 +146,10 @@ ValidatorConfig::load(const security::conf::ConfigSection& configSection,
         {
           onConfigTrustAnchor(section, filename);
         }
+      else if (boost::iequals(sectionName, "shared-key"))
+        {
+          onConfigSharedKey(section, filename);
+        }
       else
         {
           std::string msg = "Error processing configuration file";
@@ -277,7 +280,7 @@ ValidatorConfig::onConfigTrustAnchor(const security::conf::ConfigSection& config
       shared_ptr<IdentityCertificate> idCert =
         io::load<IdentityCertificate>(certfilePath.string());
 
-      if (static_cast<bool>(idCert))
+      if (idCert != nullptr && idCert->isContentDecodable())
         {
           BOOST_ASSERT(idCert->getName().size() >= 1);
           m_staticContainer.add(idCert);
@@ -304,7 +307,7 @@ ValidatorConfig::onConfigTrustAnchor(const security::conf::ConfigSection& config
 
       shared_ptr<IdentityCertificate> idCert = io::load<IdentityCertificate>(ss);
 
-      if (static_cast<bool>(idCert))
+      if (idCert != nullptr && idCert->isContentDecodable())
         {
           BOOST_ASSERT(idCert->getName().size() >= 1);
           m_staticContainer.add(idCert);
@@ -359,7 +362,7 @@ ValidatorConfig::onConfigTrustAnchor(const security::conf::ConfigSection& config
               shared_ptr<IdentityCertificate> idCert =
                 io::load<IdentityCertificate>(it->path().string());
 
-              if (static_cast<bool>(idCert))
+              if (idCert != nullptr && idCert->isContentDecodable())
                 m_staticContainer.add(idCert);
             }
 
@@ -374,6 +377,93 @@ ValidatorConfig::onConfigTrustAnchor(const security::conf::ConfigSection& config
     throw Error("Unsupported trust-anchor.type: " + type);
 }
 
+void
+ValidatorConfig::onConfigSharedKey(const security::conf::ConfigSection& configSection,
+                                   const std::string& filename)
+{
+  using namespace ndn::security::conf;
+  using namespace boost::filesystem;
+
+  ConfigSection::const_iterator propertyIt = configSection.begin();
+
+  // Get shared-key.prefix
+  if (propertyIt == configSection.end() || !boost::iequals(propertyIt->first, "prefix"))
+    throw Error("Expect <shared-key.prefix>!");
+
+  Name prefix(propertyIt->second.data());
+  propertyIt++;
+
+  // Get shared-key.key-name
+  if (propertyIt == configSection.end() || !boost::iequals(propertyIt->first, "key-name"))
+    throw Error("Expect <shared-key.key-name>!");
+
+  Name keyName(propertyIt->second.data());
+  propertyIt++;
+
+  // Get shared-key.type
+  if (propertyIt == configSection.end() || !boost::iequals(propertyIt->first, "type"))
+    throw Error("Expect <shared-key.type>!");
+
+  std::string type = propertyIt->second.data();
+  propertyIt++;
+
+  std::string base64Key;
+  if (boost::iequals(type, "file"))
+    {
+      // Get shared-key.file-name
+      if (propertyIt == configSection.end() || !boost::iequals(propertyIt->first, "file-name"))
+        throw Error("Expect <shared-key.file-name>!");
+
+      path keyFilePath = absolute(propertyIt->second.data(), path(filename).parent_path());
+      propertyIt++;
+
+      std::ifstream keyFile(keyFilePath.c_str());
+      if (!keyFile.good())
+        throw Error("Cannot read shared key from file: " + keyFilePath.native());
+
+      std::stringstream ss;
+      ss << keyFile.rdbuf();
+      base64Key = ss.str();
+    }
+  else if (boost::iequals(type, "base64"))
+    {
+      // Get shared-key.base64-string
+      if (propertyIt == configSection.end() || !boost::iequals(propertyIt->first, "base64-string"))
+        throw Error("Expect <shared-key.base64-string>!");
+
+      base64Key = propertyIt->second.data();
+      propertyIt++;
+    }
+  else
+    throw Error("Unsupported shared-key.type: " + type + "!");
+
+  // Check other stuff
+  if (propertyIt != configSection.end())
+    throw Error("Expect the end of shared-key!");
+
+  try
+    {
+      m_sharedKeys.insert(prefix, keyName, base64Key);
+    }
+  catch (security::SharedKeyContainer::Error& e)
+    {
+      throw Error(e.what());
+    }
+}
+
+void
+ValidatorConfig::addSharedKey(const Name& prefix, const Name& keyName, ConstBufferPtr key)
+{
+  try
+    {
+      m_sharedKeys.insert(prefix, keyName, key);
+    }
+  catch (security::SharedKeyContainer::Error& e)
+    {
+      throw Error(e.what());
+    }
+}
+
 void
 ValidatorConfig::reset()
 {
@@ -387,6 +477,8 @@ ValidatorConfig::reset()
   m_staticContainer = TrustAnchorContainer();
 
   m_dynamicContainers.clear();
+
+  m_sharedKeys.clear();
 }
 
 bool
@@ -395,7 +487,8 @@ ValidatorConfig::isEmpty()
   if ((!static_cast<bool>(m_certificateCache) || m_certificateCache->isEmpty()) &&
       m_interestRules.empty() &&
       m_dataRules.empty() &&
-      m_anchors.empty())
+      m_anchors.empty() &&
+      m_sharedKeys.empty())
     return true;
   return false;
 }
@@ -551,7 +644,10 @@ ValidatorConfig::checkPolicy(const Interest& interest,
         return onValidationFailed(interest.shared_from_this(),
                                   "Key Locator is not a name");
 
-      Name keyName = IdentityCertificate::certificateNameToPublicKeyName(keyLocator.getName());
+      // HMAC signatures name the shared key itself rather than a certificate
+      Name keyName = signature.getType() == tlv::SignatureHmacWithSha256 ?
+                     keyLocator.getName() :
+                     IdentityCertificate::certificateNameToPublicKeyName(keyLocator.getName());
 
       bool isMatched = false;
       int8_t checkResult = -1;
@@ -629,8 +725,8 @@ ValidatorConfig::checkTimestamp(const shared_ptr<const Interest>& interest,
 
   time::system_clock::TimePoint currentTime = time::system_clock::now();
 
-  LastTimestampMap::iterator timestampIt = m_lastTimestamp.find(keyName);
-  if (timestampIt == m_lastTimestamp.end())
+  time::system_clock::TimePoint lastTimestamp;
+  if (!m_keyTimestamps.find(keyName, lastTimestamp))
     {
       if (!(currentTime - m_graceInterval <= interestTime &&
             interestTime <= currentTime + m_graceInterval))
@@ -640,62 +736,18 @@ ValidatorConfig::checkTimestamp(const shared_ptr<const Interest>& interest,
     }
   else
     {
-      if (interestTime <= timestampIt->second)
+      if (interestTime <= lastTimestamp)
         return onValidationFailed(interest,
                                   "The command is outdated: " +
                                   interest->getName().toUri());
     }
 
   //Update timestamp
-  if (timestampIt == m_lastTimestamp.end())
-    {
-      cleanOldKeys();
-      m_lastTimestamp[keyName] = interestTime;
-    }
-  else
-    {
-      timestampIt->second = interestTime;
-    }
+  m_keyTimestamps.update(keyName, interestTime);
 
   return onValidated(interest);
 }
 
-void
-ValidatorConfig::cleanOldKeys()
-{
-  if (m_lastTimestamp.size() < m_maxTrackedKeys)
-    return;
-
-  LastTimestampMap::iterator timestampIt = m_lastTimestamp.begin();
-  LastTimestampMap::iterator end = m_lastTimestamp.end();
-
-  time::system_clock::TimePoint now = time::system_clock::now();
-  LastTimestampMap::iterator oldestKeyIt = m_lastTimestamp.begin();
-  time::system_clock::TimePoint oldestTimestamp = oldestKeyIt->second;
-
-  while (timestampIt != end)
-    {
-      if (now - timestampIt->second > m_keyTimestampTtl)
-        {
-          LastTimestampMap::iterator toDelete = timestampIt;
-          timestampIt++;
-          m_lastTimestamp.erase(toDelete);
-          continue;
-        }
-
-      if (timestampIt->second < oldestTimestamp)
-        {
-          oldestTimestamp = timestampIt->second;
-          oldestKeyIt = timestampIt;
-        }
-
-      timestampIt++;
-    }
-
-  if (m_lastTimestamp.size() >= m_maxTrackedKeys)
-    m_lastTimestamp.erase(oldestKeyIt);
-}
-
 void
 ValidatorConfig::DynamicTrustAnchorContainer::refresh()
 {
@@ -712,7 +764,7 @@ ValidatorConfig::DynamicTrustAnchorContainer::refresh()
           shared_ptr<IdentityCertificate> idCert =
             io::load<IdentityCertificate>(it->path().string());
 
-          if (static_cast<bool>(idCert))
+          if (idCert != nullptr && idCert->isContentDecodable())
             m_certificates.push_back(idCert);
         }
     }
@@ -721,7 +773,7 @@ ValidatorConfig::DynamicTrustAnchorContainer::refresh()
       shared_ptr<IdentityCertificate> idCert =
         io::load<IdentityCertificate>(m_path.string());
 
-      if (static_cast<bool>(idCert))
+      if (idCert != nullptr && idCert->isContentDecodable())
         m_certificates.push_back(idCert);
     }
 }
@@ -746,10 +798,41 @@ ValidatorConfig::checkSignature(const Packet& packet,
                                   "Sha256 Signature cannot be verified!");
     }
 
+  if (signature.getType() == tlv::SignatureHmacWithSha256)
+    {
+      try
+        {
+          SignatureHmacWithSha256 sigHmac(signature);
+
+          ConstBufferPtr key = m_sharedKeys.find(sigHmac.getKeyLocator().getName(),
+                                                 packet.getName());
+          if (key == nullptr)
+            return onValidationFailed(packet.shared_from_this(),
+                                      "No shared key for HMAC signature");
+
+          if (verifySignature(packet, sigHmac, *key))
+            return onValidated(packet.shared_from_this());
+          else
+            return onValidationFailed(packet.shared_from_this(),
+                                      "HMAC Signature cannot be verified!");
+        }
+      catch (Signature::Error& e)
+        {
+          return onValidationFailed(packet.shared_from_this(),
+                                    "Missing KeyLocator in SignatureInfo");
+        }
+      catch (KeyLocator::Error& e)
+        {
+          return onValidationFailed(packet.shared_from_this(),
+                                    "Cannot decode KeyLocator in HMAC signature");
+        }
+    }
+
   try {
     switch (signature.getType()) {
     case tlv::SignatureSha256WithRsa:
     case tlv::SignatureSha256WithEcdsa:
+    case tlv::SignatureEd25519:
       {
         if (!signature.hasKeyLocator()) {
           return onValidationFailed(packet.shared_from_this(),
@@ -840,6 +923,7 @@ ValidatorConfig::onCertValidated(const shared_ptr<const Data>& signCertificate,
   shared_ptr<IdentityCertificate> certificate;
   try {
     certificate = make_shared<IdentityCertificate>(*signCertificate);
+    certificate->decode();
   }
   catch (tlv::Error&) {
     return onValidationFailed(packet,
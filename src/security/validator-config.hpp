@@ -28,6 +28,8 @@
 #include "certificate-cache.hpp"
 #include "conf/rule.hpp"
 #include "conf/common.hpp"
+#include "key-timestamp-table.hpp"
+#include "shared-key-container.hpp"
 
 namespace ndn {
 
@@ -89,6 +91,30 @@ public:
   bool
   isEmpty();
 
+  /**
+   * @brief add a key shared with the signers of HMAC signatures
+   *
+   * HMAC signatures are verified with the key named by their KeyLocator, which must have
+   * been given for a prefix of the packet name.  This is the same as a shared-key section
+   * in the configuration file; loading a configuration clears the keys added before.
+   *
+   * @param prefix name prefix of the packets the key may sign
+   * @param keyName name of the key in the KeyLocator of the signatures
+   * @param key raw key bits
+   * @throw Error the key is empty
+   */
+  void
+  addSharedKey(const Name& prefix, const Name& keyName, ConstBufferPtr key);
+
+  /**
+   * @brief get the last command Interest timestamps of signing keys, including their counters
+   */
+  const security::KeyTimestampTable&
+  getKeyTimestampTable() const
+  {
+    return m_keyTimestamps;
+  }
+
 protected:
   virtual void
   checkPolicy(const Data& data,
@@ -142,6 +168,10 @@ private:
   onConfigTrustAnchor(const security::conf::ConfigSection& section,
                       const std::string& filename);
 
+  void
+  onConfigSharedKey(const security::conf::ConfigSection& section,
+                    const std::string& filename);
+
   time::nanoseconds
   getRefreshPeriod(std::string refreshString);
 
@@ -151,14 +181,11 @@ private:
   void
   refreshAnchors();
 
-  void
-  cleanOldKeys();
-
 #ifdef NDN_CXX_HAVE_TESTS
   size_t
   getTimestampMapSize()
   {
-    return m_lastTimestamp.size();
+    return m_keyTimestamps.size();
   }
 #endif
 
@@ -264,11 +291,10 @@ private:
   TrustAnchorContainer m_staticContainer;
   DynamicContainers m_dynamicContainers;
 
+  security::SharedKeyContainer m_sharedKeys;
+
   time::milliseconds m_graceInterval;
-  size_t m_maxTrackedKeys;
-  typedef std::map<Name, time::system_clock::TimePoint> LastTimestampMap;
-  LastTimestampMap m_lastTimestamp;
-  const time::system_clock::Duration& m_keyTimestampTtl;
+  security::KeyTimestampTable m_keyTimestamps;
 };
 
 } // namespace ndn
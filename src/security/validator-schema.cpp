@@ -46,8 +46,7 @@ ValidatorSchema::ValidatorSchema(Face* face,
   , m_certificateCache(certificateCache)
   , m_graceInterval(graceInterval < time::milliseconds::zero() ?
                     DEFAULT_GRACE_INTERVAL : graceInterval)
-  , m_maxTrackedKeys(maxTrackedKeys)
-  , m_keyTimestampTtl(keyTimestampTtl)
+  , m_keyTimestamps(maxTrackedKeys, keyTimestampTtl)
   , m_schemaInterpreter(make_shared<SchemaInterpreter>())
 {
   if (!static_cast<bool>(m_certificateCache) && face != nullptr)
@@ -66,8 +65,7 @@ ValidatorSchema::ValidatorSchema(Face& face,
   , m_certificateCache(certificateCache)
   , m_graceInterval(graceInterval < time::milliseconds::zero() ?
                     DEFAULT_GRACE_INTERVAL : graceInterval)
-  , m_maxTrackedKeys(maxTrackedKeys)
-  , m_keyTimestampTtl(keyTimestampTtl)
+  , m_keyTimestamps(maxTrackedKeys, keyTimestampTtl)
   , m_schemaInterpreter(make_shared<SchemaInterpreter>())
 {
   if (!static_cast<bool>(m_certificateCache))
@@ -112,6 +110,17 @@ ValidatorSchema::reset()
   m_shouldValidate = true;
 }
 
+void
+ValidatorSchema::addSharedKey(const Name& prefix, const Name& keyName, ConstBufferPtr key)
+{
+  try {
+    m_schemaInterpreter->getSharedKeys().insert(prefix, keyName, key);
+  }
+  catch (SharedKeyContainer::Error& e) {
+    throw Error(e.what());
+  }
+}
+
 bool
 ValidatorSchema::isEmpty()
 {
@@ -175,7 +184,10 @@ ValidatorSchema::checkPolicy(const Interest& interest,
       return onValidationFailed(interest.shared_from_this(),
                                 "Key Locator is not a name");
 
-    Name keyName = IdentityCertificate::certificateNameToPublicKeyName(keyLocator.getName());
+    // HMAC signatures name the shared key itself rather than a certificate
+    Name keyName = signature.getType() == tlv::SignatureHmacWithSha256 ?
+                   keyLocator.getName() :
+                   IdentityCertificate::certificateNameToPublicKeyName(keyLocator.getName());
 
     if (!m_schemaInterpreter->checkSignature(signature))
       return onValidationFailed(interest.shared_from_this(),
@@ -232,8 +244,8 @@ ValidatorSchema::checkTimestamp(const shared_ptr<const Interest>& interest,
 
   time::system_clock::TimePoint currentTime = time::system_clock::now();
 
-  LastTimestampMap::iterator timestampIt = m_lastTimestamp.find(keyName);
-  if (timestampIt == m_lastTimestamp.end()) {
+  time::system_clock::TimePoint lastTimestamp;
+  if (!m_keyTimestamps.find(keyName, lastTimestamp)) {
     if (!(currentTime - m_graceInterval <= interestTime &&
           interestTime <= currentTime + m_graceInterval))
       return onValidationFailed(interest,
@@ -241,57 +253,18 @@ ValidatorSchema::checkTimestamp(const shared_ptr<const Interest>& interest,
                                 interest->getName().toUri());
   }
   else {
-    if (interestTime < timestampIt->second)
+    if (interestTime < lastTimestamp)
       return onValidationFailed(interest,
                                 "The command is outdated: " +
                                 interest->getName().toUri());
   }
 
   //Update timestamp
-  if (timestampIt == m_lastTimestamp.end()) {
-    cleanOldKeys();
-    m_lastTimestamp[keyName] = interestTime;
-  }
-  else {
-    timestampIt->second = interestTime;
-  }
+  m_keyTimestamps.update(keyName, interestTime);
 
   return onValidated(interest);
 }
 
-void
-ValidatorSchema::cleanOldKeys()
-{
-  if (m_lastTimestamp.size() < m_maxTrackedKeys)
-    return;
-
-  LastTimestampMap::iterator timestampIt = m_lastTimestamp.begin();
-  LastTimestampMap::iterator end = m_lastTimestamp.end();
-
-  time::system_clock::TimePoint now = time::system_clock::now();
-  LastTimestampMap::iterator oldestKeyIt = m_lastTimestamp.begin();
-  time::system_clock::TimePoint oldestTimestamp = oldestKeyIt->second;
-
-  while (timestampIt != end) {
-    if (now - timestampIt->second > m_keyTimestampTtl) {
-      LastTimestampMap::iterator toDelete = timestampIt;
-      timestampIt++;
-      m_lastTimestamp.erase(toDelete);
-      continue;
-    }
-
-    if (timestampIt->second < oldestTimestamp) {
-      oldestTimestamp = timestampIt->second;
-      oldestKeyIt = timestampIt;
-    }
-
-    timestampIt++;
-  }
-
-  if (m_lastTimestamp.size() >= m_maxTrackedKeys)
-    m_lastTimestamp.erase(oldestKeyIt);
-}
-
 template<class Packet, class OnValidated, class OnFailed>
 void
 ValidatorSchema::checkSignature(const Packet& packet,
@@ -311,10 +284,38 @@ ValidatorSchema::checkSignature(const Packet& packet,
                                 "Sha256 Signature cannot be verified!");
   }
 
+  if (signature.getType() == tlv::SignatureHmacWithSha256) {
+    try {
+      SignatureHmacWithSha256 sigHmac(signature);
+
+      ConstBufferPtr key =
+        m_schemaInterpreter->getSharedKeys().find(sigHmac.getKeyLocator().getName(),
+                                                  packet.getName());
+      if (key == nullptr)
+        return onValidationFailed(packet.shared_from_this(),
+                                  "No shared key for HMAC signature");
+
+      if (verifySignature(packet, sigHmac, *key))
+        return onValidated(packet.shared_from_this());
+      else
+        return onValidationFailed(packet.shared_from_this(),
+                                  "HMAC Signature cannot be verified!");
+    }
+    catch (Signature::Error& e) {
+      return onValidationFailed(packet.shared_from_this(),
+                                "Missing KeyLocator in SignatureInfo");
+    }
+    catch (KeyLocator::Error& e) {
+      return onValidationFailed(packet.shared_from_this(),
+                                "Cannot decode KeyLocator in HMAC signature");
+    }
+  }
+
   try {
     switch (signature.getType()) {
     case tlv::SignatureSha256WithRsa:
     case tlv::SignatureSha256WithEcdsa:
+    case tlv::SignatureEd25519:
       {
         if (!signature.hasKeyLocator()) {
           return onValidationFailed(packet.shared_from_this(),
@@ -402,6 +403,7 @@ ValidatorSchema::onCertValidated(const shared_ptr<const Data>& signCertificate,
   shared_ptr<IdentityCertificate> certificate;
   try {
     certificate = make_shared<IdentityCertificate>(*signCertificate);
+    certificate->decode();
   }
   catch (tlv::Error&) {
     return onValidationFailed(packet,
@@ -25,6 +25,7 @@
 #include "validator.hpp"
 #include "certificate-cache.hpp"
 #include "schema/schema-interpreter.hpp"
+#include "key-timestamp-table.hpp"
 
 namespace ndn {
 namespace security {
@@ -83,6 +84,29 @@ public:
   bool
   isEmpty();
 
+  /**
+   * @brief add a key shared with the signers of HMAC signatures
+   *
+   * Equivalent to a shared-key section in the schema.  Loading a schema clears the keys
+   * added before.
+   *
+   * @param prefix name prefix of the packets the key may sign
+   * @param keyName name of the key in the KeyLocator of the signatures
+   * @param key raw key bits
+   * @throw Error the key is empty
+   */
+  void
+  addSharedKey(const Name& prefix, const Name& keyName, ConstBufferPtr key);
+
+  /**
+   * @brief get the last command Interest timestamps of signing keys, including their counters
+   */
+  const KeyTimestampTable&
+  getKeyTimestampTable() const
+  {
+    return m_keyTimestamps;
+  }
+
 protected:
   virtual void
   checkPolicy(const Data& data,
@@ -128,14 +152,11 @@ private:
                const shared_ptr<const Packet>& packet,
                const OnFailed& onValidationFailed);
 
-  void
-  cleanOldKeys();
-
 #ifdef NDN_CXX_HAVE_TESTS
   size_t
   getTimestampMapSize()
   {
-    return m_lastTimestamp.size();
+    return m_keyTimestamps.size();
   }
 #endif
 
@@ -156,10 +177,7 @@ private:
   shared_ptr<CertificateCache> m_certificateCache;
 
   time::milliseconds m_graceInterval;
-  size_t m_maxTrackedKeys;
-  typedef std::map<Name, time::system_clock::TimePoint> LastTimestampMap;
-  LastTimestampMap m_lastTimestamp;
-  const time::system_clock::Duration& m_keyTimestampTtl;
+  KeyTimestampTable m_keyTimestamps;
 
   shared_ptr<SchemaInterpreter> m_schemaInterpreter;
 };
@@ -25,15 +25,11 @@
 #include "common.hpp"
 
 #include "validator.hpp"
+#include "crypto-backend.hpp"
 #include "../util/crypto.hpp"
 
-#include "cryptopp.hpp"
-
 namespace ndn {
 
-static OID SECP256R1("1.2.840.10045.3.1.7");
-static OID SECP384R1("1.3.132.0.34");
-
 Validator::Validator(Face* face)
   : m_face(face)
 {
@@ -148,92 +144,36 @@ Validator::verifySignature(const uint8_t* buf,
                            const Signature& sig,
                            const PublicKey& key)
 {
+  KeyType keyType;
+  switch (sig.getType())
+    {
+    case tlv::SignatureSha256WithRsa:
+      keyType = KEY_TYPE_RSA;
+      break;
+    case tlv::SignatureSha256WithEcdsa:
+      keyType = KEY_TYPE_ECDSA;
+      break;
+    case tlv::SignatureEd25519:
+      keyType = KEY_TYPE_ED25519;
+      break;
+    default:
+      // Unsupported sig type
+      return false;
+    }
+
+  if (key.getKeyType() != keyType)
+    return false;
+
   try
     {
-      using namespace CryptoPP;
-
-      switch (sig.getType())
-        {
-        case tlv::SignatureSha256WithRsa:
-          {
-            if (key.getKeyType() != KEY_TYPE_RSA)
-              return false;
-
-            RSA::PublicKey publicKey;
-            ByteQueue queue;
-
-            queue.Put(reinterpret_cast<const byte*>(key.get().buf()), key.get().size());
-            publicKey.Load(queue);
-
-            RSASS<PKCS1v15, SHA256>::Verifier verifier(publicKey);
-            return verifier.VerifyMessage(buf, size,
-                                          sig.getValue().value(), sig.getValue().value_size());
-          }
-        case tlv::SignatureSha256WithEcdsa:
-          {
-            if (key.getKeyType() != KEY_TYPE_ECDSA)
-              return false;
-
-            ECDSA<ECP, SHA256>::PublicKey publicKey;
-            ByteQueue queue;
-
-            queue.Put(reinterpret_cast<const byte*>(key.get().buf()), key.get().size());
-            publicKey.Load(queue);
-
-            ECDSA<ECP, SHA256>::Verifier verifier(publicKey);
-
-            uint32_t length = 0;
-            StringSource src(key.get().buf(), key.get().size(), true);
-            BERSequenceDecoder subjectPublicKeyInfo(src);
-            {
-              BERSequenceDecoder algorithmInfo(subjectPublicKeyInfo);
-              {
-                OID algorithm;
-                algorithm.decode(algorithmInfo);
-
-                OID curveId;
-                curveId.decode(algorithmInfo);
-
-                if (curveId == SECP256R1)
-                  length = 256;
-                else if (curveId == SECP384R1)
-                  length = 384;
-                else
-                  return false;
-              }
-            }
-
-            switch (length)
-              {
-              case 256:
-                {
-                  uint8_t buffer[64];
-                  size_t usedSize = DSAConvertSignatureFormat(buffer, 64, DSA_P1363,
-                                                              sig.getValue().value(),
-                                                              sig.getValue().value_size(),
-                                                              DSA_DER);
-                  return verifier.VerifyMessage(buf, size, buffer, usedSize);
-                }
-              case 384:
-                {
-                  uint8_t buffer[96];
-                  size_t usedSize = DSAConvertSignatureFormat(buffer, 96, DSA_P1363,
-                                                              sig.getValue().value(),
-                                                              sig.getValue().value_size(),
-                                                              DSA_DER);
-                  return verifier.VerifyMessage(buf, size, buffer, usedSize);
-                }
-              default:
-                return false;
-              }
-          }
-        default:
-          // Unsupported sig type
-          return false;
-        }
+      const CryptoBackend& backend = CryptoBackend::getDefault(keyType);
+      return backend.verify(keyType, key.get().buf(), key.get().size(), buf, size,
+                            sig.getValue().value(), sig.getValue().value_size(),
+                            DIGEST_ALGORITHM_SHA256);
     }
-  catch (CryptoPP::Exception& e)
+  catch (CryptoBackend::Error& e)
     {
+      // no backend supports the key type
       return false;
     }
 }
@@ -243,23 +183,43 @@ Validator::verifySignature(const uint8_t* buf, const size_t size, const DigestSh
 {
   try
     {
-      ConstBufferPtr buffer = crypto::sha256(buf, size);
       const Block& sigValue = sig.getValue();
+      if (sigValue.value_size() != crypto::SHA256_DIGEST_SIZE)
+        return false;
 
-      if (static_cast<bool>(buffer) &&
-          buffer->size() == sigValue.value_size() &&
-          buffer->size() == crypto::SHA256_DIGEST_SIZE)
-        {
+      uint8_t digest[crypto::SHA256_DIGEST_SIZE];
+      crypto::sha256(buf, size, digest);
 
-          const uint8_t* p1 = buffer->buf();
-          const uint8_t* p2 = sigValue.value();
+      return 0 == memcmp(digest, sigValue.value(), crypto::SHA256_DIGEST_SIZE);
+    }
+  catch (crypto::Error& e)
+    {
+      return false;
+    }
+}
 
-          return 0 == memcmp(p1, p2, crypto::SHA256_DIGEST_SIZE);
-        }
-      else
+bool
+Validator::verifySignature(const uint8_t* buf, const size_t size,
+                           const SignatureHmacWithSha256& sig,
+                           const uint8_t* key, size_t keySize)
+{
+  try
+    {
+      const Block& sigValue = sig.getValue();
+      if (sigValue.value_size() != crypto::SHA256_DIGEST_SIZE)
         return false;
+
+      uint8_t hmac[crypto::SHA256_DIGEST_SIZE];
+      crypto::hmacSha256(key, keySize, buf, size, hmac);
+
+      // compare in constant time, so that the timing does not reveal a valid HMAC
+      uint8_t diff = 0;
+      for (size_t i = 0; i < crypto::SHA256_DIGEST_SIZE; ++i)
+        diff |= hmac[i] ^ sigValue.value()[i];
+
+      return diff == 0;
     }
-  catch (CryptoPP::Exception& e)
+  catch (crypto::Error& e)
     {
       return false;
     }
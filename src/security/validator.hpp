@@ -32,6 +32,7 @@
 #include "public-key.hpp"
 #include "signature-sha256-with-rsa.hpp"
 #include "signature-sha256-with-ecdsa.hpp"
+#include "signature-hmac-with-sha256.hpp"
 #include "digest-sha256.hpp"
 #include "validation-request.hpp"
 
@@ -198,6 +199,39 @@ public:
   static bool
   verifySignature(const uint8_t* buf, const size_t size, const DigestSha256& sig);
 
+  /// @brief Verify the data using the shared key against the HMAC-SHA256 signature.
+  static bool
+  verifySignature(const Data& data, const SignatureHmacWithSha256& sig, const Buffer& key)
+  {
+    return verifySignature(data.wireEncode().value(),
+                           data.wireEncode().value_size() -
+                           data.getSignature().getValue().size(),
+                           sig, key.buf(), key.size());
+  }
+
+  /** @brief Verify the interest using the shared key against the HMAC-SHA256 signature.
+   *
+   * (Note the signature covers the first n-2 name components).
+   */
+  static bool
+  verifySignature(const Interest& interest, const SignatureHmacWithSha256& sig,
+                  const Buffer& key)
+  {
+    if (interest.getName().size() < 2)
+      return false;
+
+    const Name& name = interest.getName();
+
+    return verifySignature(name.wireEncode().value(),
+                           name.wireEncode().value_size() - name[-1].size(),
+                           sig, key.buf(), key.size());
+  }
+
+  /// @brief Verify the blob using the shared key against the HMAC-SHA256 signature.
+  static bool
+  verifySignature(const uint8_t* buf, const size_t size, const SignatureHmacWithSha256& sig,
+                  const uint8_t* key, size_t keySize);
+
 protected:
   /**
    * @brief Check the Data against policy and return the next validation step if necessary.
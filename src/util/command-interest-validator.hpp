@@ -25,6 +25,7 @@
 #include "../security/validator.hpp"
 #include "../security/identity-certificate.hpp"
 #include "../security/sec-rule-specific.hpp"
+#include "../security/key-timestamp-table.hpp"
 
 #include <list>
 
@@ -50,13 +51,17 @@ public:
 
     MIN_LENGTH = 4,
 
-    GRACE_INTERVAL = 3000 // ms
+    GRACE_INTERVAL = 3000, // ms
+
+    MAX_TRACKED_KEYS = 1000,
+    KEY_TIMESTAMP_TTL = 3600 // s
   };
 
   CommandInterestValidator(const time::milliseconds& graceInterval =
                            time::milliseconds(static_cast<int>(GRACE_INTERVAL)))
     : m_graceInterval(graceInterval < time::milliseconds::zero() ?
                       time::milliseconds(static_cast<int>(GRACE_INTERVAL)) : graceInterval)
+    , m_keyTimestamps(MAX_TRACKED_KEYS, time::seconds(static_cast<int>(KEY_TIMESTAMP_TTL)))
   {
   }
 
@@ -121,8 +126,7 @@ private:
   std::map<Name, PublicKey> m_trustAnchorsForInterest;
   std::list<SecRuleSpecific> m_trustScopeForInterest;
 
-  typedef std::map<Name, time::system_clock::TimePoint> LastTimestampMap;
-  LastTimestampMap m_lastTimestamp;
+  security::KeyTimestampTable m_keyTimestamps;
 };
 
 inline void
@@ -228,8 +232,8 @@ CommandInterestValidator::checkPolicy(const Interest& interest,
 
       time::system_clock::TimePoint currentTime = time::system_clock::now();
 
-      LastTimestampMap::iterator timestampIt = m_lastTimestamp.find(keyName);
-      if (timestampIt == m_lastTimestamp.end())
+      time::system_clock::TimePoint lastTimestamp;
+      if (!m_keyTimestamps.find(keyName, lastTimestamp))
         {
           if (!(currentTime - m_graceInterval <= interestTime &&
                 interestTime <= currentTime + m_graceInterval))
@@ -239,21 +243,14 @@ CommandInterestValidator::checkPolicy(const Interest& interest,
         }
       else
         {
-          if (interestTime <= timestampIt->second)
+          if (interestTime <= lastTimestamp)
             return onValidationFailed(interest.shared_from_this(),
                                       "The command is outdated: " +
                                       interest.getName().toUri());
         }
 
       //Update timestamp
-      if (timestampIt == m_lastTimestamp.end())
-        {
-          m_lastTimestamp[keyName] = interestTime;
-        }
-      else
-        {
-          timestampIt->second = interestTime;
-        }
+      m_keyTimestamps.update(keyName, interestTime);
     }
   catch (Signature::Error& e)
     {
@@ -22,47 +22,127 @@
 #include "../common.hpp"
 
 #include "crypto.hpp"
-#include "../encoding/buffer-stream.hpp"
+
+#ifdef NDN_CXX_HAVE_OPENSSL
+#include "../security/openssl.hpp"
+#else
 #include "../security/cryptopp.hpp"
+#endif // NDN_CXX_HAVE_OPENSSL
 
 namespace ndn {
 
-void ndn_digestSha256(const uint8_t* data, size_t dataLength, uint8_t* digest)
+void
+ndn_digestSha256(const uint8_t* data, size_t dataLength, uint8_t* digest)
 {
-  try
-    {
-      using namespace CryptoPP;
-
-      CryptoPP::SHA256 hash;
-      OBufferStream os;
-      StringSource(data, dataLength, true,
-                   new HashFilter(hash, new ArraySink(digest, crypto::SHA256_DIGEST_SIZE)));
-    }
-  catch (CryptoPP::Exception& e)
-    {
-      return;
+  try {
+    crypto::sha256(data, dataLength, digest);
+  }
+  catch (const crypto::Error&) {
+    return;
+  }
+}
+
+namespace crypto {
+
+#ifdef NDN_CXX_HAVE_OPENSSL
+
+struct EvpMdCtxDeleter
+{
+  void
+  operator()(EVP_MD_CTX* ctx) const
+  {
+    EVP_MD_CTX_destroy(ctx);
+  }
+};
+
+void
+sha256(const uint8_t* data, size_t dataLength, uint8_t* digest)
+{
+  if (EVP_Digest(data, dataLength, digest, nullptr, EVP_sha256(), nullptr) != 1)
+    throw Error("Cannot compute SHA-256 digest");
+}
+
+void
+sha256Batch(const uint8_t* const* data, const size_t* dataLength, size_t nBuffers,
+            uint8_t* digests)
+{
+  if (nBuffers == 0)
+    return;
+
+  unique_ptr<EVP_MD_CTX, EvpMdCtxDeleter> ctx(EVP_MD_CTX_create());
+  if (ctx == nullptr)
+    throw Error("Cannot allocate SHA-256 digest context");
+
+  const EVP_MD* md = EVP_sha256();
+  for (size_t i = 0; i < nBuffers; ++i) {
+    if (EVP_DigestInit_ex(ctx.get(), md, nullptr) != 1 ||
+        EVP_DigestUpdate(ctx.get(), data[i], dataLength[i]) != 1 ||
+        EVP_DigestFinal_ex(ctx.get(), digests + i * SHA256_DIGEST_SIZE, nullptr) != 1)
+      throw Error("Cannot compute SHA-256 digest");
+  }
+}
+
+void
+hmacSha256(const uint8_t* key, size_t keyLength, const uint8_t* data, size_t dataLength,
+           uint8_t* digest)
+{
+  if (HMAC(EVP_sha256(), key, keyLength, data, dataLength, digest, nullptr) == nullptr)
+    throw Error("Cannot compute HMAC-SHA256");
+}
+
+#else
+
+void
+sha256(const uint8_t* data, size_t dataLength, uint8_t* digest)
+{
+  try {
+    CryptoPP::SHA256().CalculateDigest(digest, data, dataLength);
+  }
+  catch (const CryptoPP::Exception& e) {
+    throw Error(e.what());
+  }
+}
+
+void
+sha256Batch(const uint8_t* const* data, const size_t* dataLength, size_t nBuffers,
+            uint8_t* digests)
+{
+  try {
+    CryptoPP::SHA256 hash;
+    for (size_t i = 0; i < nBuffers; ++i) {
+      hash.CalculateDigest(digests + i * SHA256_DIGEST_SIZE, data[i], dataLength[i]);
     }
+  }
+  catch (const CryptoPP::Exception& e) {
+    throw Error(e.what());
+  }
+}
 
+void
+hmacSha256(const uint8_t* key, size_t keyLength, const uint8_t* data, size_t dataLength,
+           uint8_t* digest)
+{
+  try {
+    CryptoPP::HMAC<CryptoPP::SHA256>(key, keyLength).CalculateDigest(digest, data, dataLength);
+  }
+  catch (const CryptoPP::Exception& e) {
+    throw Error(e.what());
+  }
 }
 
-namespace crypto {
+#endif // NDN_CXX_HAVE_OPENSSL
 
 ConstBufferPtr
 sha256(const uint8_t* data, size_t dataLength)
 {
-  try
-    {
-      using namespace CryptoPP;
-
-      SHA256 hash;
-      OBufferStream os;
-      StringSource(data, dataLength, true, new HashFilter(hash, new FileSink(os)));
-      return os.buf();
-    }
-  catch (CryptoPP::Exception& e)
-    {
-      return ConstBufferPtr();
-    }
+  try {
+    shared_ptr<Buffer> digest = make_shared<Buffer>(SHA256_DIGEST_SIZE);
+    sha256(data, dataLength, digest->buf());
+    return digest;
+  }
+  catch (const Error&) {
+    return ConstBufferPtr();
+  }
 }
 
 } // namespace crypto
@@ -42,16 +42,72 @@ namespace crypto {
 /// @brief number of octets in a SHA256 digest
 static const size_t SHA256_DIGEST_SIZE = 32;
 
+class Error : public std::runtime_error
+{
+public:
+  explicit
+  Error(const std::string& what)
+    : std::runtime_error(what)
+  {
+  }
+};
+
 /**
  * @brief Compute the sha-256 digest of data.
  *
  * @param data Pointer to the input byte array.
  * @param dataLength The length of data.
- * @return A pointer to a buffer of SHA256_DIGEST.
+ * @return A pointer to a buffer of SHA256_DIGEST, or nullptr if the digest cannot be computed.
  */
 ConstBufferPtr
 sha256(const uint8_t* data, size_t dataLength);
 
+/**
+ * @brief Compute the sha-256 digest of data into caller-provided storage.
+ *
+ * Unlike the overload returning a buffer, this function does not allocate, so it can be used
+ * with a digest array on the stack in per-packet code paths.  When the library is built with
+ * OpenSSL, the digest is computed by the OpenSSL EVP implementation, which uses the SHA
+ * extensions of the CPU when they are available.
+ *
+ * @param data Pointer to the input byte array.
+ * @param dataLength The length of data.
+ * @param[out] digest A pointer to a buffer of size SHA256_DIGEST_SIZE to receive the digest.
+ * @throw Error the digest cannot be computed
+ */
+void
+sha256(const uint8_t* data, size_t dataLength, uint8_t* digest);
+
+/**
+ * @brief Compute the sha-256 digests of a batch of byte arrays.
+ *
+ * The digest of data[i] is written at offset i * SHA256_DIGEST_SIZE of @p digests.
+ * Hashing state is set up once and reused for the whole batch.
+ *
+ * @param data Pointers to the input byte arrays.
+ * @param dataLength The lengths of the input byte arrays.
+ * @param nBuffers The number of input byte arrays.
+ * @param[out] digests A pointer to a buffer of size nBuffers * SHA256_DIGEST_SIZE.
+ * @throw Error the digests cannot be computed
+ */
+void
+sha256Batch(const uint8_t* const* data, const size_t* dataLength, size_t nBuffers,
+            uint8_t* digests);
+
+/**
+ * @brief Compute the HMAC-SHA256 of data.
+ *
+ * @param key Pointer to the secret key.
+ * @param keyLength The length of the key.
+ * @param data Pointer to the input byte array.
+ * @param dataLength The length of data.
+ * @param[out] digest A pointer to a buffer of size SHA256_DIGEST_SIZE to receive the HMAC.
+ * @throw Error the HMAC cannot be computed
+ */
+void
+hmacSha256(const uint8_t* key, size_t keyLength, const uint8_t* data, size_t dataLength,
+           uint8_t* digest);
+
 } // namespace crypto
 
 } // namespace ndn
@@ -0,0 +1,423 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "disk-storage.hpp"
+#include "../encoding/tlv.hpp"
+#include "../encoding/block-helpers.hpp"
+
+#include <boost/filesystem.hpp>
+
+namespace ndn {
+namespace util {
+
+/** @brief TLV types of log records other than Data
+ */
+enum {
+  /// precedes a Data packet with FreshnessPeriod, UNIX timestamp in milliseconds
+  /// when the packet becomes stale
+  LogStaleTime = tlv::AppPrivateBlock1,
+  /// Name under which the stored packets are erased
+  LogErasePrefix,
+  /// Name of the stored packet that is erased
+  LogEraseName
+};
+
+/** @brief Decodes the Name element at the beginning of [begin, end)
+ *  @throws tlv::Error if there is no Name element
+ */
+static Name
+decodeName(const uint8_t* begin, const uint8_t* end)
+{
+  const uint8_t* position = begin;
+  uint32_t type = 0;
+  uint64_t length = 0;
+  if (!tlv::readType(position, end, type) || type != tlv::Name ||
+      !tlv::readVarNumber(position, end, length) ||
+      length > static_cast<uint64_t>(end - position))
+    throw tlv::Error("Name element is expected");
+
+  return Name(Block(begin, position + length - begin));
+}
+
+/** @return{ whether a packet with this Name can satisfy the Interest as far as the selectors
+ *           that depend only on the Name are concerned }
+ *  @note The Name must be under the Interest Name, or be the Interest Name without implicit
+ *        digest.
+ */
+static bool
+canSatisfy(const Interest& interest, const Name& name)
+{
+  size_t prefixSize = interest.getName().size();
+  // implicit digest is the last component of the full name
+  size_t nSuffixComponents = name.size() + 1 - prefixSize;
+
+  if (interest.getMinSuffixComponents() >= 0 &&
+      nSuffixComponents < static_cast<size_t>(interest.getMinSuffixComponents()))
+    return false;
+
+  if (interest.getMaxSuffixComponents() >= 0 &&
+      nSuffixComponents > static_cast<size_t>(interest.getMaxSuffixComponents()))
+    return false;
+
+  // an excluded implicit digest is checked once the packet is read
+  if (!interest.getExclude().empty() && name.size() > prefixSize &&
+      interest.getExclude().isExcluded(name.get(prefixSize)))
+    return false;
+
+  return true;
+}
+
+DiskStorage::DiskStorage(const std::string& path)
+  : m_path(path)
+  , m_logSize(0)
+{
+  load();
+  openLog();
+}
+
+DiskStorage::~DiskStorage()
+{
+}
+
+void
+DiskStorage::load()
+{
+  if (!boost::filesystem::exists(m_path) || boost::filesystem::file_size(m_path) == 0)
+    return;
+
+  try {
+    m_mapping.open(m_path);
+  }
+  catch (const std::exception& e) {
+    throw Error("Cannot map log file " + m_path + " (" + e.what() + ")");
+  }
+
+  const uint8_t* begin = reinterpret_cast<const uint8_t*>(m_mapping.data());
+  const uint8_t* end = begin + m_mapping.size();
+  const uint8_t* position = begin;
+  // beginning of the current record, including the stale time preceding a packet
+  const uint8_t* record = begin;
+  time::system_clock::TimePoint staleTime = time::system_clock::TimePoint::max();
+
+  try {
+    while (position != end) {
+      const uint8_t* element = position;
+
+      uint32_t type = 0;
+      uint64_t length = 0;
+      if (!tlv::readType(position, end, type) || !tlv::readVarNumber(position, end, length) ||
+          length > static_cast<uint64_t>(end - position)) {
+        // incomplete record at the end of the log
+        break;
+      }
+      const uint8_t* valueEnd = position + length;
+
+      if (record != element && type != tlv::Data)
+        throw Error("Log file " + m_path + " contains a stale time not followed by Data");
+
+      switch (type) {
+      case tlv::Data: {
+        // Name is the first element of Data, nothing else is decoded
+        Record entry = {static_cast<uint64_t>(element - begin),
+                        static_cast<size_t>(valueEnd - element),
+                        staleTime};
+        m_index[decodeName(position, valueEnd)] = entry;
+        staleTime = time::system_clock::TimePoint::max();
+        break;
+      }
+      case LogStaleTime:
+        staleTime = time::fromUnixTimestamp(
+                      time::milliseconds(tlv::readNonNegativeInteger(length, position, valueEnd)));
+        position = valueEnd;
+        continue;
+      case LogErasePrefix:
+      case LogEraseName:
+        eraseFromIndex(decodeName(position, valueEnd), type == LogErasePrefix);
+        break;
+      default:
+        throw Error("Log file " + m_path + " contains an unknown record");
+      }
+
+      position = valueEnd;
+      record = position;
+    }
+  }
+  catch (const tlv::Error& e) {
+    throw Error("Log file " + m_path + " contains a malformed record (" + e.what() + ")");
+  }
+
+  m_logSize = record - begin;
+  if (record != end) {
+    m_mapping.close();
+    boost::filesystem::resize_file(m_path, m_logSize);
+  }
+}
+
+void
+DiskStorage::openLog()
+{
+  m_log.open(m_path.c_str(), std::ios::out | std::ios::binary | std::ios::app);
+  if (!m_log.is_open())
+    throw Error("Cannot open log file " + m_path);
+}
+
+void
+DiskStorage::write(const Block& block)
+{
+  m_log.write(reinterpret_cast<const char*>(block.wire()), block.size());
+}
+
+void
+DiskStorage::flush()
+{
+  m_log.flush();
+  if (!m_log.good())
+    throw Error("Cannot write to log file " + m_path);
+}
+
+Block
+DiskStorage::makeStaleTime(const time::system_clock::TimePoint& staleTime)
+{
+  return nonNegativeIntegerBlock(LogStaleTime, time::toUnixTimestamp(staleTime).count());
+}
+
+void
+DiskStorage::insert(const Data& data)
+{
+  const Block& wire = data.wireEncode();
+
+  time::system_clock::TimePoint staleTime = time::system_clock::TimePoint::max();
+  uint64_t offset = m_logSize;
+  if (data.getFreshnessPeriod() >= time::milliseconds::zero()) {
+    staleTime = time::system_clock::now() + data.getFreshnessPeriod();
+    Block header = makeStaleTime(staleTime);
+    write(header);
+    offset += header.size();
+  }
+  write(wire);
+  flush();
+
+  Record record = {offset, wire.size(), staleTime};
+  m_index[data.getName()] = record;
+  m_logSize = offset + wire.size();
+}
+
+shared_ptr<const Data>
+DiskStorage::read(const Record& record)
+{
+  uint64_t mappedSize = m_mapping.is_open() ? m_mapping.size() : 0;
+  if (record.offset + record.length > mappedSize && m_logSize - mappedSize > mappedSize) {
+    // the log has more than doubled since it was mapped
+    m_mapping.close();
+    m_mapping.open(m_path);
+    mappedSize = m_mapping.size();
+  }
+
+  shared_ptr<Data> data = make_shared<Data>();
+  if (record.offset + record.length <= mappedSize) {
+    const uint8_t* wire = reinterpret_cast<const uint8_t*>(m_mapping.data()) + record.offset;
+    data->wireDecodeLazy(Block(wire, record.length));
+    return data;
+  }
+
+  // the packet was appended after the log was mapped
+  if (!m_tail.is_open())
+    m_tail.open(m_path.c_str(), std::ios::in | std::ios::binary);
+  m_tail.clear();
+  m_tail.seekg(record.offset);
+
+  shared_ptr<Buffer> buffer = make_shared<Buffer>(record.length);
+  m_tail.read(reinterpret_cast<char*>(buffer->buf()), buffer->size());
+  if (!m_tail)
+    throw Error("Cannot read from log file " + m_path);
+
+  data->wireDecodeLazy(Block(buffer));
+  return data;
+}
+
+shared_ptr<const Data>
+DiskStorage::match(const Interest& interest, const Index::value_type& entry)
+{
+  if (!canSatisfy(interest, entry.first))
+    return shared_ptr<const Data>();
+
+  if (interest.getMustBeFresh() && time::system_clock::now() >= entry.second.staleTime)
+    return shared_ptr<const Data>();
+
+  shared_ptr<const Data> data = read(entry.second);
+  if (!interest.matchesData(*data))
+    return shared_ptr<const Data>();
+
+  return data;
+}
+
+shared_ptr<const Data>
+DiskStorage::find(const Interest& interest)
+{
+  const Name& prefix = interest.getName();
+
+  if (!prefix.empty() && prefix.get(-1).isImplicitSha256Digest()) {
+    Index::iterator it = m_index.find(prefix.getPrefix(-1));
+    if (it != m_index.end()) {
+      shared_ptr<const Data> data = match(interest, *it);
+      if (data != nullptr)
+        return data;
+    }
+  }
+
+  Index::iterator first = m_index.lower_bound(prefix);
+  Index::iterator last = prefix.empty() ? m_index.end() : m_index.lower_bound(prefix.getSuccessor());
+
+  if (interest.getChildSelector() <= 0) {
+    for (Index::iterator it = first; it != last; ++it) {
+      shared_ptr<const Data> data = match(interest, *it);
+      if (data != nullptr)
+        return data;
+    }
+    return shared_ptr<const Data>();
+  }
+
+  // visit children from the rightmost one, returning the leftmost match within the child
+  Index::iterator childEnd = last;
+  while (childEnd != first) {
+    Index::iterator childBegin = std::prev(childEnd);
+    if (childBegin->first.size() > prefix.size()) {
+      childBegin = m_index.lower_bound(childBegin->first.getPrefix(prefix.size() + 1));
+    }
+
+    for (Index::iterator it = childBegin; it != childEnd; ++it) {
+      shared_ptr<const Data> data = match(interest, *it);
+      if (data != nullptr)
+        return data;
+    }
+
+    childEnd = childBegin;
+  }
+
+  return shared_ptr<const Data>();
+}
+
+shared_ptr<const Data>
+DiskStorage::find(const Name& name)
+{
+  Index::iterator it = m_index.lower_bound(name);
+  if (it != m_index.end() && name.isPrefixOf(it->first))
+    return read(it->second);
+
+  // name may be the full name of a stored packet
+  if (!name.empty() && name.get(-1).isImplicitSha256Digest()) {
+    it = m_index.find(name.getPrefix(-1));
+    if (it != m_index.end()) {
+      shared_ptr<const Data> data = read(it->second);
+      if (data->getFullName() == name)
+        return data;
+    }
+  }
+
+  return shared_ptr<const Data>();
+}
+
+void
+DiskStorage::erase(const Name& prefix, const bool isPrefix)
+{
+  Index::iterator first = m_index.lower_bound(prefix);
+  if (first == m_index.end() || !prefix.isPrefixOf(first->first) ||
+      (!isPrefix && first->first != prefix))
+    return;
+
+  // erasure is recorded in the log, so that the packets are not loaded again
+  const Block& name = prefix.wireEncode();
+  Block tombstone = dataBlock(isPrefix ? LogErasePrefix : LogEraseName, name.wire(), name.size());
+  write(tombstone);
+  flush();
+  m_logSize += tombstone.size();
+
+  eraseFromIndex(prefix, isPrefix);
+}
+
+void
+DiskStorage::eraseFromIndex(const Name& prefix, bool isPrefix)
+{
+  if (!isPrefix) {
+    m_index.erase(prefix);
+    return;
+  }
+
+  Index::iterator first = m_index.lower_bound(prefix);
+  Index::iterator last = prefix.empty() ? m_index.end() : m_index.lower_bound(prefix.getSuccessor());
+  m_index.erase(first, last);
+}
+
+void
+DiskStorage::compact()
+{
+  std::string compactPath = m_path + ".compact";
+
+  m_log.close();
+  m_tail.close();
+  m_mapping.close();
+
+  std::vector<uint64_t> offsets;
+  offsets.reserve(m_index.size());
+  uint64_t offset = 0;
+  try {
+    if (m_logSize > 0)
+      m_mapping.open(m_path);
+
+    std::ofstream output(compactPath.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+    for (const Index::value_type& entry : m_index) {
+      if (entry.second.staleTime != time::system_clock::TimePoint::max()) {
+        Block header = makeStaleTime(entry.second.staleTime);
+        output.write(reinterpret_cast<const char*>(header.wire()), header.size());
+        offset += header.size();
+      }
+      output.write(m_mapping.data() + entry.second.offset, entry.second.length);
+      offsets.push_back(offset);
+      offset += entry.second.length;
+    }
+    output.close();
+    if (!output)
+      throw Error("cannot write " + compactPath);
+
+    m_mapping.close();
+    boost::filesystem::rename(compactPath, m_path);
+  }
+  catch (const std::exception& e) {
+    // keep using the original log
+    m_mapping.close();
+    boost::system::error_code error;
+    boost::filesystem::remove(compactPath, error);
+    openLog();
+
+    throw Error("Cannot compact log file " + m_path + " (" + e.what() + ")");
+  }
+
+  std::vector<uint64_t>::const_iterator newOffset = offsets.begin();
+  for (Index::value_type& entry : m_index) {
+    entry.second.offset = *newOffset++;
+  }
+  m_logSize = offset;
+
+  openLog();
+}
+
+} // namespace util
+} // namespace ndn
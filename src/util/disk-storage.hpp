@@ -0,0 +1,177 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_UTIL_DISK_STORAGE_HPP
+#define NDN_UTIL_DISK_STORAGE_HPP
+
+#include "../common.hpp"
+#include "../interest.hpp"
+#include "../data.hpp"
+#include "time.hpp"
+
+#include <map>
+#include <fstream>
+#include <boost/iostreams/device/mapped_file.hpp>
+
+namespace ndn {
+namespace util {
+
+/** @brief Represents on-disk storage of Data packets
+ *
+ *  Packets are appended in wire format to a log file.  A packet with FreshnessPeriod is
+ *  preceded by the time it becomes stale, and an erasure is appended as a record carrying the
+ *  erased Name, so that the log replays to the same content when it is opened again.
+ *  Only the names of stored packets, their positions in the log and their stale times are
+ *  kept in memory.  Packets are read through a read-only memory mapping of the log: a cache hit
+ *  copies the wire encoding of a single packet and decodes it lazily (Data::wireDecodeLazy).
+ *  Packets appended after the log was mapped are read from the file instead, and the log is
+ *  mapped again only once that unmapped tail has grown larger than the mapped part.
+ *
+ *  When an existing log is opened, the index is rebuilt by reading only the Name of each
+ *  packet.  An incomplete record at the end of the log (e.g. after a crash) is discarded.
+ *
+ *  Unlike InMemoryStorage, at most one packet per Name (without implicit digest) is stored:
+ *  inserting a packet replaces the one with the same Name.  Erased and replaced packets,
+ *  and the erasure records, take space in the log until it is rewritten by compact().
+ *
+ *  Selectors that depend only on the Name, and MustBeFresh, are evaluated before a packet
+ *  is read.  Staleness is measured with the system clock, so that it survives a restart.
+ */
+class DiskStorage : noncopyable
+{
+public:
+  class Error : public std::runtime_error
+  {
+  public:
+    explicit
+    Error(const std::string& what)
+      : std::runtime_error(what)
+    {
+    }
+  };
+
+  /** @brief Opens the log file, creating it if it does not exist
+   *  @throws Error if the file cannot be opened or is not a log of Data packets
+   */
+  explicit
+  DiskStorage(const std::string& path);
+
+  ~DiskStorage();
+
+  /** @brief Appends a Data packet to the log
+   */
+  void
+  insert(const Data& data);
+
+  /** @brief Finds the best match Data for an Interest
+   *  @return{ the best match, if any; otherwise a null shared_ptr }
+   */
+  shared_ptr<const Data>
+  find(const Interest& interest);
+
+  /** @brief Finds the leftmost Data under a Name with or without the implicit digest
+   *  @return{ the one matched the Name; otherwise a null shared_ptr }
+   */
+  shared_ptr<const Data>
+  find(const Name& name);
+
+  /** @brief Deletes Data by prefix by default, or only Data with the exact Name (without
+   *  implicit digest) if isPrefix is clear
+   */
+  void
+  erase(const Name& prefix, const bool isPrefix = true);
+
+  /** @brief Rewrites the log to contain only the stored packets
+   *  @throws Error if the log cannot be rewritten; the storage then stays usable with the
+   *          original log
+   */
+  void
+  compact();
+
+  /** @return{ number of packets stored }
+   */
+  size_t
+  size() const
+  {
+    return m_index.size();
+  }
+
+  /** @return{ size of the log file in bytes }
+   */
+  uint64_t
+  getLogSize() const
+  {
+    return m_logSize;
+  }
+
+private:
+  struct Record
+  {
+    uint64_t offset;
+    size_t length;
+    /// when the packet becomes stale, or TimePoint::max() if it has no FreshnessPeriod
+    time::system_clock::TimePoint staleTime;
+  };
+
+  typedef std::map<Name, Record> Index;
+
+  void
+  load();
+
+  void
+  openLog();
+
+  void
+  write(const Block& block);
+
+  void
+  flush();
+
+  static Block
+  makeStaleTime(const time::system_clock::TimePoint& staleTime);
+
+  void
+  eraseFromIndex(const Name& prefix, bool isPrefix);
+
+  /** @brief Reads a stored packet from the log
+   */
+  shared_ptr<const Data>
+  read(const Record& record);
+
+  /** @return{ the packet if it satisfies the Interest; otherwise a null shared_ptr }
+   */
+  shared_ptr<const Data>
+  match(const Interest& interest, const Index::value_type& entry);
+
+private:
+  std::string m_path;
+  Index m_index;
+  std::ofstream m_log;
+  /// reads packets appended after the log was mapped
+  std::ifstream m_tail;
+  uint64_t m_logSize;
+  boost::iostreams::mapped_file_source m_mapping;
+};
+
+} // namespace util
+} // namespace ndn
+
+#endif // NDN_UTIL_DISK_STORAGE_HPP
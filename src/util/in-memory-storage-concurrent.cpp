@@ -0,0 +1,256 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "in-memory-storage-concurrent.hpp"
+#include "in-memory-storage-clock.hpp"
+
+#include <mutex>
+
+namespace ndn {
+namespace util {
+
+/** @brief InMemoryStorageClock that can look up Data without marking it as referenced
+ *
+ *  Lookups that consult several shards mark only the Data eventually returned.
+ */
+class InMemoryStorageConcurrent::Shard : public InMemoryStorageClock
+{
+public:
+  explicit
+  Shard(size_t limit)
+    : InMemoryStorageClock(limit)
+    , m_isPeeking(false)
+  {
+  }
+
+  template<typename Key>
+  shared_ptr<const Data>
+  peek(const Key& key)
+  {
+    m_isPeeking = true;
+    shared_ptr<const Data> data = find(key);
+    m_isPeeking = false;
+    return data;
+  }
+
+  /** @brief Marks the entry of @p data as referenced, if it is still stored
+   */
+  void
+  markAccessed(const Data& data)
+  {
+    find(data.getFullName());
+  }
+
+protected:
+  virtual void
+  afterAccess(InMemoryStorageEntry* entry)
+  {
+    if (!m_isPeeking)
+      InMemoryStorageClock::afterAccess(entry);
+  }
+
+public:
+  std::mutex mutex;
+
+private:
+  bool m_isPeeking;
+};
+
+InMemoryStorageConcurrent::InMemoryStorageConcurrent(size_t limit, size_t nShards)
+{
+  BOOST_ASSERT(nShards > 0);
+
+  if (limit == std::numeric_limits<size_t>::max()) {
+    m_shardLimit = limit;
+  }
+  else {
+    m_shardLimit = std::max<size_t>(1, (limit + nShards - 1) / nShards);
+  }
+
+  m_shards.reserve(nShards);
+  for (size_t i = 0; i < nShards; ++i) {
+    m_shards.push_back(unique_ptr<Shard>(new Shard(m_shardLimit)));
+  }
+}
+
+InMemoryStorageConcurrent::~InMemoryStorageConcurrent()
+{
+}
+
+InMemoryStorageConcurrent::Shard&
+InMemoryStorageConcurrent::getShard(const Name& name) const
+{
+  return *m_shards[std::hash<Name>()(name) % m_shards.size()];
+}
+
+/** @return{ whether the last component of @p name is an implicit digest }
+ */
+static bool
+hasImplicitDigest(const Name& name)
+{
+  return !name.empty() && name.get(-1).isImplicitSha256Digest();
+}
+
+void
+InMemoryStorageConcurrent::insert(const Data& data)
+{
+  // decode deferred fields and compute the full name now, while the packet is not yet shared,
+  // so that const accessors never modify a packet returned by find()
+  data.getMetaInfo();
+  data.getSignature();
+  data.getFullName();
+
+  Shard& shard = getShard(data.getName());
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  shard.insert(data);
+}
+
+/** @return{ whether candidate is a better match for the Interest than the current best match }
+ */
+static bool
+isBetterMatch(const Interest& interest, const Data& candidate, const Data& best)
+{
+  if (interest.getChildSelector() <= 0) {
+    return candidate.getFullName() < best.getFullName();
+  }
+
+  size_t childPrefixSize = interest.getName().size() + 1;
+  int cmp = candidate.getFullName().compare(0, childPrefixSize,
+                                            best.getFullName(), 0, childPrefixSize);
+  if (cmp != 0) {
+    return cmp > 0;
+  }
+
+  // same child, leftmost Data within the child wins
+  return candidate.getFullName() < best.getFullName();
+}
+
+shared_ptr<const Data>
+InMemoryStorageConcurrent::find(const Interest& interest)
+{
+  const Name& name = interest.getName();
+  bool hasDigest = hasImplicitDigest(name);
+  Name dataName = hasDigest ? name.getPrefix(-1) : name;
+
+  // Data named exactly as the Interest precedes all other Data under the Interest Name,
+  // and only the shard of that name can contain it
+  Shard& exactShard = getShard(dataName);
+  Shard* bestShard = &exactShard;
+  shared_ptr<const Data> best;
+  {
+    std::lock_guard<std::mutex> lock(exactShard.mutex);
+    best = exactShard.peek(interest);
+
+    if (best != nullptr && best->getName() == dataName &&
+        (hasDigest || interest.getChildSelector() <= 0)) {
+      exactShard.markAccessed(*best);
+      return best;
+    }
+  }
+
+  for (const unique_ptr<Shard>& shard : m_shards) {
+    if (shard.get() == &exactShard)
+      continue;
+
+    shared_ptr<const Data> candidate;
+    {
+      std::lock_guard<std::mutex> lock(shard->mutex);
+      candidate = shard->peek(interest);
+    }
+
+    if (candidate != nullptr && (best == nullptr || isBetterMatch(interest, *candidate, *best))) {
+      best = candidate;
+      bestShard = shard.get();
+    }
+  }
+
+  if (best != nullptr) {
+    std::lock_guard<std::mutex> lock(bestShard->mutex);
+    bestShard->markAccessed(*best);
+  }
+  return best;
+}
+
+shared_ptr<const Data>
+InMemoryStorageConcurrent::find(const Name& name)
+{
+  // Data is stored in the shard of its name without the implicit digest
+  bool hasDigest = hasImplicitDigest(name);
+  Shard& exactShard = getShard(hasDigest ? name.getPrefix(-1) : name);
+  Shard* bestShard = &exactShard;
+  shared_ptr<const Data> best;
+  {
+    std::lock_guard<std::mutex> lock(exactShard.mutex);
+    best = exactShard.peek(name);
+
+    // a full name can only match Data in its own shard
+    if (hasDigest || (best != nullptr && best->getName() == name)) {
+      if (best != nullptr)
+        exactShard.markAccessed(*best);
+      return best;
+    }
+  }
+
+  for (const unique_ptr<Shard>& shard : m_shards) {
+    if (shard.get() == &exactShard)
+      continue;
+
+    shared_ptr<const Data> candidate;
+    {
+      std::lock_guard<std::mutex> lock(shard->mutex);
+      candidate = shard->peek(name);
+    }
+
+    if (candidate != nullptr && (best == nullptr || candidate->getFullName() < best->getFullName())) {
+      best = candidate;
+      bestShard = shard.get();
+    }
+  }
+
+  if (best != nullptr) {
+    std::lock_guard<std::mutex> lock(bestShard->mutex);
+    bestShard->markAccessed(*best);
+  }
+  return best;
+}
+
+void
+InMemoryStorageConcurrent::erase(const Name& prefix, const bool isPrefix)
+{
+  for (const unique_ptr<Shard>& shard : m_shards) {
+    std::lock_guard<std::mutex> lock(shard->mutex);
+    shard->erase(prefix, isPrefix);
+  }
+}
+
+size_t
+InMemoryStorageConcurrent::size() const
+{
+  size_t nPackets = 0;
+  for (const unique_ptr<Shard>& shard : m_shards) {
+    std::lock_guard<std::mutex> lock(shard->mutex);
+    nPackets += shard->size();
+  }
+  return nPackets;
+}
+
+} // namespace util
+} // namespace ndn
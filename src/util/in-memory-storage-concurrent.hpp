@@ -0,0 +1,117 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_UTIL_IN_MEMORY_STORAGE_CONCURRENT_HPP
+#define NDN_UTIL_IN_MEMORY_STORAGE_CONCURRENT_HPP
+
+#include "../common.hpp"
+#include "../interest.hpp"
+#include "../data.hpp"
+
+namespace ndn {
+namespace util {
+
+/** @brief Represents in-memory storage that can be shared between threads
+ *
+ *  Packets are distributed among shards by the hash of their names (without implicit
+ *  digest).  Each shard is an InMemoryStorageClock protected by its own mutex, so operations
+ *  on different shards proceed in parallel, and a cache hit only marks the entry as
+ *  referenced rather than reordering an LRU queue.
+ *
+ *  Lookups of Data named exactly as the Interest (or the Name) are served by a single shard.
+ *  Other lookups consult every shard and combine the results according to the child selector.
+ *
+ *  Data packets are fully decoded and their full names are computed on insertion, so that
+ *  packets returned by find() can be read from several threads at once.
+ */
+class InMemoryStorageConcurrent : noncopyable
+{
+public:
+  /** @param limit maximum number of packets in the whole storage; it is split evenly
+   *               between shards
+   *  @param nShards number of shards
+   */
+  explicit
+  InMemoryStorageConcurrent(size_t limit = std::numeric_limits<size_t>::max(),
+                            size_t nShards = 16);
+
+  ~InMemoryStorageConcurrent();
+
+  /** @brief Inserts a Data packet
+   *  @sa InMemoryStorage::insert
+   */
+  void
+  insert(const Data& data);
+
+  /** @brief Finds the best match Data for an Interest
+   *  @sa InMemoryStorage::find(const Interest&)
+   */
+  shared_ptr<const Data>
+  find(const Interest& interest);
+
+  /** @brief Finds the best match Data for a Name with or without the implicit digest
+   *  @sa InMemoryStorage::find(const Name&)
+   */
+  shared_ptr<const Data>
+  find(const Name& name);
+
+  /** @brief Deletes in-memory storage entries by prefix, or by full name if isPrefix is clear
+   *  @sa InMemoryStorage::erase
+   */
+  void
+  erase(const Name& prefix, const bool isPrefix = true);
+
+  /** @return{ number of packets stored in all shards }
+   */
+  size_t
+  size() const;
+
+  /** @return{ maximum number of packets that can be stored in each shard }
+   */
+  size_t
+  getShardLimit() const
+  {
+    return m_shardLimit;
+  }
+
+  /** @return{ number of shards }
+   */
+  size_t
+  getNShards() const
+  {
+    return m_shards.size();
+  }
+
+private:
+  class Shard;
+
+  Shard&
+  getShard(const Name& name) const;
+
+private:
+  size_t m_shardLimit;
+  std::vector<unique_ptr<Shard>> m_shards;
+};
+
+} // namespace util
+} // namespace ndn
+
+#endif // NDN_UTIL_IN_MEMORY_STORAGE_CONCURRENT_HPP
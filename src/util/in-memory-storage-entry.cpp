@@ -24,16 +24,54 @@
 namespace ndn {
 namespace util {
 
+/** @brief Approximate overhead of an entry: the entry itself, the Data object, and the nodes
+ *         of the in-memory storage and replacement policy indexes referencing it
+ */
+static const size_t ENTRY_OVERHEAD = sizeof(InMemoryStorageEntry) + sizeof(Data) + 128;
+
+InMemoryStorageEntry::InMemoryStorageEntry()
+  : m_hasStaleTime(false)
+  , m_memoryUsage(0)
+{
+}
+
 void
 InMemoryStorageEntry::release()
 {
   m_dataPacket.reset();
+  m_memoryUsage = 0;
 }
 
 void
 InMemoryStorageEntry::setData(const Data& data)
 {
   m_dataPacket = data.shared_from_this();
+  m_memoryUsage = estimateMemoryUsage(data);
+  m_arrivalTime = time::steady_clock::now();
+  m_hasStaleTime = false;
+}
+
+bool
+InMemoryStorageEntry::isFresh() const
+{
+  if (!m_hasStaleTime) {
+    time::milliseconds freshnessPeriod = m_dataPacket->getFreshnessPeriod();
+    if (freshnessPeriod >= time::milliseconds::zero()) {
+      m_staleTime = m_arrivalTime + freshnessPeriod;
+    }
+    else {
+      m_staleTime = time::steady_clock::TimePoint::max();
+    }
+    m_hasStaleTime = true;
+  }
+
+  return time::steady_clock::now() < m_staleTime;
+}
+
+size_t
+InMemoryStorageEntry::estimateMemoryUsage(const Data& data)
+{
+  return data.wireEncode().size() + ENTRY_OVERHEAD;
 }
 
 } // namespace util
@@ -25,6 +25,7 @@
 #include "../common.hpp"
 #include "../interest.hpp"
 #include "../data.hpp"
+#include "time.hpp"
 
 namespace ndn {
 namespace util {
@@ -34,6 +35,8 @@ namespace util {
 class InMemoryStorageEntry : noncopyable
 {
 public:
+  InMemoryStorageEntry();
+
   /** @brief Releases reference counts on shared objects
    */
   void
@@ -67,12 +70,41 @@ public:
 
 
   /** @brief Changes the content of in-memory storage entry
+   *
+   *  The entry becomes stale after FreshnessPeriod of the Data packet elapses,
+   *  or never if FreshnessPeriod is not specified.
    */
   void
   setData(const Data& data);
 
+  /** @brief Returns the number of bytes charged to the in-memory storage for this entry
+   */
+  size_t
+  getMemoryUsage() const
+  {
+    return m_memoryUsage;
+  }
+
+  /** @brief Estimates the number of bytes needed to store the Data packet: the size of its
+   *         wire encoding plus a fixed per-entry bookkeeping overhead
+   */
+  static size_t
+  estimateMemoryUsage(const Data& data);
+
+  /** @brief Returns whether the Data packet can still satisfy an Interest with MustBeFresh
+   *
+   *  FreshnessPeriod is read on the first call, so that inserting a lazily decoded Data
+   *  does not decode its MetaInfo.
+   */
+  bool
+  isFresh() const;
+
 private:
   shared_ptr<const Data> m_dataPacket;
+  time::steady_clock::TimePoint m_arrivalTime;
+  mutable time::steady_clock::TimePoint m_staleTime;
+  mutable bool m_hasStaleTime;
+  size_t m_memoryUsage;
 };
 
 } // namespace util
@@ -0,0 +1,126 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_UTIL_IN_MEMORY_STORAGE_GDS_HPP
+#define NDN_UTIL_IN_MEMORY_STORAGE_GDS_HPP
+
+#include "in-memory-storage.hpp"
+
+#include <boost/multi_index/member.hpp>
+#include <boost/multi_index_container.hpp>
+#include <boost/multi_index/ordered_index.hpp>
+#include <boost/multi_index/hashed_index.hpp>
+
+namespace ndn {
+namespace util {
+
+/** @brief Provides in-memory storage employing GreedyDual-Size replacement policy, which
+ *  prefers to keep small and recently used Data packets.
+ *
+ *  Each entry has a priority H = L + 1 / size, where size is the memory usage of the entry
+ *  and L is an inflation value.  H is recomputed whenever the entry is accessed.  The entry
+ *  with the lowest H is evicted first, and L is raised to its H, so entries that have not
+ *  been accessed for a while eventually lose to newly inserted ones.
+ *
+ *  This policy is most useful together with InMemoryStorage::setMemoryLimit.
+ */
+class InMemoryStorageGds : public InMemoryStorage
+{
+public:
+  explicit
+  InMemoryStorageGds(size_t limit = 10);
+
+  virtual
+  ~InMemoryStorageGds();
+
+NDN_CXX_PUBLIC_WITH_TESTS_ELSE_PROTECTED:
+  /** @brief Removes one Data packet from in-memory storage based on GreedyDual-Size,
+   *  i.e. evict the Data packet with the lowest priority
+   *  @return{ whether the Data was removed }
+   */
+  virtual bool
+  evictItem();
+
+  /** @brief Update the entry when the entry is returned by the find() function,
+   *  recompute its priority
+   */
+  virtual void
+  afterAccess(InMemoryStorageEntry* entry);
+
+  /** @brief Update the entry after a entry is successfully inserted, add it to the cleanupIndex
+   */
+  virtual void
+  afterInsert(InMemoryStorageEntry* entry);
+
+  /** @brief Update the entry or other data structures before a entry is successfully erased,
+   *  erase it from the cleanupIndex
+   */
+  virtual void
+  beforeErase(InMemoryStorageEntry* entry);
+
+private:
+  //binds priority and entry together
+  struct CleanupEntry
+  {
+    InMemoryStorageEntry* entry;
+    double priority;
+  };
+
+  double
+  computePriority(const InMemoryStorageEntry* entry) const
+  {
+    return m_inflation + 1.0 / entry->getMemoryUsage();
+  }
+
+private:
+  //multi_index_container to implement GreedyDual-Size
+  class byPriority;
+  class byEntity;
+
+  typedef boost::multi_index_container<
+    CleanupEntry,
+    boost::multi_index::indexed_by<
+
+      // by Entry itself
+      boost::multi_index::hashed_unique<
+        boost::multi_index::tag<byEntity>,
+        boost::multi_index::member<CleanupEntry, InMemoryStorageEntry*, &CleanupEntry::entry>
+      >,
+
+      // by priority (GreedyDual-Size)
+      boost::multi_index::ordered_non_unique<
+        boost::multi_index::tag<byPriority>,
+        boost::multi_index::member<CleanupEntry, double, &CleanupEntry::priority>,
+        std::less<double>
+      >
+
+    >
+  > CleanupIndex;
+
+  CleanupIndex m_cleanupIndex;
+  /// inflation value L, priority of the most recently evicted entry
+  double m_inflation;
+};
+
+} // namespace util
+} // namespace ndn
+
+#endif // NDN_UTIL_IN_MEMORY_STORAGE_GDS_HPP
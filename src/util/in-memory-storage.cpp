@@ -26,9 +26,102 @@
 
 #include "../security/signature-sha256-with-rsa.hpp"
 
+#include <boost/lexical_cast.hpp>
+
 namespace ndn {
 namespace util {
 
+/** @return{ negative, zero, or positive if component is less than, equal to, or greater than
+ *           the implicit digest of the entry }
+ */
+static int
+compareWithDigest(const name::Component& component, const InMemoryStorageEntry& entry)
+{
+  // implicit digest is computed only if the type of the component does not decide the order
+  if (component.type() != tlv::ImplicitSha256DigestComponent) {
+    return component.type() < tlv::ImplicitSha256DigestComponent ? -1 : 1;
+  }
+
+  return component.compare(entry.getFullName().get(-1));
+}
+
+/** @brief Compares name with the full name of the entry
+ */
+static int
+compareWithFullName(const Name& name, const InMemoryStorageEntry& entry)
+{
+  const Name& entryName = entry.getName();
+  size_t count = std::min(name.size(), entryName.size());
+
+  int cmp = name.compare(0, count, entryName, 0, count);
+  if (cmp != 0)
+    return cmp;
+
+  if (name.size() <= entryName.size()) // name is a proper prefix of the full name
+    return -1;
+
+  cmp = compareWithDigest(name.get(count), entry);
+  if (cmp != 0)
+    return cmp;
+
+  return name.size() > count + 1 ? 1 : 0;
+}
+
+/** @brief Compares full names of the entries
+ */
+static int
+compareFullNames(const InMemoryStorageEntry& lhs, const InMemoryStorageEntry& rhs)
+{
+  const Name& lhsName = lhs.getName();
+  const Name& rhsName = rhs.getName();
+  if (lhsName.size() > rhsName.size())
+    return -compareFullNames(rhs, lhs);
+
+  size_t count = lhsName.size();
+  int cmp = lhsName.compare(0, count, rhsName, 0, count);
+  if (cmp != 0)
+    return cmp;
+
+  if (count == rhsName.size()) // same names, only implicit digests differ
+    return lhs.getFullName().get(-1).compare(rhs.getFullName().get(-1));
+
+  cmp = -compareWithDigest(rhsName.get(count), lhs);
+  if (cmp != 0)
+    return cmp;
+
+  return -1;
+}
+
+/** @return{ component of the full name of the entry that follows the first prefixSize ones }
+ */
+static const name::Component&
+getChildComponent(const InMemoryStorageEntry& entry, size_t prefixSize)
+{
+  if (entry.getName().size() > prefixSize)
+    return entry.getName().get(prefixSize);
+  else
+    return entry.getFullName().get(-1);
+}
+
+bool
+InMemoryStorage::FullNameLess::operator()(const InMemoryStorageEntry* lhs,
+                                          const InMemoryStorageEntry* rhs) const
+{
+  return compareFullNames(*lhs, *rhs) < 0;
+}
+
+bool
+InMemoryStorage::FullNameLess::operator()(const Name& lhs, const InMemoryStorageEntry* rhs) const
+{
+  return compareWithFullName(lhs, *rhs) < 0;
+}
+
+bool
+InMemoryStorage::FullNameLess::operator()(const InMemoryStorageEntry* lhs, const Name& rhs) const
+{
+  return compareWithFullName(rhs, *lhs) > 0;
+}
+
 InMemoryStorage::const_iterator::const_iterator(const Data* ptr, const Cache* cache,
                                                 Cache::index<byFullName>::type::iterator it)
   : m_ptr(ptr)
@@ -86,6 +179,8 @@ InMemoryStorage::const_iterator::operator!=(const const_iterator& rhs)
 InMemoryStorage::InMemoryStorage(size_t limit)
   : m_limit(limit)
   , m_nPackets(0)
+  , m_memoryLimit(std::numeric_limits<size_t>::max())
+  , m_memoryUsage(0)
 {
   // TODO consider a more suitable initial value
   m_capacity = 10;
@@ -145,14 +240,38 @@ InMemoryStorage::setCapacity(size_t capacity)
   BOOST_ASSERT(size() + m_freeEntries.size() == m_capacity);
 }
 
+void
+InMemoryStorage::setMemoryLimit(size_t nMaxBytes)
+{
+  //the new limit takes effect only once the stored packets fit under it
+  while (m_memoryUsage > nMaxBytes) {
+    if (!evictItem()) {
+      throw Error("Cannot reduce the memory limit of the in-memory storage to " +
+                  boost::lexical_cast<std::string>(nMaxBytes) + " bytes, " +
+                  boost::lexical_cast<std::string>(m_memoryUsage) + " bytes are still in use");
+    }
+  }
+
+  m_memoryLimit = nMaxBytes;
+}
+
 void
 InMemoryStorage::insert(const Data& data)
 {
-  //check if identical Data/Name already exists
-  Cache::index<byFullName>::type::iterator it = m_cache.get<byFullName>().find(data.getFullName());
-  if (it != m_cache.get<byFullName>().end())
+  //packet that can never fit into the memory limit is rejected before anything is evicted
+  size_t memoryUsage = InMemoryStorageEntry::estimateMemoryUsage(data);
+  if (memoryUsage > m_memoryLimit)
     return;
 
+  //check if identical Data/Name already exists
+  //(identical wire encoding implies identical implicit digest, so no digest is calculated here)
+  const Block& wire = data.wireEncode();
+  Cache::index<byName>::type::iterator it, last;
+  for (std::tie(it, last) = m_cache.get<byName>().equal_range(data.getName()); it != last; ++it) {
+    if ((*it)->getData().wireEncode() == wire)
+      return;
+  }
+
   //if full, double the capacity
   bool doesReachLimit = (getLimit() == getCapacity());
   if (isFull() && !doesReachLimit) {
@@ -163,7 +282,15 @@ InMemoryStorage::insert(const Data& data)
 
   //if full and reach limitation of the capacity, employ replacement policy
   if (isFull() && doesReachLimit) {
-    evictItem();
+    if (!evictItem())
+      return;
+  }
+
+  //if over the memory limit, employ replacement policy until the packet fits
+  while (m_memoryUsage + memoryUsage > m_memoryLimit) {
+    if (!evictItem()) {
+      return;
+    }
   }
 
   //insert to cache
@@ -173,6 +300,7 @@ InMemoryStorage::insert(const Data& data)
   m_freeEntries.pop();
   m_nPackets++;
   entry->setData(data);
+  m_memoryUsage += entry->getMemoryUsage();
   m_cache.insert(entry);
 
   //let derived class do something with the entry
@@ -184,14 +312,18 @@ InMemoryStorage::find(const Name& name)
 {
   Cache::index<byFullName>::type::iterator it = m_cache.get<byFullName>().lower_bound(name);
 
-  //if not found, return null
-  if (it == m_cache.get<byFullName>().end()) {
-    return shared_ptr<const Data>();
-  }
+  //if Data with exactly this name exists, the lower_bound is the leftmost of them and
+  //no implicit digest needs to be computed for the prefix check
+  if (m_cache.get<byName>().count(name) == 0) {
+    //if not found, return null
+    if (it == m_cache.get<byFullName>().end()) {
+      return shared_ptr<const Data>();
+    }
 
-  //if the given name is not the prefix of the lower_bound, return null
-  if (!name.isPrefixOf((*it)->getFullName())) {
-    return shared_ptr<const Data>();
+    //if the given name is not the prefix of the lower_bound, return null
+    if (!name.isPrefixOf((*it)->getFullName())) {
+      return shared_ptr<const Data>();
+    }
   }
 
   afterAccess(*it);
@@ -201,29 +333,21 @@ InMemoryStorage::find(const Name& name)
 shared_ptr<const Data>
 InMemoryStorage::find(const Interest& interest)
 {
+  const Name& name = interest.getName();
+
   //if the interest contains implicit digest, it is possible to directly locate a packet.
-  Cache::index<byFullName>::type::iterator it = m_cache.get<byFullName>()
-                                                    .find(interest.getName());
+  if (!name.empty() && name.get(-1).isImplicitSha256Digest()) {
+    Cache::index<byFullName>::type::iterator it = m_cache.get<byFullName>().find(name);
 
-  //if a packet is located by its full name, it must be the packet to return.
-  if (it != m_cache.get<byFullName>().end()) {
-    return ((*it)->getData()).shared_from_this();
+    //if a packet is located by its full name, it must be the packet to return.
+    if (it != m_cache.get<byFullName>().end() && satisfies(interest, **it)) {
+      return ((*it)->getData()).shared_from_this();
+    }
   }
 
   //if the packet is not discovered by last step, either the packet is not in the storage or
   //the interest doesn't contains implicit digest.
-  it = m_cache.get<byFullName>().lower_bound(interest.getName());
-
-  if (it == m_cache.get<byFullName>().end()) {
-    return shared_ptr<const Data>();
-  }
-
-
-  //to locate the element that has a just smaller name than the interest's
-  if (it != m_cache.get<byFullName>().begin())
-    it--;
-
-  InMemoryStorageEntry* ret = selectChild(interest, it);
+  InMemoryStorageEntry* ret = selectChild(interest);
   if (ret != 0) {
     //let derived class do something with the entry
     afterAccess(ret);
@@ -235,93 +359,127 @@ InMemoryStorage::find(const Interest& interest)
 }
 
 InMemoryStorageEntry*
-InMemoryStorage::selectChild(const Interest& interest,
-                             Cache::index<byFullName>::type::iterator startingPoint) const
+InMemoryStorage::selectChild(const Interest& interest) const
 {
-  BOOST_ASSERT(startingPoint != m_cache.get<byFullName>().end());
-
-  if (startingPoint != m_cache.get<byFullName>().begin())
-    {
-      BOOST_ASSERT((*startingPoint)->getFullName() < interest.getName());
-    }
+  const Name& prefix = interest.getName();
+  const Exclude& exclude = interest.getExclude();
+  const Cache::index<byFullName>::type& index = m_cache.get<byFullName>();
 
   bool hasLeftmostSelector = (interest.getChildSelector() <= 0);
-  bool hasRightmostSelector = !hasLeftmostSelector;
 
   if (hasLeftmostSelector)
     {
-      if (interest.matchesData((*startingPoint)->getData()))
+      // Data named exactly as Interest Name precede all other Data under that prefix
+      // in canonical order, and can be found without walking the ordered index
+      InMemoryStorageEntry* match = 0;
+      Cache::index<byName>::type::const_iterator it, last;
+      for (std::tie(it, last) = m_cache.get<byName>().equal_range(prefix); it != last; ++it)
         {
-          return *startingPoint;
+          if (satisfies(interest, **it) && (match == 0 || FullNameLess()(*it, match)))
+            {
+              match = *it;
+            }
+        }
+
+      if (match != 0)
+        {
+          return match;
         }
     }
 
-  //iterate to the right
-  Cache::index<byFullName>::type::iterator rightmost = startingPoint;
-  if (startingPoint != m_cache.get<byFullName>().end())
-    {
-      Cache::index<byFullName>::type::iterator rightmostCandidate = startingPoint;
-      Name currentChildPrefix("");
+  Cache::index<byFullName>::type::iterator first = index.lower_bound(prefix);
+  Cache::index<byFullName>::type::iterator last = prefix.empty() ?
+                                                  index.end() :
+                                                  index.lower_bound(prefix.getSuccessor());
 
-      while (true)
+  if (hasLeftmostSelector)
+    {
+      Cache::index<byFullName>::type::iterator it = first;
+      while (it != last)
         {
-          ++rightmostCandidate;
-
-          bool isInBoundaries = (rightmostCandidate != m_cache.get<byFullName>().end());
-          bool isInPrefix = false;
-          if (isInBoundaries)
+          if (!exclude.empty())
             {
-              isInPrefix = interest.getName().isPrefixOf((*rightmostCandidate)->getFullName());
+              const name::Component& child = getChildComponent(**it, prefix.size());
+              if (exclude.isExcluded(child))
+                {
+                  // skip the whole excluded child
+                  do {
+                    ++it;
+                  } while (it != last && getChildComponent(**it, prefix.size()) == child);
+                  continue;
+                }
             }
 
-          if (isInPrefix)
+          if (satisfies(interest, **it))
             {
-              if (interest.matchesData((*rightmostCandidate)->getData()))
-                {
-                  if (hasLeftmostSelector)
-                    {
-                      return *rightmostCandidate;
-                    }
-
-                  if (hasRightmostSelector)
-                    {
-                      // get prefix which is one component longer than Interest name
-                      const Name& childPrefix = (*rightmostCandidate)->getFullName()
-                                                  .getPrefix(interest.getName().size() + 1);
-
-                      if (currentChildPrefix.empty() || (childPrefix != currentChildPrefix))
-                        {
-                          currentChildPrefix = childPrefix;
-                          rightmost = rightmostCandidate;
-                        }
-                    }
-                }
+              return *it;
             }
-          else
-            break;
+          ++it;
         }
+      return 0;
     }
 
-  if (rightmost != startingPoint)
+  // visit children from the rightmost one, returning the leftmost match within the child
+  Cache::index<byFullName>::type::iterator childEnd = last;
+  while (childEnd != first)
     {
-      return *rightmost;
+      Cache::index<byFullName>::type::iterator childBegin = childEnd;
+      --childBegin;
+
+      const name::Component& child = getChildComponent(**childBegin, prefix.size());
+      while (childBegin != first)
+        {
+          Cache::index<byFullName>::type::iterator previous = childBegin;
+          --previous;
+          if (getChildComponent(**previous, prefix.size()) != child)
+            break;
+          childBegin = previous;
+        }
+
+      if (!exclude.isExcluded(child))
+        {
+          InMemoryStorageEntry* match = selectLeftmost(interest, childBegin, childEnd);
+          if (match != 0)
+            {
+              return match;
+            }
+        }
+
+      childEnd = childBegin;
     }
 
-  if (hasRightmostSelector) // if rightmost was not found, try starting point
+  return 0;
+}
+
+InMemoryStorageEntry*
+InMemoryStorage::selectLeftmost(const Interest& interest,
+                                Cache::index<byFullName>::type::iterator first,
+                                Cache::index<byFullName>::type::iterator last) const
+{
+  for (; first != last; ++first)
     {
-      if (interest.matchesData((*startingPoint)->getData()))
+      if (satisfies(interest, **first))
         {
-          return *startingPoint;
+          return *first;
         }
     }
-
   return 0;
 }
 
+bool
+InMemoryStorage::satisfies(const Interest& interest, const InMemoryStorageEntry& entry)
+{
+  if (interest.getMustBeFresh() && !entry.isFresh())
+    return false;
+
+  return interest.matchesData(entry.getData());
+}
+
 InMemoryStorage::Cache::iterator
 InMemoryStorage::freeEntry(Cache::iterator it)
 {
   //push the *empty* entry into mem pool
+  m_memoryUsage -= (*it)->getMemoryUsage();
   (*it)->release();
   m_freeEntries.push(*it);
   m_nPackets--;
@@ -31,6 +31,7 @@
 #include <boost/multi_index/member.hpp>
 #include <boost/multi_index_container.hpp>
 #include <boost/multi_index/ordered_index.hpp>
+#include <boost/multi_index/hashed_index.hpp>
 #include <boost/multi_index/sequenced_index.hpp>
 #include <boost/multi_index/identity.hpp>
 #include <boost/multi_index/mem_fun.hpp>
@@ -46,8 +47,28 @@ namespace util {
 class InMemoryStorage : noncopyable
 {
 public:
+  /** @brief Orders entries by full name, computing implicit digests only when needed
+   *
+   *  The implicit digest of an entry is calculated only when its name ties with the
+   *  other operand up to the position of the digest, so entries with distinct names
+   *  never trigger SHA-256 computation.  Names are also accepted as compatible keys.
+   */
+  class FullNameLess
+  {
+  public:
+    bool
+    operator()(const InMemoryStorageEntry* lhs, const InMemoryStorageEntry* rhs) const;
+
+    bool
+    operator()(const Name& lhs, const InMemoryStorageEntry* rhs) const;
+
+    bool
+    operator()(const InMemoryStorageEntry* lhs, const Name& rhs) const;
+  };
+
   //multi_index_container to implement storage
   class byFullName;
+  class byName;
 
   typedef boost::multi_index_container<
     InMemoryStorageEntry*,
@@ -56,9 +77,16 @@ public:
       // by Full Name
       boost::multi_index::ordered_unique<
         boost::multi_index::tag<byFullName>,
+        boost::multi_index::identity<InMemoryStorageEntry*>,
+        FullNameLess
+      >,
+
+      // by Name (without implicit digest), for exact lookups
+      boost::multi_index::hashed_non_unique<
+        boost::multi_index::tag<byName>,
         boost::multi_index::const_mem_fun<InMemoryStorageEntry, const Name&,
-                                          &InMemoryStorageEntry::getFullName>,
-        std::less<Name>
+                                          &InMemoryStorageEntry::getName>,
+        std::hash<Name>
       >
 
     >
@@ -107,6 +135,12 @@ public:
     Error() : std::runtime_error("Cannot reduce the capacity of the in-memory storage!")
     {
     }
+
+    explicit
+    Error(const std::string& what)
+      : std::runtime_error(what)
+    {
+    }
   };
 
   explicit
@@ -184,6 +218,35 @@ public:
     return m_nPackets;
   }
 
+  /** @brief Sets the maximum number of bytes the stored packets may occupy
+   *
+   *  Memory usage of a packet is estimated by InMemoryStorageEntry::estimateMemoryUsage.
+   *  Packets are evicted according to the replacement policy until the usage falls under
+   *  the new limit.  When inserting, packets are evicted until the new packet fits, and
+   *  a packet that does not fit even then is not inserted.
+   *
+   *  @throws Error if the usage cannot be brought under the limit; the previous limit
+   *          then stays in effect
+   */
+  void
+  setMemoryLimit(size_t nMaxBytes);
+
+  /** @return{ maximum number of bytes the stored packets may occupy }
+   */
+  size_t
+  getMemoryLimit() const
+  {
+    return m_memoryLimit;
+  }
+
+  /** @return{ number of bytes occupied by the stored packets }
+   */
+  size_t
+  getMemoryUsage() const
+  {
+    return m_memoryUsage;
+  }
+
   /** @brief Returns begin iterator of the in-memory storage ordering by
    *  name with digest
    *
@@ -276,22 +339,30 @@ NDN_CXX_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   freeEntry(Cache::iterator it);
 
   /** @brief Implements child selector (leftmost, rightmost, undeclared).
-   *  Operates on the first layer of a skip list.
    *
-   *  startingPoint must be less than Interest Name.
-   *  startingPoint can be equal to Interest Name only
-   *  when the item is in the begin() position.
-   *
-   *  Iterates toward greater Names, terminates when application cache entry falls out of Interest
-   *  prefix. When childSelector = leftmost, returns first application cache entry that satisfies
-   *  other selectors. When childSelector = rightmost, it goes till the end, and returns application
-   *  cache entry that satisfies other selectors. Returned application cache entry is the leftmost
-   *  child of the rightmost child.
+   *  Operates on the entries under Interest Name.  Children (entries sharing the component
+   *  right after Interest Name) are visited as a whole: a child excluded by the Interest is
+   *  skipped with a single index lookup, and with childSelector = rightmost children are
+   *  visited from the right, so only the entries of the children that are actually examined
+   *  are matched against the Interest.  Returned application cache entry is the leftmost
+   *  entry of the leftmost (or rightmost) child that has an entry satisfying the selectors.
    *  @return{ the best match, if any; otherwise 0 }
    */
   InMemoryStorageEntry*
-  selectChild(const Interest& interest,
-              Cache::index<byFullName>::type::iterator startingPoint) const;
+  selectChild(const Interest& interest) const;
+
+  /** @brief Finds the leftmost entry in [first, last) that satisfies the Interest
+   *  @return{ the match, if any; otherwise 0 }
+   */
+  InMemoryStorageEntry*
+  selectLeftmost(const Interest& interest,
+                 Cache::index<byFullName>::type::iterator first,
+                 Cache::index<byFullName>::type::iterator last) const;
+
+  /** @return{ whether the entry satisfies the Interest, including MustBeFresh selector }
+   */
+  static bool
+  satisfies(const Interest& interest, const InMemoryStorageEntry& entry);
 
 private:
   Cache m_cache;
@@ -301,6 +372,10 @@ private:
   size_t m_capacity;
   /// current number of packets in in-memory storage
   size_t m_nPackets;
+  /// user defined maximum number of bytes occupied by packets in the in-memory storage
+  size_t m_memoryLimit;
+  /// current number of bytes occupied by packets in the in-memory storage
+  size_t m_memoryUsage;
   /// memory pool
   std::stack<InMemoryStorageEntry*> m_freeEntries;
 };
@@ -53,6 +53,8 @@
 #include "../security/key-chain.hpp"
 
 #include "concepts.hpp"
+#include "scheduler.hpp"
+#include "scheduler-scoped-event-id.hpp"
 
 namespace ndn {
 
@@ -62,6 +64,12 @@ class KeyChain;
 namespace util {
 
 /** \brief provides a publisher of Notification Stream
+ *
+ *  By default, each notification is published as its own Data packet.  In batching mode,
+ *  notifications are collected and published together in one Data packet, whose Content
+ *  contains the encoded notifications one after another; the packet is signed once.
+ *  NotificationSubscriber accepts both forms.
+ *
  *  \sa http://redmine.named-data.net/projects/nfd/wiki/Notification
  */
 template<typename Notification>
@@ -75,6 +83,8 @@ public:
     , m_prefix(prefix)
     , m_keyChain(keyChain)
     , m_sequenceNo(0)
+    , m_maxBatchSize(0)
+    , m_batchSize(0)
   {
   }
 
@@ -83,14 +93,83 @@ public:
   {
   }
 
+  /** \brief enable batching mode
+   *
+   *  A batch is published when the encoded notifications would exceed \p maxBatchSize octets,
+   *  or when \p maxDelay has passed since the first notification in the batch was posted,
+   *  whichever comes first.  A notification larger than \p maxBatchSize is published alone.
+   *
+   *  \param maxBatchSize maximum total size of encoded notifications in one Data packet;
+   *                      zero disables batching
+   *  \param maxDelay maximum time a notification is held before being published
+   *  \note Notifications held at destruction are discarded; call .flush() beforehand.
+   */
+  void
+  setBatching(size_t maxBatchSize, const time::nanoseconds& maxDelay)
+  {
+    this->flush();
+    m_maxBatchSize = maxBatchSize;
+    m_maxDelay = maxDelay;
+
+    // a stream that never batches does not need a timer
+    if (m_maxBatchSize > 0 && m_scheduler == nullptr) {
+      m_scheduler.reset(new Scheduler(m_face.getIoService()));
+      m_flushEvent.reset(new scheduler::ScopedEventId(*m_scheduler));
+    }
+  }
+
   void
   postNotification(const Notification& notification)
+  {
+    if (m_maxBatchSize == 0) {
+      this->publish(notification.wireEncode());
+      return;
+    }
+
+    Block block = notification.wireEncode();
+    if (!m_batch.empty() && m_batchSize + block.size() > m_maxBatchSize)
+      this->flush();
+
+    if (m_batch.empty()) {
+      m_batchSize = 0;
+      *m_flushEvent = m_scheduler->scheduleEvent(m_maxDelay,
+                                                 bind(&NotificationStream::flush, this));
+    }
+    m_batch.push_back(block);
+    m_batchSize += block.size();
+
+    if (m_batchSize >= m_maxBatchSize)
+      this->flush();
+  }
+
+  /** \brief publish held notifications immediately
+   */
+  void
+  flush()
+  {
+    if (m_flushEvent != nullptr)
+      m_flushEvent->cancel();
+    if (m_batch.empty())
+      return;
+
+    Block content(tlv::Content);
+    for (const Block& block : m_batch)
+      content.push_back(block);
+    content.encode();
+    m_batch.clear();
+
+    this->publish(content);
+  }
+
+private:
+  void
+  publish(const Block& content)
   {
     Name dataName = m_prefix;
     dataName.appendSequenceNumber(m_sequenceNo);
 
     shared_ptr<Data> data = make_shared<Data>(dataName);
-    data->setContent(notification.wireEncode());
+    data->setContent(content);
     data->setFreshnessPeriod(time::seconds(1));
 
     m_keyChain.sign(*data);
@@ -104,6 +183,13 @@ private:
   const Name m_prefix;
   KeyChain& m_keyChain;
   uint64_t m_sequenceNo;
+
+  size_t m_maxBatchSize;
+  time::nanoseconds m_maxDelay;
+  std::vector<Block> m_batch;
+  size_t m_batchSize;
+  unique_ptr<Scheduler> m_scheduler; ///< created when batching is first enabled
+  unique_ptr<scheduler::ScopedEventId> m_flushEvent;
 };
 
 } // namespace util
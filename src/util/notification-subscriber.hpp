@@ -53,10 +53,19 @@
 #include "concepts.hpp"
 #include <boost/concept_check.hpp>
 
+#include <map>
+
 namespace ndn {
 namespace util {
 
 /** \brief provides a subscriber of Notification Stream
+ *
+ *  After the initial Interest discovers the latest sequence number, the subscriber keeps up
+ *  to .getPipelineSize() Interests for consecutive sequence numbers outstanding.
+ *  Notifications are delivered in sequence number order.  A Data packet may carry several
+ *  notifications (see NotificationStream batching mode); they are delivered in the order
+ *  they appear in the Content.
+ *
  *  \sa http://redmine.named-data.net/projects/nfd/wiki/Notification
  *  \tparam Notification type of Notification item, appears in payload of Data packets
  */
@@ -76,9 +85,10 @@ public:
     : m_face(face)
     , m_prefix(prefix)
     , m_isRunning(false)
-    , m_lastSequenceNo(std::numeric_limits<uint64_t>::max())
-    , m_lastInterestId(0)
+    , m_lastSequenceNo(NO_SEQUENCE)
+    , m_initialInterestId(0)
     , m_interestLifetime(interestLifetime)
+    , m_pipelineSize(1)
   {
   }
 
@@ -97,6 +107,28 @@ public:
     return m_interestLifetime;
   }
 
+  /** \return maximum number of outstanding Interests for subsequent notifications
+   */
+  size_t
+  getPipelineSize() const
+  {
+    return m_pipelineSize;
+  }
+
+  /** \brief set maximum number of outstanding Interests for subsequent notifications
+   *
+   *  A pipeline larger than 1 allows receiving notifications that are published faster than
+   *  one per round-trip time.  The new size takes effect when the next notification arrives.
+   *  \throw std::invalid_argument pipeline size is zero
+   */
+  void
+  setPipelineSize(size_t pipelineSize)
+  {
+    if (pipelineSize == 0)
+      throw std::invalid_argument("pipeline size must be positive");
+    m_pipelineSize = pipelineSize;
+  }
+
   bool
   isRunning() const
   {
@@ -126,9 +158,7 @@ public:
       return;
     m_isRunning = false;
 
-    if (m_lastInterestId != 0)
-      m_face.removePendingInterest(m_lastInterestId);
-    m_lastInterestId = 0;
+    this->cancelInterests();
   }
 
 public: // subscriptions
@@ -146,40 +176,76 @@ public: // subscriptions
   signal::Signal<NotificationSubscriber, Data> onDecodeError;
 
 private:
+  static const uint64_t NO_SEQUENCE = std::numeric_limits<uint64_t>::max();
+
   void
   sendInitialInterest()
   {
     if (this->shouldStop())
       return;
 
+    this->cancelInterests();
+
     shared_ptr<Interest> interest = make_shared<Interest>(m_prefix);
     interest->setMustBeFresh(true);
     interest->setChildSelector(1);
     interest->setInterestLifetime(getInterestLifetime());
 
-    m_lastInterestId = m_face.expressInterest(*interest,
-                         bind(&NotificationSubscriber<Notification>::afterReceiveData, this, _2),
-                         bind(&NotificationSubscriber<Notification>::afterTimeout, this));
+    m_initialInterestId = m_face.expressInterest(*interest,
+                            bind(&NotificationSubscriber<Notification>::afterReceiveData,
+                                 this, _2, NO_SEQUENCE),
+                            bind(&NotificationSubscriber<Notification>::afterTimeout,
+                                 this, NO_SEQUENCE));
   }
 
   void
-  sendNextInterest()
+  sendInterest(uint64_t sequenceNo)
+  {
+    Name nextName = m_prefix;
+    nextName.appendSequenceNumber(sequenceNo);
+
+    shared_ptr<Interest> interest = make_shared<Interest>(nextName);
+    interest->setInterestLifetime(getInterestLifetime());
+
+    m_pendingInterests[sequenceNo] = m_face.expressInterest(*interest,
+                                       bind(&NotificationSubscriber<Notification>::afterReceiveData,
+                                            this, _2, sequenceNo),
+                                       bind(&NotificationSubscriber<Notification>::afterTimeout,
+                                            this, sequenceNo));
+  }
+
+  /** \brief request notifications up to m_pipelineSize after the last delivered one
+   *
+   *  Sequence numbers that are neither outstanding nor received are requested, including
+   *  those whose Interest has timed out before.
+   */
+  void
+  fillPipeline()
   {
     if (this->shouldStop())
       return;
 
-    BOOST_ASSERT(m_lastSequenceNo !=
-                 std::numeric_limits<uint64_t>::max());// overflow or missing initial reply
+    BOOST_ASSERT(m_lastSequenceNo != NO_SEQUENCE); // overflow or missing initial reply
 
-    Name nextName = m_prefix;
-    nextName.appendSequenceNumber(m_lastSequenceNo + 1);
+    uint64_t end = m_lastSequenceNo + m_pipelineSize;
+    for (uint64_t sequenceNo = m_lastSequenceNo + 1; sequenceNo <= end; ++sequenceNo) {
+      if (m_pendingInterests.count(sequenceNo) == 0 && m_reorderBuffer.count(sequenceNo) == 0)
+        this->sendInterest(sequenceNo);
+    }
+  }
 
-    shared_ptr<Interest> interest = make_shared<Interest>(nextName);
-    interest->setInterestLifetime(getInterestLifetime());
+  void
+  cancelInterests()
+  {
+    if (m_initialInterestId != 0)
+      m_face.removePendingInterest(m_initialInterestId);
+    m_initialInterestId = 0;
 
-    m_lastInterestId = m_face.expressInterest(*interest,
-                         bind(&NotificationSubscriber<Notification>::afterReceiveData, this, _2),
-                         bind(&NotificationSubscriber<Notification>::afterTimeout, this));
+    for (const auto& pending : m_pendingInterests)
+      m_face.removePendingInterest(pending.second);
+    m_pendingInterests.clear();
+
+    m_reorderBuffer.clear();
   }
 
   /** \brief Check if the subscriber is or should be stopped.
@@ -197,16 +263,33 @@ private:
     return false;
   }
 
+  /** \param requestedSequenceNo sequence number in the Interest, or NO_SEQUENCE if this is
+   *                              a reply to the initial Interest
+   */
   void
-  afterReceiveData(const Data& data)
+  afterReceiveData(const Data& data, uint64_t requestedSequenceNo)
   {
+    if (requestedSequenceNo == NO_SEQUENCE)
+      m_initialInterestId = 0;
+    else
+      m_pendingInterests.erase(requestedSequenceNo);
+
     if (this->shouldStop())
       return;
 
-    Notification notification;
+    uint64_t sequenceNo = 0;
+    std::vector<Notification> notifications;
     try {
-      m_lastSequenceNo = data.getName().get(-1).toSequenceNumber();
-      notification.wireDecode(data.getContent().blockFromValue());
+      sequenceNo = data.getName().get(-1).toSequenceNumber();
+
+      const Block& content = data.getContent();
+      content.parse();
+      if (content.elements().empty())
+        throw tlv::Error("Notification is missing");
+
+      notifications.resize(content.elements().size());
+      for (size_t i = 0; i < notifications.size(); ++i)
+        notifications[i].wireDecode(content.elements()[i]);
     }
     catch (tlv::Error&) {
       this->onDecodeError(data);
@@ -214,17 +297,77 @@ private:
       return;
     }
 
-    this->onNotification(notification);
+    if (requestedSequenceNo == NO_SEQUENCE) {
+      m_lastSequenceNo = sequenceNo;
+      this->deliver(notifications);
+    }
+    else if (sequenceNo == m_lastSequenceNo + 1) {
+      m_lastSequenceNo = sequenceNo;
+      this->deliver(notifications);
+      this->deliverBuffered();
+    }
+    else if (sequenceNo > m_lastSequenceNo + 1) {
+      m_reorderBuffer[sequenceNo].swap(notifications);
+    }
 
-    this->sendNextInterest();
+    this->fillPipeline();
   }
 
   void
-  afterTimeout()
+  deliver(const std::vector<Notification>& notifications)
   {
+    for (const Notification& notification : notifications) {
+      if (this->shouldStop())
+        return;
+      this->onNotification(notification);
+    }
+  }
+
+  /** \brief deliver buffered notifications that are now in order
+   */
+  void
+  deliverBuffered()
+  {
+    while (!m_reorderBuffer.empty() &&
+           m_reorderBuffer.begin()->first == m_lastSequenceNo + 1) {
+      std::vector<Notification> notifications;
+      notifications.swap(m_reorderBuffer.begin()->second);
+      m_reorderBuffer.erase(m_reorderBuffer.begin());
+      ++m_lastSequenceNo;
+      this->deliver(notifications);
+    }
+  }
+
+  void
+  afterTimeout(uint64_t requestedSequenceNo)
+  {
+    if (requestedSequenceNo == NO_SEQUENCE)
+      m_initialInterestId = 0;
+    else
+      m_pendingInterests.erase(requestedSequenceNo);
+
     if (this->shouldStop())
       return;
 
+    if (requestedSequenceNo != NO_SEQUENCE) {
+      if (requestedSequenceNo <= m_lastSequenceNo) // skipped
+        return;
+      if (requestedSequenceNo > m_lastSequenceNo + 1) {
+        // a notification further ahead has not been published yet; it is requested again
+        // once the pipeline advances, while the timeout of the next notification decides
+        // whether the stream is rediscovered
+        return;
+      }
+    }
+
+    if (!m_reorderBuffer.empty()) {
+      // the next notification is lost, skip to the notifications received after it
+      m_lastSequenceNo = m_reorderBuffer.begin()->first - 1;
+      this->deliverBuffered();
+      this->fillPipeline();
+      return;
+    }
+
     this->onTimeout();
 
     this->sendInitialInterest();
@@ -234,11 +377,17 @@ private:
   Face& m_face;
   Name m_prefix;
   bool m_isRunning;
-  uint64_t m_lastSequenceNo;
-  const PendingInterestId* m_lastInterestId;
+  uint64_t m_lastSequenceNo; ///< sequence number of the last delivered notification
+  const PendingInterestId* m_initialInterestId;
+  std::map<uint64_t, const PendingInterestId*> m_pendingInterests;
+  std::map<uint64_t, std::vector<Notification>> m_reorderBuffer; ///< received out of order
   time::milliseconds m_interestLifetime;
+  size_t m_pipelineSize;
 };
 
+template<typename Notification>
+const uint64_t NotificationSubscriber<Notification>::NO_SEQUENCE;
+
 } // namespace util
 } // namespace ndn
 
@@ -0,0 +1,373 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "scheduler-timer-wheel.hpp"
+
+#include <algorithm>
+
+namespace ndn {
+namespace util {
+namespace scheduler {
+
+const size_t TimerWheel::SLOT_BITS;
+const size_t TimerWheel::N_SLOTS;
+const size_t TimerWheel::N_LEVELS;
+const uint8_t TimerWheel::LEVEL_EXPIRED;
+const size_t TimerWheel::BITMAP_WORDS;
+
+static const uint64_t SLOT_MASK = TimerWheel::N_SLOTS - 1;
+
+/// events further in the future are parked in the top wheel and redistributed periodically
+static const uint64_t MAX_DELTA = static_cast<uint64_t>(1) <<
+                                  (TimerWheel::SLOT_BITS * TimerWheel::N_LEVELS);
+
+static void
+initList(TimerWheel::Link& list)
+{
+  list.prev = list.next = &list;
+}
+
+static bool
+isListEmpty(const TimerWheel::Link& list)
+{
+  return list.next == &list;
+}
+
+static void
+linkBack(TimerWheel::Link& list, TimerWheel::Link* link)
+{
+  link->prev = list.prev;
+  link->next = &list;
+  list.prev->next = link;
+  list.prev = link;
+}
+
+static TimerWheel::Link*
+popFront(TimerWheel::Link& list)
+{
+  TimerWheel::Link* link = list.next;
+  list.next = link->next;
+  link->next->prev = &list;
+  return link;
+}
+
+static size_t
+findFirstSet(uint64_t word)
+{
+  BOOST_ASSERT(word != 0);
+#if defined(__GNUC__)
+  return __builtin_ctzll(word);
+#else
+  size_t pos = 0;
+  while ((word & 1) == 0) {
+    word >>= 1;
+    ++pos;
+  }
+  return pos;
+#endif
+}
+
+TimerWheel::Record::Record()
+  : tick(0)
+  , generation(0)
+  , level(LEVEL_EXPIRED)
+  , slot(0)
+{
+  prev = next = nullptr;
+}
+
+TimerWheel::TimerWheel(const time::nanoseconds& tickDuration)
+  : m_tickDuration(tickDuration)
+  , m_tick(0)
+  , m_size(0)
+  , m_freeRecords(nullptr)
+{
+  BOOST_ASSERT(m_tickDuration > time::nanoseconds::zero());
+
+  for (size_t level = 0; level < N_LEVELS; ++level) {
+    for (size_t slot = 0; slot < N_SLOTS; ++slot)
+      initList(m_slots[level][slot]);
+    std::fill_n(m_occupied[level], BITMAP_WORDS, 0);
+  }
+  initList(m_expired);
+
+  m_tick = toTick(time::steady_clock::now(), false);
+}
+
+uint64_t
+TimerWheel::toTick(const time::steady_clock::TimePoint& time, bool roundUp) const
+{
+  time::nanoseconds::rep ns = time.time_since_epoch().count();
+  if (ns <= 0)
+    return 0;
+
+  uint64_t tick = static_cast<uint64_t>(ns) / m_tickDuration.count();
+  if (roundUp && static_cast<uint64_t>(ns) % m_tickDuration.count() != 0)
+    ++tick;
+  return tick;
+}
+
+time::steady_clock::TimePoint
+TimerWheel::toTimePoint(uint64_t tick) const
+{
+  return time::steady_clock::TimePoint(time::nanoseconds(tick * m_tickDuration.count()));
+}
+
+TimerWheel::Record*
+TimerWheel::allocate()
+{
+  if (m_freeRecords == nullptr) {
+    m_pool.emplace_back();
+    return &m_pool.back();
+  }
+
+  Record* record = static_cast<Record*>(m_freeRecords);
+  m_freeRecords = m_freeRecords->next;
+  return record;
+}
+
+void
+TimerWheel::release(Record* record)
+{
+  ++record->generation;
+  record->event = nullptr;
+  record->level = LEVEL_EXPIRED;
+  record->next = m_freeRecords;
+  m_freeRecords = record;
+  --m_size;
+}
+
+TimerWheel::Record*
+TimerWheel::insert(const time::nanoseconds& after, const function<void()>& event)
+{
+  time::steady_clock::TimePoint now = time::steady_clock::now();
+  if (m_size == 0) {
+    // nothing is pending, so the wheel can be moved forward without processing
+    m_tick = std::max(m_tick, toTick(now, false));
+  }
+
+  Record* record = allocate();
+  record->scheduledTime = now + after;
+  record->tick = toTick(record->scheduledTime, true);
+  record->event = event;
+  ++m_size;
+
+  if (record->tick <= m_tick) {
+    record->level = LEVEL_EXPIRED;
+    linkBack(m_expired, record);
+  }
+  else {
+    place(record);
+  }
+  return record;
+}
+
+void
+TimerWheel::place(Record* record)
+{
+  BOOST_ASSERT(record->tick >= m_tick);
+
+  uint64_t delta = record->tick - m_tick;
+  size_t level = 0;
+  while (level + 1 < N_LEVELS && delta >= (static_cast<uint64_t>(1) << (SLOT_BITS * (level + 1))))
+    ++level;
+
+  uint64_t tick = record->tick;
+  if (delta >= MAX_DELTA) {
+    // re-placed with the real tick when this slot is cascaded
+    tick = m_tick + MAX_DELTA - 1;
+  }
+
+  size_t slot = (tick >> (SLOT_BITS * level)) & SLOT_MASK;
+  record->level = level;
+  record->slot = slot;
+  linkBack(m_slots[level][slot], record);
+  m_occupied[level][slot / 64] |= static_cast<uint64_t>(1) << (slot % 64);
+}
+
+void
+TimerWheel::unlink(Record* record)
+{
+  record->prev->next = record->next;
+  record->next->prev = record->prev;
+
+  if (record->level != LEVEL_EXPIRED &&
+      isListEmpty(m_slots[record->level][record->slot])) {
+    m_occupied[record->level][record->slot / 64] &=
+      ~(static_cast<uint64_t>(1) << (record->slot % 64));
+  }
+}
+
+void
+TimerWheel::erase(Record* record)
+{
+  unlink(record);
+  release(record);
+}
+
+void
+TimerWheel::clear()
+{
+  for (size_t level = 0; level < N_LEVELS; ++level) {
+    for (size_t slot = 0; slot < N_SLOTS; ++slot) {
+      while (!isListEmpty(m_slots[level][slot]))
+        release(static_cast<Record*>(popFront(m_slots[level][slot])));
+    }
+    std::fill_n(m_occupied[level], BITMAP_WORDS, 0);
+  }
+
+  while (!isListEmpty(m_expired))
+    release(static_cast<Record*>(popFront(m_expired)));
+}
+
+void
+TimerWheel::detachSlot(size_t level, size_t slot, Link& list)
+{
+  Link& slotList = m_slots[level][slot];
+  if (isListEmpty(slotList))
+    return;
+
+  // splice the whole slot to the end of list
+  slotList.next->prev = list.prev;
+  list.prev->next = slotList.next;
+  slotList.prev->next = &list;
+  list.prev = slotList.prev;
+
+  initList(slotList);
+  m_occupied[level][slot / 64] &= ~(static_cast<uint64_t>(1) << (slot % 64));
+}
+
+size_t
+TimerWheel::findOccupiedSlot(size_t level, size_t start) const
+{
+  for (size_t offset = 0; offset < N_SLOTS; ) {
+    size_t slot = (start + offset) & SLOT_MASK;
+    uint64_t word = m_occupied[level][slot / 64] >> (slot % 64);
+    if (word != 0)
+      return offset + findFirstSet(word);
+    offset += 64 - slot % 64;
+  }
+  return N_SLOTS;
+}
+
+uint64_t
+TimerWheel::getNextActionTick() const
+{
+  uint64_t next = std::numeric_limits<uint64_t>::max();
+  for (size_t level = 0; level < N_LEVELS; ++level) {
+    uint64_t base = (m_tick >> (SLOT_BITS * level)) + 1;
+    size_t offset = findOccupiedSlot(level, base & SLOT_MASK);
+    if (offset < N_SLOTS)
+      next = std::min(next, (base + offset) << (SLOT_BITS * level));
+  }
+  return next;
+}
+
+void
+TimerWheel::processTick()
+{
+  // a slot of level L is due when the lower SLOT_BITS*L bits of the tick are all zero
+  size_t level = 0;
+  while (level + 1 < N_LEVELS &&
+         (m_tick & ((static_cast<uint64_t>(1) << (SLOT_BITS * (level + 1))) - 1)) == 0)
+    ++level;
+
+  Link list;
+  for (; level > 0; --level) {
+    initList(list);
+    detachSlot(level, (m_tick >> (SLOT_BITS * level)) & SLOT_MASK, list);
+    while (!isListEmpty(list))
+      place(static_cast<Record*>(popFront(list)));
+  }
+
+  initList(list);
+  detachSlot(0, m_tick & SLOT_MASK, list);
+  if (isListEmpty(list))
+    return;
+
+  m_batch.clear();
+  for (Link* link = list.next; link != &list; link = link->next)
+    m_batch.push_back(static_cast<Record*>(link));
+
+  std::stable_sort(m_batch.begin(), m_batch.end(),
+                   [] (const Record* a, const Record* b) {
+                     return a->scheduledTime < b->scheduledTime;
+                   });
+
+  for (Record* record : m_batch) {
+    record->level = LEVEL_EXPIRED;
+    linkBack(m_expired, record);
+  }
+}
+
+void
+TimerWheel::advance(const time::steady_clock::TimePoint& now)
+{
+  uint64_t nowTick = toTick(now, false);
+  while (m_tick < nowTick) {
+    uint64_t next = getNextActionTick();
+    if (next > nowTick) {
+      m_tick = nowTick;
+      break;
+    }
+    m_tick = next;
+    processTick();
+  }
+}
+
+bool
+TimerWheel::popExpired(function<void()>& event)
+{
+  if (isListEmpty(m_expired))
+    return false;
+
+  Record* record = static_cast<Record*>(m_expired.next);
+  unlink(record);
+  event.swap(record->event);
+  release(record);
+  return true;
+}
+
+time::steady_clock::TimePoint
+TimerWheel::getDeadline(const Record* record) const
+{
+  if (record->level == LEVEL_EXPIRED)
+    return time::steady_clock::TimePoint::min();
+
+  return toTimePoint(record->tick);
+}
+
+time::steady_clock::TimePoint
+TimerWheel::getNextDeadline() const
+{
+  if (!isListEmpty(m_expired))
+    return time::steady_clock::TimePoint::min();
+
+  uint64_t next = getNextActionTick();
+  if (next == std::numeric_limits<uint64_t>::max())
+    return time::steady_clock::TimePoint::max();
+
+  return toTimePoint(next);
+}
+
+} // namespace scheduler
+} // namespace util
+} // namespace ndn
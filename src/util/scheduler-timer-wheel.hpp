@@ -0,0 +1,194 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_UTIL_SCHEDULER_TIMER_WHEEL_HPP
+#define NDN_UTIL_SCHEDULER_TIMER_WHEEL_HPP
+
+#include "../common.hpp"
+#include "time.hpp"
+
+#include <deque>
+#include <vector>
+
+namespace ndn {
+namespace util {
+namespace scheduler {
+
+/**
+ * @brief Hierarchical timing wheel that keeps the events of a Scheduler
+ *
+ * Time is divided into ticks of a fixed duration.  Each of the N_LEVELS wheels has N_SLOTS
+ * slots; an event that expires within N_SLOTS ticks is kept in a slot of the first wheel, an
+ * event that expires within N_SLOTS^2 ticks in a slot of the second wheel, and so on.  When a
+ * lower wheel completes a revolution, events in the next slot of the upper wheel are
+ * redistributed to lower wheels.  Inserting and erasing an event take constant time, and
+ * event records are recycled instead of being freed.
+ *
+ * Expiration times are rounded up to a whole tick, so an event never expires early.  Events
+ * that expire in the same tick are expired in the order of their exact expiration time.
+ */
+class TimerWheel : noncopyable
+{
+public:
+  struct Link
+  {
+    Link* prev;
+    Link* next;
+  };
+
+  /**
+   * @brief Record of a scheduled event
+   *
+   * @p generation is incremented every time the record is released, so that a holder of a
+   *    stale pointer can detect that the record has been reused.
+   */
+  struct Record : public Link
+  {
+    Record();
+
+    time::steady_clock::TimePoint scheduledTime;
+    uint64_t tick;
+    uint64_t generation;
+    uint8_t level;
+    uint8_t slot;
+    function<void()> event;
+  };
+
+  explicit
+  TimerWheel(const time::nanoseconds& tickDuration);
+
+  /**
+   * @brief Insert an event that expires @p after from now
+   * @return record of the event, which stays valid until the event is erased or expired
+   */
+  Record*
+  insert(const time::nanoseconds& after, const function<void()>& event);
+
+  /**
+   * @brief Erase a pending event
+   */
+  void
+  erase(Record* record);
+
+  /**
+   * @brief Erase all pending events
+   */
+  void
+  clear();
+
+  /**
+   * @brief Move all events that have expired by @p now to the list of expired events
+   */
+  void
+  advance(const time::steady_clock::TimePoint& now);
+
+  /**
+   * @brief Take the first expired event
+   * @param[out] event callback of the expired event
+   * @return false if there is no expired event
+   */
+  bool
+  popExpired(function<void()>& event);
+
+  /**
+   * @brief Get the time by which advance() must be called for @p record to expire on time
+   */
+  time::steady_clock::TimePoint
+  getDeadline(const Record* record) const;
+
+  /**
+   * @brief Get the time by which advance() must be called next
+   * @return TimePoint::max() if there are no pending events
+   */
+  time::steady_clock::TimePoint
+  getNextDeadline() const;
+
+  size_t
+  size() const
+  {
+    return m_size;
+  }
+
+public:
+  static const size_t SLOT_BITS = 8;
+  static const size_t N_SLOTS = 1 << SLOT_BITS;
+  static const size_t N_LEVELS = 4;
+
+private:
+  static const uint8_t LEVEL_EXPIRED = N_LEVELS;
+  static const size_t BITMAP_WORDS = N_SLOTS / 64;
+
+  uint64_t
+  toTick(const time::steady_clock::TimePoint& time, bool roundUp) const;
+
+  time::steady_clock::TimePoint
+  toTimePoint(uint64_t tick) const;
+
+  Record*
+  allocate();
+
+  void
+  release(Record* record);
+
+  void
+  place(Record* record);
+
+  void
+  unlink(Record* record);
+
+  void
+  detachSlot(size_t level, size_t slot, Link& list);
+
+  void
+  processTick();
+
+  /**
+   * @brief Get the next tick at which a slot must be cascaded or expired
+   */
+  uint64_t
+  getNextActionTick() const;
+
+  /**
+   * @brief Find the first occupied slot of @p level at or after @p start, in circular order
+   * @return offset from @p start, or N_SLOTS if all slots of the level are empty
+   */
+  size_t
+  findOccupiedSlot(size_t level, size_t start) const;
+
+private:
+  time::nanoseconds m_tickDuration;
+  uint64_t m_tick; ///< last processed tick
+  size_t m_size;
+
+  Link m_slots[N_LEVELS][N_SLOTS];
+  uint64_t m_occupied[N_LEVELS][BITMAP_WORDS];
+  Link m_expired;
+
+  std::deque<Record> m_pool;
+  Link* m_freeRecords;
+  std::vector<Record*> m_batch;
+};
+
+} // namespace scheduler
+} // namespace util
+} // namespace ndn
+
+#endif // NDN_UTIL_SCHEDULER_TIMER_WHEEL_HPP
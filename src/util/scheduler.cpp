@@ -22,6 +22,7 @@
 #include "common.hpp"
 
 #include "scheduler.hpp"
+#include "scheduler-timer-wheel.hpp"
 
 namespace ndn {
 namespace util {
@@ -32,6 +33,16 @@ struct EventIdImpl
   EventIdImpl(const Scheduler::EventQueue::iterator& event)
     : m_event(event)
     , m_isValid(true)
+    , m_record(nullptr)
+    , m_generation(0)
+  {
+  }
+
+  explicit
+  EventIdImpl(TimerWheel::Record* record)
+    : m_isValid(true)
+    , m_record(record)
+    , m_generation(record->generation)
   {
   }
 
@@ -44,9 +55,21 @@ struct EventIdImpl
   bool
   isValid() const
   {
+    if (m_record != nullptr)
+      return m_record->generation == m_generation;
+
     return m_isValid;
   }
 
+  /**
+   * \return record of an event scheduled with BACKEND_TIMER_WHEEL
+   */
+  TimerWheel::Record*
+  getRecord() const
+  {
+    return m_record;
+  }
+
   operator const Scheduler::EventQueue::iterator&() const
   {
     return m_event;
@@ -62,6 +85,9 @@ struct EventIdImpl
 private:
   Scheduler::EventQueue::iterator m_event;
   bool m_isValid;
+
+  TimerWheel::Record* m_record;
+  uint64_t m_generation; ///< record generation at scheduling, changed once the record is released
 };
 
 Scheduler::EventInfo::EventInfo(const time::nanoseconds& after,
@@ -90,10 +116,18 @@ Scheduler::EventInfo::expiresFromNow() const
 }
 
 
-Scheduler::Scheduler(boost::asio::io_service& ioService)
+Scheduler::Scheduler(boost::asio::io_service& ioService, Backend backend,
+                     const time::nanoseconds& tick)
   : m_scheduledEvent(m_events.end())
   , m_deadlineTimer(ioService)
   , m_isEventExecuting(false)
+  , m_wheelDeadline(time::steady_clock::TimePoint::max())
+{
+  if (backend == BACKEND_TIMER_WHEEL)
+    m_wheel.reset(new TimerWheel(tick));
+}
+
+Scheduler::~Scheduler()
 {
 }
 
@@ -101,6 +135,15 @@ EventId
 Scheduler::scheduleEvent(const time::nanoseconds& after,
                          const Event& event)
 {
+  if (static_cast<bool>(m_wheel)) {
+    TimerWheel::Record* record = m_wheel->insert(after, event);
+    EventId eventId = ndn::make_shared<EventIdImpl>(record);
+
+    if (!m_isEventExecuting)
+      armWheelTimer(m_wheel->getDeadline(record));
+    return eventId;
+  }
+
   EventQueue::iterator i = m_events.insert(EventInfo(after, event));
 
   // On OSX 10.9, boost, and C++03 the following doesn't work without ndn::
@@ -127,6 +170,12 @@ Scheduler::cancelEvent(const EventId& eventId)
   if (!static_cast<bool>(eventId) || !eventId->isValid())
     return; // event already fired or cancelled
 
+  if (static_cast<bool>(m_wheel)) {
+    // the timer is left armed; an early wakeup finds nothing to do and re-arms it
+    m_wheel->erase(eventId->getRecord());
+    return;
+  }
+
   if (static_cast<EventQueue::iterator>(*eventId) != m_scheduledEvent) {
     m_events.erase(*eventId);
     eventId->invalidate();
@@ -155,6 +204,11 @@ Scheduler::cancelEvent(const EventId& eventId)
 void
 Scheduler::cancelAllEvents()
 {
+  if (static_cast<bool>(m_wheel)) {
+    m_wheel->clear();
+    m_wheelDeadline = time::steady_clock::TimePoint::max();
+  }
+
   m_events.clear();
   m_deadlineTimer.cancel();
 }
@@ -196,6 +250,48 @@ Scheduler::onEvent(const boost::system::error_code& error)
   m_isEventExecuting = false;
 }
 
+void
+Scheduler::armWheelTimer(const time::steady_clock::TimePoint& deadline)
+{
+  if (deadline >= m_wheelDeadline)
+    return;
+
+  m_wheelDeadline = deadline;
+
+  time::steady_clock::TimePoint now = time::steady_clock::now();
+  if (deadline > now)
+    m_deadlineTimer.expires_from_now(deadline - now);
+  else
+    m_deadlineTimer.expires_from_now(time::nanoseconds::zero());
+  m_deadlineTimer.async_wait(bind(&Scheduler::onWheelEvent, this, _1));
+}
+
+void
+Scheduler::onWheelEvent(const boost::system::error_code& error)
+{
+  if (error) // e.g., cancelled
+    {
+      return;
+    }
+
+  m_isEventExecuting = true;
+
+  // an event scheduled without delay by an executing event gets its tick rounded up, so it
+  // normally runs on the next tick; only one scheduled exactly on a tick boundary is expired
+  // already and runs in this round
+  m_wheel->advance(time::steady_clock::now());
+  Event event;
+  while (m_wheel->popExpired(event))
+    {
+      event();
+    }
+
+  m_isEventExecuting = false;
+
+  m_wheelDeadline = time::steady_clock::TimePoint::max();
+  armWheelTimer(m_wheel->getNextDeadline());
+}
+
 
 } // namespace scheduler
 } // namespace util
@@ -32,6 +32,7 @@ namespace util {
 namespace scheduler {
 
 struct EventIdImpl; ///< \brief Private storage of information about the event
+class TimerWheel;
 /**
  * \brief Opaque type (shared_ptr) representing ID of the scheduled event
  */
@@ -45,7 +46,35 @@ class Scheduler
 public:
   typedef function<void()> Event;
 
-  Scheduler(boost::asio::io_service& ioService);
+  /**
+   * \brief Data structure that keeps scheduled events
+   */
+  enum Backend {
+    /**
+     * \brief Events are ordered by exact expiration time
+     *
+     * Scheduling and cancelling an event takes O(log n) time.
+     */
+    BACKEND_ORDERED_SET,
+    /**
+     * \brief Events are kept in a hierarchical timing wheel
+     *
+     * Scheduling and cancelling an event takes O(1) time, and event records are reused.
+     * Expiration times are rounded up to a multiple of the wheel tick.  This backend suits
+     * applications that schedule and cancel large numbers of short timers.
+     */
+    BACKEND_TIMER_WHEEL
+  };
+
+  /**
+   * \param ioService io_service on which the events are executed
+   * \param backend data structure that keeps scheduled events
+   * \param tick granularity of expiration times with BACKEND_TIMER_WHEEL
+   */
+  Scheduler(boost::asio::io_service& ioService, Backend backend = BACKEND_ORDERED_SET,
+            const time::nanoseconds& tick = time::milliseconds(1));
+
+  ~Scheduler();
 
   /**
    * \brief Schedule one time event after the specified delay
@@ -70,6 +99,12 @@ private:
   void
   onEvent(const boost::system::error_code& code);
 
+  void
+  armWheelTimer(const time::steady_clock::TimePoint& deadline);
+
+  void
+  onWheelEvent(const boost::system::error_code& code);
+
 private:
   struct EventInfo
   {
@@ -105,6 +140,9 @@ private:
   monotonic_deadline_timer m_deadlineTimer;
 
   bool m_isEventExecuting;
+
+  unique_ptr<TimerWheel> m_wheel; ///< nullptr unless BACKEND_TIMER_WHEEL is used
+  time::steady_clock::TimePoint m_wheelDeadline; ///< expiration of m_deadlineTimer
 };
 
 } // namespace scheduler
@@ -28,35 +28,45 @@ namespace signal {
 BOOST_CONCEPT_ASSERT((boost::EqualityComparable<Connection>));
 
 Connection::Connection()
+  : m_index(0)
+  , m_generation(0)
 {
 }
 
-Connection::Connection(weak_ptr<function<void()>> disconnect)
-  : m_disconnect(disconnect)
+Connection::Connection(weak_ptr<detail::SlotTable> slots, size_t index, uint64_t generation)
+  : m_slots(slots)
+  , m_index(index)
+  , m_generation(generation)
 {
 }
 
 void
 Connection::disconnect()
 {
-  shared_ptr<function<void()>> f = m_disconnect.lock();
-  if (f != nullptr) {
-    (*f)();
+  shared_ptr<detail::SlotTable> slots = m_slots.lock();
+  if (slots != nullptr) {
+    slots->disconnect(m_index, m_generation);
   }
 }
 
 bool
 Connection::isConnected() const
 {
-  return !m_disconnect.expired();
+  shared_ptr<detail::SlotTable> slots = m_slots.lock();
+  return slots != nullptr && slots->isConnected(m_index, m_generation);
 }
 
 bool
 Connection::operator==(const Connection& other) const
 {
-  shared_ptr<function<void()>> f1 = m_disconnect.lock();
-  shared_ptr<function<void()>> f2 = other.m_disconnect.lock();
-  return f1 == f2;
+  bool isConnected1 = this->isConnected();
+  bool isConnected2 = other.isConnected();
+  if (!isConnected1 || !isConnected2) {
+    return isConnected1 == isConnected2;
+  }
+
+  return m_slots.lock() == other.m_slots.lock() &&
+         m_index == other.m_index && m_generation == other.m_generation;
 }
 
 bool
@@ -28,6 +28,34 @@ namespace ndn {
 namespace util {
 namespace signal {
 
+namespace detail {
+
+/** \brief (implementation detail) slots of a Signal, as seen by Connection
+ *
+ *  A slot is identified by its index and by the generation of the index,
+ *  which changes every time the slot is disconnected.
+ */
+class SlotTable
+{
+public:
+  virtual
+  ~SlotTable()
+  {
+  }
+
+  /** \brief disconnects the handler in a slot, if the slot is still in given generation
+   */
+  virtual void
+  disconnect(size_t index, uint64_t generation) = 0;
+
+  /** \return whether the slot is still in given generation and connected
+   */
+  virtual bool
+  isConnected(size_t index, uint64_t generation) const = 0;
+};
+
+} // namespace detail
+
 /** \brief represents a connection to a signal
  *  \note This type is copyable. Any copy can be used to disconnect.
  */
@@ -63,23 +91,24 @@ public:
   operator!=(const Connection& other) const;
 
 private:
-  /** \param disconnect weak_ptr to a function that disconnects the handler
+  /** \param slots slot table of the Signal
+   *  \param index index of the slot
+   *  \param generation generation of the slot
    */
-  explicit
-  Connection(weak_ptr<function<void()>> disconnect);
+  Connection(weak_ptr<detail::SlotTable> slots, size_t index, uint64_t generation);
 
   template<typename Owner, typename ...TArgs>
   friend class Signal;
 
 private:
-  /** \note The only shared_ptr to the disconnect function is stored in Signal<..>::Slot,
-   *        and will be destructed if the handler is disconnected (through another Connection
-   *        instance) or the Signal is destructed.
-   *        Connection needs a weak_ptr instead of a shared_ptr to the disconnect function,
-   *        because the disconnect function is bound with an iterator to the Slot,
-   *        which is invalidated when the Slot is erased.
+  /** \note The only shared_ptr to the slot table is owned by the Signal,
+   *        so the table expires when the Signal is destructed.
+   *        The generation guards against a slot which has been disconnected
+   *        and then reused for another handler.
    */
-  weak_ptr<function<void()>> m_disconnect;
+  weak_ptr<detail::SlotTable> m_slots;
+  size_t m_index;
+  uint64_t m_generation;
 };
 
 } // namespace signal
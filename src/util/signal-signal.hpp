@@ -23,7 +23,9 @@
 #define NDN_UTIL_SIGNAL_SIGNAL_HPP
 
 #include "signal-connection.hpp"
-#include <list>
+
+#include <deque>
+#include <type_traits>
 
 namespace ndn {
 namespace util {
@@ -31,6 +33,96 @@ namespace signal {
 
 class DummyExtraArg;
 
+namespace detail {
+
+/** \brief (implementation detail) type-erased signal handler
+ *
+ *  A function object of up to INLINE_SIZE bytes is stored within the handler itself;
+ *  a larger one is allocated on the heap.
+ *  The handler is never moved after a function object is assigned, so the function object
+ *  does not need to be movable.
+ */
+template<typename ...TArgs>
+class InlineHandler : noncopyable
+{
+public:
+  static const size_t INLINE_SIZE = 4 * sizeof(void*);
+
+  InlineHandler()
+    : m_invoke(nullptr)
+    , m_destroy(nullptr)
+  {
+  }
+
+  ~InlineHandler()
+  {
+    this->reset();
+  }
+
+  template<typename F>
+  void
+  assign(F&& f)
+  {
+    typedef typename std::decay<F>::type Functor;
+    this->reset();
+    this->construct<Functor>(std::forward<F>(f),
+                             std::integral_constant<bool, sizeof(Functor) <= INLINE_SIZE &&
+                                                    alignof(Functor) <= alignof(Storage)>());
+  }
+
+  void
+  reset()
+  {
+    if (m_destroy != nullptr) {
+      m_destroy(&m_storage);
+    }
+    m_invoke = nullptr;
+    m_destroy = nullptr;
+  }
+
+  void
+  operator()(const TArgs&... args)
+  {
+    m_invoke(&m_storage, args...);
+  }
+
+private:
+  typedef typename std::aligned_storage<INLINE_SIZE>::type Storage;
+
+  template<typename Functor, typename F>
+  void
+  construct(F&& f, std::true_type isInline)
+  {
+    new (&m_storage) Functor(std::forward<F>(f));
+    m_invoke = [] (void* storage, const TArgs&... args) {
+      (*static_cast<Functor*>(storage))(args...);
+    };
+    m_destroy = [] (void* storage) {
+      static_cast<Functor*>(storage)->~Functor();
+    };
+  }
+
+  template<typename Functor, typename F>
+  void
+  construct(F&& f, std::false_type isInline)
+  {
+    *reinterpret_cast<Functor**>(&m_storage) = new Functor(std::forward<F>(f));
+    m_invoke = [] (void* storage, const TArgs&... args) {
+      (**static_cast<Functor**>(storage))(args...);
+    };
+    m_destroy = [] (void* storage) {
+      delete *static_cast<Functor**>(storage);
+    };
+  }
+
+private:
+  Storage m_storage;
+  void (*m_invoke)(void* storage, const TArgs&... args);
+  void (*m_destroy)(void* storage);
+};
+
+} // namespace detail
+
 /** \brief provides a lightweight signal / event system
  *
  *  To declare a signal:
@@ -42,6 +134,10 @@ class DummyExtraArg;
  *  To emit a signal from owner:
  *    this->signalName(arg1, arg2);
  *
+ *  Connecting and disconnecting do not allocate memory once the signal has grown to its
+ *  working set of connections, unless the handler is a function object too large to be
+ *  stored inline.
+ *
  *  \tparam Owner the signal owner class; only this class can emit the signal
  *  \tparam TArgs types of signal arguments
  *  \sa signal-emit.hpp allows owner's derived classes to emit signals
@@ -60,11 +156,19 @@ public: // API for anyone
 
   /** \brief connects a handler to the signal
    *  \note If invoked from a handler, the new handler won't receive the current emitted signal.
-   *  \warning The handler is permitted to disconnect itself, but it must ensure its validity.
+   *  \note The handler is permitted to disconnect itself.
    */
   Connection
   connect(const Handler& handler);
 
+  /** \brief connects a function object to the signal
+   *
+   *  This overload stores the function object without wrapping it in a Handler.
+   */
+  template<typename F>
+  Connection
+  connect(F&& handler);
+
   /** \brief connects a single-shot handler to the signal
    *
    *  After the handler is executed once, it is automatically disconnected.
@@ -72,6 +176,10 @@ public: // API for anyone
   Connection
   connectSingleShot(const Handler& handler);
 
+  template<typename F>
+  Connection
+  connectSingleShot(F&& handler);
+
 private: // API for owner
   /** \retval true if there is no connection
    */
@@ -109,152 +217,328 @@ private: // API for owner
 #endif
 
 private: // internal implementation
-  typedef Signal<Owner, TArgs...> Self;
-  struct Slot;
+  static const size_t NONE = static_cast<size_t>(-1);
 
-  /** \brief stores slots
-   *  \note std::list is used because iterators must not be invalidated
-   *        when other slots are added or removed
-   */
-  typedef std::list<Slot> SlotList;
-
-  /** \brief stores a handler function, and a function to disconnect this handler
+  /** \brief stores a handler function
    */
   struct Slot
   {
+    Slot()
+      : generation(0)
+      , isConnected(false)
+      , isSingleShot(false)
+      , prev(NONE)
+      , next(NONE)
+    {
+    }
+
     /** \brief the handler function who will receive emitted signals
      */
-    Handler handler;
+    detail::InlineHandler<TArgs...> handler;
 
-    /** \brief the disconnect function which will disconnect this handler
-     *
-     *  This is .disconnect method bound with the iterator to this slot.
-     *
-     *  This is the only shared_ptr to this function object.
-     *  Connection class has a weak_ptr which references the same function object.
-     *  When the slot is removed or the signal is destructed, this function object would be
-     *  destructed, and the related Connections cannot disconnect this slot again.
+    /** \brief incremented when the slot is disconnected, which invalidates its Connections
+     */
+    uint64_t generation;
+
+    bool isConnected;
+
+    bool isSingleShot;
+
+    /** \brief neighbours in the list of slots in connection order, or in the free list
      */
-    shared_ptr<function<void()>> disconnect;
+    size_t prev;
+    size_t next;
   };
 
   /** \brief stores slots
+   *
+   *  Slots are linked in connection order, so that handlers are executed in the order
+   *  they were connected.  Disconnected slots are kept in a free list and reused.
+   *  \note std::deque is used because references must not be invalidated
+   *        when a slot is added during signal emission
    */
-  SlotList m_slots;
+  class Slots : public detail::SlotTable
+  {
+  public:
+    Slots();
 
-  /** \brief is a signal handler executing?
-   */
-  bool m_isExecuting;
+    size_t
+    allocate(bool isSingleShot);
 
-  /** \brief iterator to current executing slot
-   *  \note This field is meaningful when isExecuting==true
-   */
-  typename SlotList::iterator m_currentSlot;
+    /** \brief disconnects the handler in a slot
+     *
+     *  During signal emission, the executing slot is released after its handler returns.
+     */
+    virtual void
+    disconnect(size_t index, uint64_t generation) NDN_CXX_DECL_OVERRIDE;
+
+    virtual bool
+    isConnected(size_t index, uint64_t generation) const NDN_CXX_DECL_OVERRIDE;
+
+    void
+    emit(const TArgs&... args);
+
+  private:
+    void
+    disconnect(size_t index);
 
-  /** \brief disconnects the handler in a slot
+    void
+    release(size_t index);
+
+  public:
+    std::deque<Slot> m_slots;
+    size_t m_head;
+    size_t m_tail;
+    size_t m_freeList;
+    size_t m_nConnected;
+
+    /** \brief is a signal handler executing?
+     */
+    bool m_isExecuting;
+
+    /** \brief index of current executing slot
+     *  \note This field is meaningful when isExecuting==true
+     */
+    size_t m_currentSlot;
+  };
+
+  template<typename F>
+  Connection
+  doConnect(F&& handler, bool isSingleShot);
+
+  /** \brief slot table, created upon the first connection
+   *
+   *  This is the only shared_ptr to the table.
+   *  Connection has a weak_ptr, so that it has no effect after the Signal is destructed.
    */
-  void
-  disconnect(typename SlotList::iterator it);
+  shared_ptr<Slots> m_slots;
 };
 
 template<typename Owner, typename ...TArgs>
 Signal<Owner, TArgs...>::Signal()
-  : m_isExecuting(false)
 {
 }
 
 template<typename Owner, typename ...TArgs>
 Signal<Owner, TArgs...>::~Signal()
 {
-  BOOST_ASSERT(!m_isExecuting);
+  BOOST_ASSERT(m_slots == nullptr || !m_slots->m_isExecuting);
+}
+
+template<typename Owner, typename ...TArgs>
+template<typename F>
+inline Connection
+Signal<Owner, TArgs...>::doConnect(F&& handler, bool isSingleShot)
+{
+  if (m_slots == nullptr) {
+    m_slots = make_shared<Slots>();
+  }
+
+  size_t index = m_slots->allocate(isSingleShot);
+  Slot& slot = m_slots->m_slots[index];
+  slot.handler.assign(std::forward<F>(handler));
+  return signal::Connection(weak_ptr<detail::SlotTable>(m_slots), index, slot.generation);
 }
 
 template<typename Owner, typename ...TArgs>
 inline Connection
 Signal<Owner, TArgs...>::connect(const Handler& handler)
 {
-  typename SlotList::iterator it = m_slots.insert(m_slots.end(), {handler, nullptr});
-  it->disconnect = make_shared<function<void()>>(bind(&Self::disconnect, this, it));
+  return this->doConnect(handler, false);
+}
 
-  return signal::Connection(weak_ptr<function<void()>>(it->disconnect));
+template<typename Owner, typename ...TArgs>
+template<typename F>
+inline Connection
+Signal<Owner, TArgs...>::connect(F&& handler)
+{
+  return this->doConnect(std::forward<F>(handler), false);
 }
 
 template<typename Owner, typename ...TArgs>
 inline Connection
 Signal<Owner, TArgs...>::connectSingleShot(const Handler& handler)
 {
-  typename SlotList::iterator it = m_slots.insert(m_slots.end(), {nullptr, nullptr});
-  it->disconnect = make_shared<function<void()>>(bind(&Self::disconnect, this, it));
-  signal::Connection conn(weak_ptr<function<void()>>(it->disconnect));
+  return this->doConnect(handler, true);
+}
 
-  it->handler = [conn, handler] (const TArgs&... args) mutable {
-    handler(args...);
-    conn.disconnect();
-  };
+template<typename Owner, typename ...TArgs>
+template<typename F>
+inline Connection
+Signal<Owner, TArgs...>::connectSingleShot(F&& handler)
+{
+  return this->doConnect(std::forward<F>(handler), true);
+}
+
+template<typename Owner, typename ...TArgs>
+inline bool
+Signal<Owner, TArgs...>::isEmpty() const
+{
+  return m_slots == nullptr ||
+         (!m_slots->m_isExecuting && m_slots->m_nConnected == 0);
+}
+
+template<typename Owner, typename ...TArgs>
+inline void
+Signal<Owner, TArgs...>::operator()(const TArgs&... args)
+{
+  if (m_slots == nullptr) {
+    return;
+  }
+  m_slots->emit(args...);
+}
+
+template<typename Owner, typename ...TArgs>
+inline void
+Signal<Owner, TArgs...>::operator()(const TArgs&... args, const DummyExtraArg&)
+{
+  this->operator()(args...);
+}
+
+template<typename Owner, typename ...TArgs>
+Signal<Owner, TArgs...>::Slots::Slots()
+  : m_head(NONE)
+  , m_tail(NONE)
+  , m_freeList(NONE)
+  , m_nConnected(0)
+  , m_isExecuting(false)
+  , m_currentSlot(NONE)
+{
+}
 
-  return conn;
+template<typename Owner, typename ...TArgs>
+inline size_t
+Signal<Owner, TArgs...>::Slots::allocate(bool isSingleShot)
+{
+  size_t index = m_freeList;
+  if (index == NONE) {
+    index = m_slots.size();
+    m_slots.emplace_back();
+  }
+  else {
+    m_freeList = m_slots[index].next;
+  }
+
+  Slot& slot = m_slots[index];
+  slot.isConnected = true;
+  slot.isSingleShot = isSingleShot;
+  slot.prev = m_tail;
+  slot.next = NONE;
+  if (m_tail == NONE) {
+    m_head = index;
+  }
+  else {
+    m_slots[m_tail].next = index;
+  }
+  m_tail = index;
+
+  ++m_nConnected;
+  return index;
+}
+
+template<typename Owner, typename ...TArgs>
+inline void
+Signal<Owner, TArgs...>::Slots::disconnect(size_t index, uint64_t generation)
+{
+  if (this->isConnected(index, generation)) {
+    this->disconnect(index);
+  }
+}
+
+template<typename Owner, typename ...TArgs>
+inline bool
+Signal<Owner, TArgs...>::Slots::isConnected(size_t index, uint64_t generation) const
+{
+  return index < m_slots.size() && m_slots[index].generation == generation &&
+         m_slots[index].isConnected;
 }
 
 template<typename Owner, typename ...TArgs>
 inline void
-Signal<Owner, TArgs...>::disconnect(typename SlotList::iterator it)
+Signal<Owner, TArgs...>::Slots::disconnect(size_t index)
 {
-  // it could be const_iterator, but gcc 4.6 doesn't support std::list::erase(const_iterator)
+  Slot& slot = m_slots[index];
+  slot.isConnected = false;
+  ++slot.generation;
+  --m_nConnected;
 
   if (m_isExecuting) {
-    // during signal emission, only the currently executing handler can be disconnected
-    BOOST_ASSERT_MSG(it == m_currentSlot,
+    // during signal emission, only the currently executing handler can be disconnected;
+    // its slot is released after the handler returns
+    BOOST_ASSERT_MSG(index == m_currentSlot,
                      "cannot disconnect another handler from a handler");
-    m_currentSlot = m_slots.end(); // prevent disconnect twice
+    return;
   }
-  m_slots.erase(it);
+  this->release(index);
 }
 
 template<typename Owner, typename ...TArgs>
-inline bool
-Signal<Owner, TArgs...>::isEmpty() const
+inline void
+Signal<Owner, TArgs...>::Slots::release(size_t index)
 {
-  return !m_isExecuting && m_slots.empty();
+  Slot& slot = m_slots[index];
+  slot.handler.reset();
+
+  if (slot.prev == NONE) {
+    m_head = slot.next;
+  }
+  else {
+    m_slots[slot.prev].next = slot.next;
+  }
+  if (slot.next == NONE) {
+    m_tail = slot.prev;
+  }
+  else {
+    m_slots[slot.next].prev = slot.prev;
+  }
+
+  slot.prev = NONE;
+  slot.next = m_freeList;
+  m_freeList = index;
 }
 
 template<typename Owner, typename ...TArgs>
 inline void
-Signal<Owner, TArgs...>::operator()(const TArgs&... args)
+Signal<Owner, TArgs...>::Slots::emit(const TArgs&... args)
 {
   BOOST_ASSERT_MSG(!m_isExecuting, "cannot emit signal from a handler");
-  if (m_slots.empty()) {
+  if (m_head == NONE) {
     return;
   }
   m_isExecuting = true;
 
-  typename SlotList::iterator it = m_slots.begin();
-  typename SlotList::iterator last = m_slots.end();
-  --last;
+  // handlers connected during emission are appended after last, and do not receive the signal
+  size_t index = m_head;
+  size_t last = m_tail;
 
   try {
     bool isLast = false;
     while (!isLast) {
-      m_currentSlot = it;
-      isLast = it == last;
-      ++it;
-
-      m_currentSlot->handler(args...);
+      m_currentSlot = index;
+      isLast = index == last;
+
+      Slot& slot = m_slots[index];
+      slot.handler(args...);
+      if (slot.isSingleShot && slot.isConnected) {
+        this->disconnect(index);
+      }
+
+      index = slot.next;
+      if (!slot.isConnected) {
+        this->release(m_currentSlot);
+      }
     }
   }
   catch (...) {
+    if (!m_slots[m_currentSlot].isConnected) {
+      this->release(m_currentSlot);
+    }
     m_isExecuting = false;
     throw;
   }
   m_isExecuting = false;
 }
 
-template<typename Owner, typename ...TArgs>
-inline void
-Signal<Owner, TArgs...>::operator()(const TArgs&... args, const DummyExtraArg&)
-{
-  this->operator()(args...);
-}
-
 } // namespace signal
 
 // expose as ndn::util::Signal
@@ -0,0 +1,176 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_TESTS_BENCHMARKS_BENCHMARK_HPP
+#define NDN_TESTS_BENCHMARKS_BENCHMARK_HPP
+
+#include "common.hpp"
+#include "util/time.hpp"
+
+#include <map>
+
+namespace ndn {
+namespace benchmarks {
+
+/**
+ * @brief Iteration state of a single benchmark run
+ *
+ * A benchmark performs its setup, then executes the measured operation in a loop:
+ * @code
+ * Name name("/hello/world");
+ * while (state.keepRunning()) {
+ *   doNotOptimize(name.wireEncode());
+ * }
+ * @endcode
+ * Only the time spent inside the loop is measured.
+ */
+class State : noncopyable
+{
+public:
+  typedef time::steady_clock::TimePoint TimePoint;
+
+  explicit
+  State(size_t nIterations)
+    : m_nIterations(nIterations)
+    , m_nRemaining(nIterations)
+  {
+  }
+
+  bool
+  keepRunning()
+  {
+    if (m_nRemaining == 0) {
+      m_end = time::steady_clock::now();
+      return false;
+    }
+    if (m_nRemaining == m_nIterations) {
+      m_start = time::steady_clock::now();
+    }
+    --m_nRemaining;
+    return true;
+  }
+
+  size_t
+  getNIterations() const
+  {
+    return m_nIterations;
+  }
+
+  /**
+   * @return time spent in the measured loop
+   */
+  time::nanoseconds
+  getElapsed() const
+  {
+    return time::duration_cast<time::nanoseconds>(m_end - m_start);
+  }
+
+private:
+  size_t m_nIterations;
+  size_t m_nRemaining;
+  TimePoint m_start;
+  TimePoint m_end;
+};
+
+/**
+ * @brief Prevent the compiler from optimizing away the computation of @p value
+ */
+template<typename T>
+inline void
+doNotOptimize(const T& value)
+{
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+typedef function<void(State&)> BenchmarkFunction;
+
+/**
+ * @brief Registry of all benchmarks, keyed and ordered by name
+ */
+class Registry : noncopyable
+{
+public:
+  static Registry&
+  get()
+  {
+    static Registry instance;
+    return instance;
+  }
+
+  /**
+   * @return false if a benchmark with the same name is already registered
+   */
+  bool
+  add(const std::string& name, const BenchmarkFunction& function)
+  {
+    return m_benchmarks.insert(std::make_pair(name, function)).second;
+  }
+
+  const std::map<std::string, BenchmarkFunction>&
+  getBenchmarks() const
+  {
+    return m_benchmarks;
+  }
+
+private:
+  std::map<std::string, BenchmarkFunction> m_benchmarks;
+};
+
+/**
+ * @brief Adds a benchmark to the registry during static initialization
+ */
+class Registrar
+{
+public:
+  Registrar(const std::string& name, const BenchmarkFunction& function)
+  {
+    if (!Registry::get().add(name, function)) {
+      throw std::logic_error("duplicate benchmark " + name);
+    }
+  }
+};
+
+} // namespace benchmarks
+} // namespace ndn
+
+#define NDN_CXX_BENCHMARK_CONCAT2(a, b) a ## b
+#define NDN_CXX_BENCHMARK_CONCAT(a, b) NDN_CXX_BENCHMARK_CONCAT2(a, b)
+
+/**
+ * @brief Define a benchmark named @p name, which should be of the form "group/case"
+ *
+ * @code
+ * NDN_CXX_BENCHMARK("Name/Compare", state)
+ * {
+ *   ...
+ * }
+ * @endcode
+ */
+#define NDN_CXX_BENCHMARK(name, state)                                                 \
+  static void                                                                          \
+  NDN_CXX_BENCHMARK_CONCAT(ndnCxxBenchmark, __LINE__)(::ndn::benchmarks::State&);      \
+  static ::ndn::benchmarks::Registrar                                                  \
+  NDN_CXX_BENCHMARK_CONCAT(ndnCxxBenchmarkRegistrar, __LINE__)(name,                   \
+    &NDN_CXX_BENCHMARK_CONCAT(ndnCxxBenchmark, __LINE__));                             \
+  static void                                                                          \
+  NDN_CXX_BENCHMARK_CONCAT(ndnCxxBenchmark, __LINE__)(::ndn::benchmarks::State& state)
+
+#endif // NDN_TESTS_BENCHMARKS_BENCHMARK_HPP
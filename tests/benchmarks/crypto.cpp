@@ -0,0 +1,67 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "benchmark.hpp"
+#include "util/crypto.hpp"
+
+namespace ndn {
+namespace benchmarks {
+
+NDN_CXX_BENCHMARK("Crypto/Sha256", state)
+{
+  // roughly the size of a Data packet with 1 KiB of content
+  std::vector<uint8_t> wire(1400, 0xA5);
+  uint8_t digest[crypto::SHA256_DIGEST_SIZE];
+
+  while (state.keepRunning()) {
+    crypto::sha256(wire.data(), wire.size(), digest);
+    doNotOptimize(digest);
+  }
+}
+
+NDN_CXX_BENCHMARK("Crypto/Sha256Buffer", state)
+{
+  std::vector<uint8_t> wire(1400, 0xA5);
+
+  while (state.keepRunning()) {
+    doNotOptimize(crypto::sha256(wire.data(), wire.size()));
+  }
+}
+
+NDN_CXX_BENCHMARK("Crypto/Sha256Batch", state)
+{
+  static const size_t N_BUFFERS = 64;
+  std::vector<uint8_t> wire(1400 * N_BUFFERS, 0xA5);
+  std::vector<const uint8_t*> data;
+  std::vector<size_t> dataLength(N_BUFFERS, 1400);
+  for (size_t i = 0; i < N_BUFFERS; ++i) {
+    data.push_back(wire.data() + i * 1400);
+  }
+  std::vector<uint8_t> digests(N_BUFFERS * crypto::SHA256_DIGEST_SIZE);
+
+  while (state.keepRunning()) {
+    crypto::sha256Batch(data.data(), dataLength.data(), N_BUFFERS, digests.data());
+    doNotOptimize(digests);
+  }
+}
+
+} // namespace benchmarks
+} // namespace ndn
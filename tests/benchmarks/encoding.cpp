@@ -0,0 +1,144 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "benchmark.hpp"
+#include "data.hpp"
+#include "encoding/encoding-buffer.hpp"
+#include "security/signature-sha256-with-rsa.hpp"
+
+namespace ndn {
+namespace benchmarks {
+
+static Data
+makeData()
+{
+  Data data("/ndn/edu/ucla/benchmarks/encoding/%FD%00%01/%00%00");
+  data.setFreshnessPeriod(time::seconds(10));
+  data.setFinalBlockId(name::Component::fromSegment(42));
+
+  std::vector<uint8_t> content(1024, 0xA5);
+  data.setContent(content.data(), content.size());
+
+  SignatureSha256WithRsa signature(KeyLocator("/ndn/edu/ucla/KEY/ksk-1/ID-CERT"));
+  std::vector<uint8_t> value(256, 0x5A);
+  signature.setValue(dataBlock(tlv::SignatureValue, value.data(), value.size()));
+  data.setSignature(signature);
+  return data;
+}
+
+NDN_CXX_BENCHMARK("Block/Parse", state)
+{
+  Block encoded = makeData().wireEncode();
+  ConstBufferPtr wire = make_shared<Buffer>(encoded.wire(), encoded.size());
+
+  while (state.keepRunning()) {
+    Block block(wire);
+    block.parse();
+    for (const Block& element : block.elements()) {
+      // Content and SignatureValue are opaque
+      if (element.type() == tlv::Name || element.type() == tlv::MetaInfo ||
+          element.type() == tlv::SignatureInfo) {
+        element.parse();
+      }
+    }
+    doNotOptimize(block);
+  }
+}
+
+NDN_CXX_BENCHMARK("Data/WireEncode", state)
+{
+  Data data = makeData();
+  time::milliseconds freshnessPeriods[] = {time::seconds(10), time::seconds(20)};
+  size_t i = 0;
+
+  while (state.keepRunning()) {
+    // any modification discards the cached wire encoding
+    data.setFreshnessPeriod(freshnessPeriods[++i % 2]);
+    doNotOptimize(data.wireEncode());
+  }
+}
+
+NDN_CXX_BENCHMARK("Data/WireDecode", state)
+{
+  Block wire = makeData().wireEncode();
+
+  while (state.keepRunning()) {
+    Data data;
+    data.wireDecode(wire);
+    doNotOptimize(data);
+  }
+}
+
+/**
+ * @brief Fill a buffer with back-to-back packets, as received by StreamTransportImpl
+ */
+static Buffer
+makeStream(size_t nPackets)
+{
+  EncodingBuffer encoder;
+  for (size_t i = 0; i < nPackets; ++i) {
+    size_t length = 0;
+    length += encoder.prependByteArrayBlock(tlv::Content,
+                                            reinterpret_cast<const uint8_t*>("payload"), 7);
+    length += encoder.prependByteArrayBlock(tlv::NameComponent,
+                                            reinterpret_cast<const uint8_t*>("component"), 9);
+    length += encoder.prependVarNumber(length);
+    length += encoder.prependVarNumber(tlv::Data);
+  }
+  return Buffer(encoder.buf(), encoder.size());
+}
+
+NDN_CXX_BENCHMARK("Tlv/ScanReadVarNumber", state)
+{
+  Buffer stream = makeStream(256);
+
+  while (state.keepRunning()) {
+    // element boundaries found with readType and readVarNumber, as before scanElements
+    const uint8_t* begin = stream.buf();
+    const uint8_t* end = stream.buf() + stream.size();
+    size_t nElements = 0;
+    while (begin != end) {
+      uint32_t type = 0;
+      uint64_t length = 0;
+      if (!tlv::readType(begin, end, type) || !tlv::readVarNumber(begin, end, length) ||
+          length > static_cast<uint64_t>(end - begin))
+        break;
+
+      begin += length;
+      ++nElements;
+    }
+    doNotOptimize(nElements);
+  }
+}
+
+NDN_CXX_BENCHMARK("Tlv/ScanElements", state)
+{
+  Buffer stream = makeStream(256);
+
+  while (state.keepRunning()) {
+    size_t nElements = 0;
+    doNotOptimize(tlv::scanElements(stream.buf(), stream.buf() + stream.size(), nElements));
+    doNotOptimize(nElements);
+  }
+}
+
+} // namespace benchmarks
+} // namespace ndn
@@ -0,0 +1,80 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "benchmark.hpp"
+#include "util/in-memory-storage-persistent.hpp"
+#include "security/signature-sha256-with-rsa.hpp"
+
+namespace ndn {
+namespace benchmarks {
+
+static const size_t N_PACKETS = 4096;
+
+static std::vector<shared_ptr<Data>>
+makePackets()
+{
+  SignatureSha256WithRsa signature;
+  signature.setValue(dataBlock(tlv::SignatureValue, reinterpret_cast<const uint8_t*>(0), 0));
+
+  std::vector<shared_ptr<Data>> packets;
+  for (size_t i = 0; i < N_PACKETS; ++i) {
+    shared_ptr<Data> data = make_shared<Data>(Name("/ndn/benchmarks/ims").appendSegment(i));
+    data->setSignature(signature);
+    data->wireEncode();
+    packets.push_back(data);
+  }
+  return packets;
+}
+
+NDN_CXX_BENCHMARK("InMemoryStorage/Insert", state)
+{
+  std::vector<shared_ptr<Data>> packets = makePackets();
+  unique_ptr<util::InMemoryStoragePersistent> ims(new util::InMemoryStoragePersistent);
+  size_t i = 0;
+
+  while (state.keepRunning()) {
+    if (i == N_PACKETS) {
+      // measure insertion into a storage of bounded size
+      ims.reset(new util::InMemoryStoragePersistent);
+      i = 0;
+    }
+    ims->insert(*packets[i++]);
+  }
+}
+
+NDN_CXX_BENCHMARK("InMemoryStorage/Find", state)
+{
+  std::vector<shared_ptr<Data>> packets = makePackets();
+  util::InMemoryStoragePersistent ims;
+  std::vector<Interest> interests;
+  for (const shared_ptr<Data>& data : packets) {
+    ims.insert(*data);
+    interests.push_back(Interest(data->getName()));
+  }
+  size_t i = 0;
+
+  while (state.keepRunning()) {
+    doNotOptimize(ims.find(interests[i++ % N_PACKETS]));
+  }
+}
+
+} // namespace benchmarks
+} // namespace ndn
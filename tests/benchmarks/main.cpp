@@ -0,0 +1,242 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "benchmark.hpp"
+#include "version.hpp"
+
+#include <boost/program_options/options_description.hpp>
+#include <boost/program_options/variables_map.hpp>
+#include <boost/program_options/parsers.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+namespace ndn {
+namespace benchmarks {
+
+struct Result
+{
+  std::string name;
+  size_t nIterations;
+  std::vector<double> nsPerOp;
+};
+
+static time::nanoseconds
+runOnce(const BenchmarkFunction& function, size_t nIterations)
+{
+  State state(nIterations);
+  function(state);
+  return state.getElapsed();
+}
+
+/**
+ * @brief Find the number of iterations for which a run lasts at least @p minTime
+ */
+static size_t
+calibrate(const BenchmarkFunction& function, const time::nanoseconds& minTime)
+{
+  static const size_t MAX_ITERATIONS = 1000000000;
+
+  size_t nIterations = 1;
+  while (nIterations < MAX_ITERATIONS) {
+    time::nanoseconds elapsed = runOnce(function, nIterations);
+    if (elapsed >= minTime) {
+      break;
+    }
+
+    // aim slightly above minTime, but never grow by more than 10x at once
+    double factor = 10.0;
+    if (elapsed > time::nanoseconds::zero()) {
+      factor = std::min(factor, 1.4 * minTime.count() / elapsed.count());
+    }
+    nIterations = std::min(MAX_ITERATIONS,
+                           std::max(nIterations + 1, static_cast<size_t>(nIterations * factor)));
+  }
+  return nIterations;
+}
+
+static Result
+run(const std::string& name, const BenchmarkFunction& function,
+    size_t nIterations, size_t nRepetitions, const time::nanoseconds& minTime)
+{
+  Result result;
+  result.name = name;
+  result.nIterations = nIterations > 0 ? nIterations : calibrate(function, minTime);
+
+  for (size_t i = 0; i < nRepetitions; ++i) {
+    time::nanoseconds elapsed = runOnce(function, result.nIterations);
+    result.nsPerOp.push_back(static_cast<double>(elapsed.count()) / result.nIterations);
+  }
+  std::sort(result.nsPerOp.begin(), result.nsPerOp.end());
+  return result;
+}
+
+static std::string
+escapeJson(const std::string& str)
+{
+  std::string escaped;
+  for (char c : str) {
+    if (c == '"' || c == '\\') {
+      escaped += '\\';
+    }
+    escaped += c;
+  }
+  return escaped;
+}
+
+static double
+median(const std::vector<double>& sorted)
+{
+  size_t n = sorted.size();
+  return n % 2 == 1 ? sorted[n / 2] : (sorted[n / 2 - 1] + sorted[n / 2]) / 2;
+}
+
+static void
+printJson(std::ostream& os, const std::vector<Result>& results, size_t nRepetitions)
+{
+  os << std::fixed << std::setprecision(2);
+  os << "{\n"
+     << "  \"context\": {\n"
+     << "    \"library\": \"ndn-cxx\",\n"
+     << "    \"version\": \"" << NDN_CXX_VERSION_BUILD_STRING << "\",\n"
+     << "    \"date\": \"" << time::toIsoString(time::system_clock::now()) << "\",\n"
+     << "    \"repetitions\": " << nRepetitions << "\n"
+     << "  },\n"
+     << "  \"benchmarks\": [";
+
+  for (auto it = results.begin(); it != results.end(); ++it) {
+    if (it != results.begin()) {
+      os << ",";
+    }
+    double mean = 0;
+    for (double value : it->nsPerOp) {
+      mean += value;
+    }
+    mean /= it->nsPerOp.size();
+
+    os << "\n"
+       << "    {\n"
+       << "      \"name\": \"" << escapeJson(it->name) << "\",\n"
+       << "      \"iterations\": " << it->nIterations << ",\n"
+       << "      \"ns_per_op\": {\n"
+       << "        \"min\": " << it->nsPerOp.front() << ",\n"
+       << "        \"median\": " << median(it->nsPerOp) << ",\n"
+       << "        \"mean\": " << mean << ",\n"
+       << "        \"max\": " << it->nsPerOp.back() << "\n"
+       << "      }\n"
+       << "    }";
+  }
+  os << "\n  ]\n}\n";
+}
+
+static int
+main(int argc, char** argv)
+{
+  namespace po = boost::program_options;
+
+  std::string filter;
+  size_t nIterations = 0;
+  size_t nRepetitions = 5;
+  int minTimeMs = 100;
+  std::string output;
+
+  po::options_description options("Usage: benchmarks [options]\nOptions");
+  options.add_options()
+    ("help,h", "print this help message and exit")
+    ("list,l", "list the names of all benchmarks and exit")
+    ("filter,f", po::value<std::string>(&filter),
+     "run only the benchmarks whose name contains this string")
+    ("iterations,n", po::value<size_t>(&nIterations),
+     "number of iterations per repetition; if not given, it is chosen so that "
+     "a repetition lasts at least --min-time")
+    ("repetitions,r", po::value<size_t>(&nRepetitions)->default_value(nRepetitions),
+     "number of measured repetitions of each benchmark")
+    ("min-time,t", po::value<int>(&minTimeMs)->default_value(minTimeMs),
+     "minimum duration of a repetition in milliseconds, when calibrating")
+    ("output,o", po::value<std::string>(&output),
+     "write the JSON results to this file instead of the standard output")
+    ;
+
+  po::variables_map vm;
+  try {
+    po::store(po::parse_command_line(argc, argv, options), vm);
+    po::notify(vm);
+  }
+  catch (const po::error& e) {
+    std::cerr << "ERROR: " << e.what() << "\n\n" << options << std::endl;
+    return 2;
+  }
+
+  if (vm.count("help") > 0) {
+    std::cout << options << std::endl;
+    return 0;
+  }
+
+  if (nRepetitions == 0 || minTimeMs <= 0) {
+    std::cerr << "ERROR: --repetitions and --min-time must be positive" << std::endl;
+    return 2;
+  }
+
+  const std::map<std::string, BenchmarkFunction>& benchmarks = Registry::get().getBenchmarks();
+
+  if (vm.count("list") > 0) {
+    for (const auto& benchmark : benchmarks) {
+      std::cout << benchmark.first << std::endl;
+    }
+    return 0;
+  }
+
+  std::vector<Result> results;
+  for (const auto& benchmark : benchmarks) {
+    if (benchmark.first.find(filter) == std::string::npos) {
+      continue;
+    }
+    std::cerr << benchmark.first << "..." << std::flush;
+    results.push_back(run(benchmark.first, benchmark.second, nIterations, nRepetitions,
+                          time::milliseconds(minTimeMs)));
+    std::cerr << " " << std::fixed << std::setprecision(2)
+              << median(results.back().nsPerOp) << " ns/op" << std::endl;
+  }
+
+  if (output.empty()) {
+    printJson(std::cout, results, nRepetitions);
+  }
+  else {
+    std::ofstream os(output.c_str());
+    printJson(os, results, nRepetitions);
+    if (!os) {
+      std::cerr << "ERROR: cannot write " << output << std::endl;
+      return 1;
+    }
+  }
+  return 0;
+}
+
+} // namespace benchmarks
+} // namespace ndn
+
+int
+main(int argc, char** argv)
+{
+  return ndn::benchmarks::main(argc, argv);
+}
@@ -0,0 +1,73 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "benchmark.hpp"
+#include "name.hpp"
+
+namespace ndn {
+namespace benchmarks {
+
+static const char NAME_URI[] = "/ndn/edu/ucla/cs/benchmarks/name/%FD%00%00%01%4B%2A%7C%10/%00%2A";
+
+NDN_CXX_BENCHMARK("Name/ConstructFromUri", state)
+{
+  while (state.keepRunning()) {
+    Name name(NAME_URI);
+    doNotOptimize(name);
+  }
+}
+
+NDN_CXX_BENCHMARK("Name/ConstructByAppend", state)
+{
+  while (state.keepRunning()) {
+    Name name;
+    name.append("ndn").append("edu").append("ucla").append("cs")
+        .append("benchmarks").appendVersion(1).appendSegment(42);
+    doNotOptimize(name);
+  }
+}
+
+NDN_CXX_BENCHMARK("Name/Compare", state)
+{
+  Name a(NAME_URI);
+  Name b = a.getPrefix(-1).appendSegment(43);
+  Name names[] = {a, b};
+  size_t i = 0;
+
+  while (state.keepRunning()) {
+    doNotOptimize(names[i % 2].compare(names[(i + 1) % 2]));
+    ++i;
+  }
+}
+
+NDN_CXX_BENCHMARK("Name/Hash", state)
+{
+  Name name(NAME_URI);
+  name.wireEncode();
+  std::hash<Name> hasher;
+
+  while (state.keepRunning()) {
+    doNotOptimize(hasher(name));
+  }
+}
+
+} // namespace benchmarks
+} // namespace ndn
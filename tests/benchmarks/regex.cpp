@@ -0,0 +1,43 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "benchmark.hpp"
+#include "util/regex/regex-top-matcher.hpp"
+
+namespace ndn {
+namespace benchmarks {
+
+NDN_CXX_BENCHMARK("Regex/TopMatcherMatch", state)
+{
+  RegexTopMatcher matcher("([^<KEY>]*)<KEY>(<>*)<ksk-.*><ID-CERT><>");
+  Name names[] = {
+    Name("/ndn/edu/ucla/alice/KEY/ksk-1416425377094/ID-CERT/%FD%00%00%01I%C9%8B"),
+    Name("/ndn/edu/ucla/alice/KEY/dsk-1416425377094/ID-CERT/%FD%00%00%01I%C9%8B"),
+  };
+  size_t i = 0;
+
+  while (state.keepRunning()) {
+    doNotOptimize(matcher.match(names[i++ % 2]));
+  }
+}
+
+} // namespace benchmarks
+} // namespace ndn
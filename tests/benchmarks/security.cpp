@@ -0,0 +1,284 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "benchmark.hpp"
+#include "security/crypto-backend.hpp"
+#include "security/cryptopp.hpp"
+#include "security/key-chain.hpp"
+#include "security/validator.hpp"
+#include "security/schema/schema-interpreter.hpp"
+#include "util/io.hpp"
+
+#include <boost/filesystem.hpp>
+
+namespace ndn {
+namespace benchmarks {
+
+/**
+ * @brief KeyChain with a file TPM in a temporary directory, shared by security benchmarks
+ *
+ * The identity is created once, so that key generation does not slow down calibration.
+ */
+class SecurityEnvironment : noncopyable
+{
+public:
+  SecurityEnvironment()
+    : dir(boost::filesystem::temp_directory_path() /
+          boost::filesystem::unique_path("ndn-cxx-benchmarks-%%%%-%%%%"))
+    , keyChain("pib-sqlite3:" + dir.string(), "tpm-file:" + dir.string(), true)
+    , identity("/ndn/edu/ucla/benchmarks/config/key")
+    , hmacKeyName("/ndn/edu/ucla/benchmarks/KEY/hmac")
+  {
+    certName = keyChain.createIdentity(identity);
+    cert = keyChain.getCertificate(certName);
+
+    keyChain.generateSymmetricKeyInTpm(hmacKeyName, HmacKeyParams());
+    hmacKey = keyChain.exportSymmetricKeyFromTpm(hmacKeyName);
+  }
+
+  ~SecurityEnvironment()
+  {
+    boost::system::error_code error;
+    boost::filesystem::remove_all(dir, error);
+  }
+
+  static SecurityEnvironment&
+  get()
+  {
+    static SecurityEnvironment instance;
+    return instance;
+  }
+
+public:
+  boost::filesystem::path dir;
+  KeyChain keyChain;
+  Name identity;
+  Name certName;
+  shared_ptr<IdentityCertificate> cert;
+  Name hmacKeyName;
+  ConstBufferPtr hmacKey;
+};
+
+NDN_CXX_BENCHMARK("Security/KeyChainSignFileTpm", state)
+{
+  SecurityEnvironment& env = SecurityEnvironment::get();
+  Data data("/ndn/edu/ucla/benchmarks/cs/data");
+
+  while (state.keepRunning()) {
+    env.keyChain.sign(data, env.certName);
+  }
+}
+
+NDN_CXX_BENCHMARK("Security/VerifySignature", state)
+{
+  SecurityEnvironment& env = SecurityEnvironment::get();
+  Data data("/ndn/edu/ucla/benchmarks/cs/data");
+  env.keyChain.sign(data, env.certName);
+  const PublicKey& publicKey = env.cert->getPublicKeyInfo();
+
+  while (state.keepRunning()) {
+    doNotOptimize(Validator::verifySignature(data, publicKey));
+  }
+}
+
+NDN_CXX_BENCHMARK("Security/KeyChainSignHmacFileTpm", state)
+{
+  SecurityEnvironment& env = SecurityEnvironment::get();
+  Data data("/ndn/edu/ucla/benchmarks/cs/data");
+
+  while (state.keepRunning()) {
+    env.keyChain.signWithHmac(data, env.hmacKeyName);
+  }
+}
+
+NDN_CXX_BENCHMARK("Security/VerifyHmacSignature", state)
+{
+  SecurityEnvironment& env = SecurityEnvironment::get();
+  Data data("/ndn/edu/ucla/benchmarks/cs/data");
+  env.keyChain.signWithHmac(data, env.hmacKeyName);
+  SignatureHmacWithSha256 sig(data.getSignature());
+
+  while (state.keepRunning()) {
+    doNotOptimize(Validator::verifySignature(data, sig, *env.hmacKey));
+  }
+}
+
+/**
+ * @brief Key pair encoded the way SecTpmFile stores it: PKCS #8 and SubjectPublicKeyInfo
+ */
+struct EncodedKeyPair
+{
+  std::string privateKey;
+  std::string publicKey;
+};
+
+/**
+ * @return RSA 2048 or ECDSA P-256 key pair, generated once
+ */
+static const EncodedKeyPair&
+getKeyPair(KeyType keyType)
+{
+  static std::map<KeyType, EncodedKeyPair> keyPairs;
+
+  EncodedKeyPair& keyPair = keyPairs[keyType];
+  if (!keyPair.privateKey.empty()) {
+    return keyPair;
+  }
+
+  using namespace CryptoPP;
+  AutoSeededRandomPool rng;
+  StringSink privateKeySink(keyPair.privateKey);
+  StringSink publicKeySink(keyPair.publicKey);
+
+  if (keyType == KEY_TYPE_RSA) {
+    InvertibleRSAFunction privateKey;
+    privateKey.Initialize(rng, 2048);
+    privateKey.DEREncode(privateKeySink);
+
+    RSAFunction publicKey(privateKey);
+    publicKey.DEREncode(publicKeySink);
+  }
+  else {
+    DL_GroupParameters_EC<ECP> params(ASN1::secp256r1());
+    params.SetEncodeAsOID(true);
+
+    ECDSA<ECP, SHA256>::PrivateKey privateKey;
+    privateKey.Initialize(rng, params);
+
+    ECDSA<ECP, SHA256>::PublicKey publicKey;
+    privateKey.MakePublicKey(publicKey);
+    publicKey.AccessGroupParameters().SetEncodeAsOID(true);
+
+    privateKey.DEREncode(privateKeySink);
+    publicKey.Save(publicKeySink);
+  }
+
+  return keyPair;
+}
+
+static void
+benchmarkBackendSign(State& state, const std::string& backendName, KeyType keyType)
+{
+  const CryptoBackend* backend = CryptoBackend::find(backendName);
+  const EncodedKeyPair& keyPair = getKeyPair(keyType);
+  const uint8_t* privateKey = reinterpret_cast<const uint8_t*>(keyPair.privateKey.data());
+  std::vector<uint8_t> data(1400, 0xA5);
+
+  while (state.keepRunning()) {
+    doNotOptimize(backend->sign(keyType, privateKey, keyPair.privateKey.size(),
+                                data.data(), data.size(), DIGEST_ALGORITHM_SHA256));
+  }
+}
+
+static void
+benchmarkBackendVerify(State& state, const std::string& backendName, KeyType keyType)
+{
+  const CryptoBackend* backend = CryptoBackend::find(backendName);
+  const EncodedKeyPair& keyPair = getKeyPair(keyType);
+  const uint8_t* privateKey = reinterpret_cast<const uint8_t*>(keyPair.privateKey.data());
+  const uint8_t* publicKey = reinterpret_cast<const uint8_t*>(keyPair.publicKey.data());
+  std::vector<uint8_t> data(1400, 0xA5);
+  ConstBufferPtr sig = backend->sign(keyType, privateKey, keyPair.privateKey.size(),
+                                     data.data(), data.size(), DIGEST_ALGORITHM_SHA256);
+
+  while (state.keepRunning()) {
+    doNotOptimize(backend->verify(keyType, publicKey, keyPair.publicKey.size(),
+                                  data.data(), data.size(), sig->buf(), sig->size(),
+                                  DIGEST_ALGORITHM_SHA256));
+  }
+}
+
+NDN_CXX_BENCHMARK("CryptoBackend/CryptoppRsaSign", state)
+{
+  benchmarkBackendSign(state, "cryptopp", KEY_TYPE_RSA);
+}
+
+NDN_CXX_BENCHMARK("CryptoBackend/CryptoppRsaVerify", state)
+{
+  benchmarkBackendVerify(state, "cryptopp", KEY_TYPE_RSA);
+}
+
+NDN_CXX_BENCHMARK("CryptoBackend/CryptoppEcdsaSign", state)
+{
+  benchmarkBackendSign(state, "cryptopp", KEY_TYPE_ECDSA);
+}
+
+NDN_CXX_BENCHMARK("CryptoBackend/CryptoppEcdsaVerify", state)
+{
+  benchmarkBackendVerify(state, "cryptopp", KEY_TYPE_ECDSA);
+}
+
+#ifdef NDN_CXX_HAVE_OPENSSL
+
+NDN_CXX_BENCHMARK("CryptoBackend/OpensslRsaSign", state)
+{
+  benchmarkBackendSign(state, "openssl", KEY_TYPE_RSA);
+}
+
+NDN_CXX_BENCHMARK("CryptoBackend/OpensslRsaVerify", state)
+{
+  benchmarkBackendVerify(state, "openssl", KEY_TYPE_RSA);
+}
+
+NDN_CXX_BENCHMARK("CryptoBackend/OpensslEcdsaSign", state)
+{
+  benchmarkBackendSign(state, "openssl", KEY_TYPE_ECDSA);
+}
+
+NDN_CXX_BENCHMARK("CryptoBackend/OpensslEcdsaVerify", state)
+{
+  benchmarkBackendVerify(state, "openssl", KEY_TYPE_ECDSA);
+}
+
+#endif // NDN_CXX_HAVE_OPENSSL
+
+NDN_CXX_BENCHMARK("Security/SchemaCheckDataRule", state)
+{
+  SecurityEnvironment& env = SecurityEnvironment::get();
+  io::save(*env.cert, (env.dir / "trust-anchor.cert").string());
+
+  static const std::string SCHEMA =
+    "rule\n"
+    "{\n"
+    "  id \"pkt\"\n"
+    "  name (<>*)<ucla>(<>)<cs><><>*\n"
+    "  signer k1($1,$2)\n"
+    "}\n"
+    "anchor\n"
+    "{\n"
+    "  id \"k1\"\n"
+    "  name (<>*)<ucla>(<>)<config><key><>*\n"
+    "  file \"trust-anchor.cert\"\n"
+    "}\n";
+
+  security::SchemaInterpreter schema;
+  schema.load(SCHEMA, (env.dir / "benchmark.schema").string());
+
+  Name dataName("/ndn/edu/ucla/benchmarks/cs/data");
+  Name keyLocator = env.certName.getPrefix(-1);
+
+  while (state.keepRunning()) {
+    doNotOptimize(schema.checkDataRule(dataName, keyLocator));
+  }
+}
+
+} // namespace benchmarks
+} // namespace ndn
@@ -321,6 +321,122 @@ BOOST_AUTO_TEST_CASE(DecodeWithoutLocalHeader)
   BOOST_CHECK_EQUAL(&payload, &wireBlock);
 }
 
+BOOST_AUTO_TEST_CASE(DecodeLazy)
+{
+  Block dataBlock(Data1, sizeof(Data1));
+
+  Data d;
+  BOOST_REQUIRE_NO_THROW(d.wireDecodeLazy(dataBlock));
+  BOOST_CHECK_EQUAL(d.getName(), "/local/ndn/prefix");
+  BOOST_CHECK_EQUAL(d.getContent().value_size(), sizeof(Content1));
+  BOOST_CHECK_EQUAL(d.getFreshnessPeriod(), time::seconds(10));
+  BOOST_CHECK_EQUAL(d.getSignature().getType(), static_cast<uint32_t>(Signature::Sha256WithRsa));
+  BOOST_CHECK_EQUAL(d.getSignature().getValue().value_size(), 128);
+  BOOST_CHECK(d.wireEncode() == dataBlock);
+
+  // deferred fields survive modification of another field
+  Data d2;
+  d2.wireDecodeLazy(dataBlock);
+  d2.setName("/another/name");
+  BOOST_CHECK_EQUAL(d2.getFreshnessPeriod(), time::seconds(10));
+  BOOST_CHECK_EQUAL(d2.getSignature().getValue().value_size(), 128);
+
+  Data d3;
+  d3.wireDecodeLazy(dataBlock);
+  d3.setFreshnessPeriod(time::seconds(5));
+  BOOST_CHECK_EQUAL(d3.getFreshnessPeriod(), time::seconds(5));
+  BOOST_CHECK_EQUAL(d3.getSignature().getType(), static_cast<uint32_t>(Signature::Sha256WithRsa));
+
+  Data d4;
+  d4.wireDecode(dataBlock);
+  BOOST_CHECK(d == d4);
+}
+
+BOOST_AUTO_TEST_CASE(EncodeIntoBuffer)
+{
+  // copied from the wire
+  Data d(Block(Data1, sizeof(Data1)));
+
+  uint8_t buffer[sizeof(Data1) + 10];
+  size_t size = 0;
+  BOOST_REQUIRE_NO_THROW(size = d.wireEncode(buffer, sizeof(buffer)));
+  BOOST_CHECK_EQUAL_COLLECTIONS(buffer, buffer + size, Data1, Data1 + sizeof(Data1));
+
+  BOOST_CHECK_THROW(d.wireEncode(buffer, sizeof(Data1) - 1), Data::Error);
+
+  // encoded from the fields
+  Data d2(d.getName());
+  d2.setMetaInfo(d.getMetaInfo());
+  d2.setContent(d.getContent());
+  d2.setSignature(d.getSignature());
+
+  std::fill(buffer, buffer + sizeof(buffer), 0);
+  BOOST_REQUIRE_NO_THROW(size = d2.wireEncode(buffer, sizeof(buffer)));
+  BOOST_CHECK_EQUAL(d2.hasWire(), false);
+  BOOST_CHECK_EQUAL_COLLECTIONS(buffer, buffer + size, Data1, Data1 + sizeof(Data1));
+
+  BOOST_CHECK_THROW(d2.wireEncode(buffer, sizeof(Data1) - 1), Data::Error);
+  BOOST_CHECK_THROW(Data("/unsigned").wireEncode(buffer, sizeof(buffer)), Data::Error);
+}
+
+BOOST_AUTO_TEST_CASE(ReEncodeAfterContentChange)
+{
+  Data d("/local/ndn/prefix");
+  d.setFreshnessPeriod(time::seconds(10));
+  d.setContent(Content1, sizeof(Content1));
+  d.setSignature(Signature(SignatureInfo(tlv::DigestSha256),
+                           Block(tlv::SignatureValue, make_shared<Buffer>(32))));
+
+  // encoded fields point into the wire, so that their values are not kept twice
+  Block wire1 = d.wireEncode();
+  BOOST_CHECK(d.getName().wireEncode().getBuffer() == wire1.getBuffer());
+  BOOST_CHECK(d.getMetaInfo().wireEncode().getBuffer() == wire1.getBuffer());
+  BOOST_CHECK(d.getContent().getBuffer() == wire1.getBuffer());
+  BOOST_CHECK(d.getSignature().getInfo().getBuffer() == wire1.getBuffer());
+
+  const uint8_t content2[] = {0x01, 0x02, 0x03};
+  d.setContent(content2, sizeof(content2));
+  Block wire2 = d.wireEncode();
+  BOOST_CHECK(wire1 != wire2);
+  BOOST_CHECK(d.getName().wireEncode().getBuffer() == wire2.getBuffer());
+  BOOST_CHECK(d.getMetaInfo().wireEncode().getBuffer() == wire2.getBuffer());
+  BOOST_CHECK(d.getContent().getBuffer() == wire2.getBuffer());
+  BOOST_CHECK(d.getSignature().getInfo().getBuffer() == wire2.getBuffer());
+  BOOST_CHECK(d.getSignature().getValue().getBuffer() == wire2.getBuffer());
+
+  Data decoded(wire2);
+  BOOST_CHECK_EQUAL(decoded.getName(), "/local/ndn/prefix");
+  BOOST_CHECK_EQUAL(decoded.getFreshnessPeriod(), time::seconds(10));
+  BOOST_CHECK_EQUAL_COLLECTIONS(decoded.getContent().value_begin(),
+                                decoded.getContent().value_end(),
+                                content2, content2 + sizeof(content2));
+  BOOST_CHECK(decoded == d);
+}
+
+BOOST_AUTO_TEST_CASE(DecodeLazyMalformedMetaInfo)
+{
+  const uint8_t WIRE[] = {
+    0x06, 0x0f, // Data
+          0x07, 0x03, // Name
+                0x08, 0x01, 0x41,
+          0x14, 0x01, // MetaInfo
+                0x19, // malformed FreshnessPeriod
+          0x15, 0x00, // Content
+          0x16, 0x03, // SignatureInfo
+                0x1b, 0x01, 0x00 // SignatureType
+  };
+  Block dataBlock(WIRE, sizeof(WIRE));
+
+  Data d;
+  BOOST_CHECK_THROW(d.wireDecode(dataBlock), tlv::Error);
+
+  Data lazy;
+  BOOST_REQUIRE_NO_THROW(lazy.wireDecodeLazy(dataBlock));
+  BOOST_CHECK_EQUAL(lazy.getName(), "/A");
+  BOOST_CHECK_EQUAL(lazy.getSignature().getType(), static_cast<uint32_t>(tlv::DigestSha256));
+  BOOST_CHECK_THROW(lazy.getMetaInfo(), tlv::Error);
+}
+
 class TestDataFixture
 {
 public:
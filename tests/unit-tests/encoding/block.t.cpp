@@ -339,6 +339,67 @@ BOOST_AUTO_TEST_CASE(FromStreamZeroLength) // Bug 2729
   BOOST_CHECK_EQUAL(block.value_size(), 0);
 }
 
+BOOST_AUTO_TEST_CASE(Parse)
+{
+  const uint8_t PACKET[] = {
+    0x07, 0x0c, // Name
+          0x08, 0x02, 0x61, 0x62, // NameComponent 'ab'
+          0x08, 0x01, 0x63, // NameComponent 'c'
+          0x08, 0x03, 0x64, 0x65, 0x66 // NameComponent 'def'
+  };
+
+  Block block(PACKET, sizeof(PACKET));
+  BOOST_REQUIRE_NO_THROW(block.parse());
+  BOOST_REQUIRE_EQUAL(block.elements_size(), 3);
+  BOOST_CHECK_EQUAL(block.elements().capacity(), 3);
+
+  BOOST_CHECK_EQUAL(block.elements()[0].type(), tlv::NameComponent);
+  BOOST_CHECK_EQUAL(block.elements()[0].value_size(), 2);
+  BOOST_CHECK_EQUAL(block.elements()[1].value_size(), 1);
+  BOOST_CHECK_EQUAL(block.elements()[2].value_size(), 3);
+  BOOST_CHECK_EQUAL(*block.elements()[2].value(), 0x64);
+  BOOST_CHECK(block.elements()[1].getBuffer() == block.getBuffer());
+
+  // parsing again is a no-op
+  BOOST_REQUIRE_NO_THROW(block.parse());
+  BOOST_CHECK_EQUAL(block.elements_size(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(ParseMalformed)
+{
+  const uint8_t PACKET[] = {
+    0x07, 0x07, // Name
+          0x08, 0x01, 0x61, // NameComponent 'a'
+          0x08, 0x05, 0x62, 0x63 // NameComponent with TLV-LENGTH exceeding the buffer
+  };
+
+  Block block(PACKET, sizeof(PACKET));
+  BOOST_CHECK_THROW(block.parse(), tlv::Error);
+  BOOST_CHECK_EQUAL(block.elements_size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(EncodeSubElements)
+{
+  Block block(tlv::Name);
+  block.push_back(Block("\x08\x02\x61\x62", 4));
+  block.push_back(Block(tlv::NameComponent, make_shared<Buffer>(3))); // value only, no wire
+  block.encode();
+
+  const uint8_t EXPECTED[] = {
+    0x07, 0x09,
+          0x08, 0x02, 0x61, 0x62,
+          0x08, 0x03, 0x00, 0x00, 0x00
+  };
+  BOOST_CHECK_EQUAL_COLLECTIONS(block.begin(), block.end(), EXPECTED, EXPECTED + sizeof(EXPECTED));
+  BOOST_CHECK_EQUAL(block.getBuffer()->size(), sizeof(EXPECTED));
+  BOOST_CHECK_EQUAL(block.value_size(), 9);
+
+  Block emptyBlock(tlv::Content);
+  emptyBlock.encode();
+  BOOST_CHECK_EQUAL(emptyBlock.size(), 2);
+  BOOST_CHECK_EQUAL(emptyBlock.value_size(), 0);
+}
+
 BOOST_AUTO_TEST_CASE(Equality)
 {
   BOOST_CONCEPT_ASSERT((boost::EqualityComparable<Block>));
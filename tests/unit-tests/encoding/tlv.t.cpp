@@ -409,6 +409,50 @@ BOOST_AUTO_TEST_CASE(ReadFromStream)
 
 BOOST_AUTO_TEST_SUITE_END() // NonNegativeInteger
 
+BOOST_AUTO_TEST_SUITE(Elements)
+
+static const uint8_t BUFFER[] = {
+  0x08, 0x01, 0x61, // single-octet Type and Length
+  0xfd, 0x01, 0x00, 0x02, 0x62, 0x63, // 3-octet Type
+  0x08, 0xfd, 0x00, 0x01, 0x64, // 3-octet Length
+  0x08, 0x00, // empty TLV-VALUE
+  0x08, 0x05, 0x65, 0x66 // incomplete
+};
+
+BOOST_AUTO_TEST_CASE(Scan)
+{
+  size_t nElements = 0;
+  BOOST_CHECK(scanElements(BUFFER, BUFFER + sizeof(BUFFER), nElements) == BUFFER + 16);
+  BOOST_CHECK_EQUAL(nElements, 4);
+
+  BOOST_CHECK(scanElements(BUFFER, BUFFER + 16, nElements) == BUFFER + 16);
+  BOOST_CHECK_EQUAL(nElements, 4);
+
+  BOOST_CHECK(scanElements(BUFFER, BUFFER + 12, nElements) == BUFFER + 9);
+  BOOST_CHECK_EQUAL(nElements, 2);
+
+  BOOST_CHECK(scanElements(BUFFER + 3, BUFFER + 5, nElements) == BUFFER + 3);
+  BOOST_CHECK_EQUAL(nElements, 0);
+
+  BOOST_CHECK(scanElements(BUFFER, BUFFER, nElements) == BUFFER);
+  BOOST_CHECK_EQUAL(nElements, 0);
+}
+
+BOOST_AUTO_TEST_CASE(ScanTypeTooLarge)
+{
+  static const uint8_t TYPE_TOO_LARGE[] = {
+    0x08, 0x01, 0x61,
+    0xff, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00
+  };
+
+  size_t nElements = 0;
+  BOOST_CHECK(scanElements(TYPE_TOO_LARGE, TYPE_TOO_LARGE + sizeof(TYPE_TOO_LARGE),
+                           nElements) == TYPE_TOO_LARGE + 3);
+  BOOST_CHECK_EQUAL(nElements, 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // Elements
+
 BOOST_AUTO_TEST_SUITE_END() // EncodingTlv
 
 } // namespace tests
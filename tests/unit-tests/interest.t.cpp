@@ -905,6 +905,36 @@ BOOST_AUTO_TEST_CASE(Decode)
   BOOST_CHECK_EQUAL(i.getNonce(), 1U);
 }
 
+BOOST_AUTO_TEST_CASE(DecodeLazy)
+{
+  Block interestBlock(Interest1, sizeof(Interest1));
+
+  Interest i;
+  BOOST_REQUIRE_NO_THROW(i.wireDecodeLazy(interestBlock));
+  BOOST_CHECK_EQUAL(i.getName().toUri(), "/local/ndn/prefix");
+  BOOST_CHECK_EQUAL(i.getInterestLifetime(), time::milliseconds(1000));
+  BOOST_CHECK_EQUAL(i.getNonce(), 1U);
+  BOOST_CHECK(i.hasSelectors());
+  BOOST_CHECK_EQUAL(i.getMinSuffixComponents(), 1);
+  BOOST_CHECK_EQUAL(i.getChildSelector(), 1);
+  BOOST_CHECK_EQUAL(i.getExclude().toUri(), "alex,xxxx,*,yyyy");
+  BOOST_CHECK(i.wireEncode() == interestBlock);
+
+  // deferred Selectors survive reset of the wire by another setter
+  Interest i2;
+  i2.wireDecodeLazy(interestBlock);
+  i2.setName("/another/name");
+  BOOST_CHECK_EQUAL(i2.getMaxSuffixComponents(), 1);
+  BOOST_CHECK_EQUAL(i2.getPublisherPublicKeyLocator().getName(), "ndn:/test/key/locator");
+
+  Interest i3;
+  i3.wireDecodeLazy(interestBlock);
+  i3.setMustBeFresh(true);
+  BOOST_CHECK_EQUAL(i3.getMustBeFresh(), true);
+  BOOST_CHECK_EQUAL(i3.getChildSelector(), 1);
+  BOOST_CHECK_EQUAL(i3.getExclude().toUri(), "alex,xxxx,*,yyyy");
+}
+
 BOOST_AUTO_TEST_CASE(DecodeFromStream)
 {
   boost::iostreams::stream<boost::iostreams::array_source> is(
@@ -975,6 +1005,48 @@ BOOST_AUTO_TEST_CASE(Encode)
   BOOST_CHECK_NE(i.getNonce(), 2);
 }
 
+BOOST_AUTO_TEST_CASE(EncodeIntoBuffer)
+{
+  ndn::Interest i(ndn::Name("/local/ndn/prefix"));
+  i.setScope(1);
+  i.setInterestLifetime(time::milliseconds(1000));
+  i.setMinSuffixComponents(1);
+  i.setMaxSuffixComponents(1);
+  i.setPublisherPublicKeyLocator(KeyLocator("ndn:/test/key/locator"));
+  i.setChildSelector(1);
+  i.setMustBeFresh(false);
+  Exclude exclude;
+  exclude
+    .excludeOne(name::Component("alex"))
+    .excludeRange(name::Component("xxxx"), name::Component("yyyy"));
+  i.setExclude(exclude);
+  i.setNonce(1);
+
+  // encoded from the fields
+  uint8_t buffer[sizeof(Interest1) + 10];
+  size_t size = 0;
+  BOOST_REQUIRE_NO_THROW(size = i.wireEncode(buffer, sizeof(buffer)));
+  BOOST_CHECK_EQUAL(i.hasWire(), false);
+  BOOST_CHECK_EQUAL_COLLECTIONS(buffer, buffer + size, Interest1, Interest1 + sizeof(Interest1));
+  BOOST_CHECK_THROW(i.wireEncode(buffer, sizeof(Interest1) - 1), Interest::Error);
+
+  // copied from the wire
+  i.wireEncode();
+  std::fill(buffer, buffer + sizeof(buffer), 0);
+  BOOST_REQUIRE_NO_THROW(size = i.wireEncode(buffer, sizeof(buffer)));
+  BOOST_CHECK_EQUAL_COLLECTIONS(buffer, buffer + size, Interest1, Interest1 + sizeof(Interest1));
+  BOOST_CHECK_THROW(i.wireEncode(buffer, sizeof(Interest1) - 1), Interest::Error);
+
+  // with Link and SelectedDelegation
+  Interest interest(Block(InterestWithLink, sizeof(InterestWithLink)));
+  interest.setSelectedDelegation(uint32_t(1));
+  BOOST_CHECK_EQUAL(interest.hasWire(), false);
+  uint8_t linkBuffer[sizeof(InterestWithLink) + 10];
+  BOOST_REQUIRE_NO_THROW(size = interest.wireEncode(linkBuffer, sizeof(linkBuffer)));
+  const Block& wire = interest.wireEncode();
+  BOOST_CHECK_EQUAL_COLLECTIONS(linkBuffer, linkBuffer + size, wire.begin(), wire.end());
+}
+
 BOOST_AUTO_TEST_CASE(EncodeWithLocalHeader)
 {
   ndn::Interest interest(ndn::Name("/local/ndn/prefix"));
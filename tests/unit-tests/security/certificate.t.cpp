@@ -26,6 +26,8 @@
 
 #include "security/cryptopp.hpp"
 
+#include <thread>
+
 #include "boost-test.hpp"
 
 using namespace std;
@@ -339,6 +341,55 @@ BOOST_AUTO_TEST_CASE(Decode)
   BOOST_CHECK_EQUAL(RSA_CERT_INFO, rsaCertInfo);
 }
 
+BOOST_AUTO_TEST_CASE(LazyDecode)
+{
+  ndn::Certificate certificate;
+  certificate.wireDecode(ndn::Block(SELF_SIGNED_ECDSA_CERT, sizeof(SELF_SIGNED_ECDSA_CERT)));
+  BOOST_CHECK_EQUAL(certificate.getPublicKeyInfo().getKeyType(), KEY_TYPE_ECDSA);
+
+  // decoding another certificate into the same object replaces the decoded fields
+  certificate.wireDecode(ndn::Block(RSA_CERT, sizeof(RSA_CERT)));
+  BOOST_CHECK_EQUAL(certificate.getPublicKeyInfo().getKeyType(), KEY_TYPE_RSA);
+  BOOST_CHECK_EQUAL(time::toIsoString(certificate.getNotBefore()), "20141119T193302");
+
+  // setting one field before the content is decoded keeps the other fields
+  ndn::Certificate modified;
+  modified.wireDecode(ndn::Block(RSA_CERT, sizeof(RSA_CERT)));
+  modified.setNotAfter(time::fromIsoString("20161119T193302"));
+  modified.encode();
+
+  ndn::Data data("/tmp");
+  data.setContent(modified.getContent());
+  ndn::Certificate reencoded(data);
+  BOOST_CHECK_EQUAL(time::toIsoString(reencoded.getNotBefore()), "20141119T193302");
+  BOOST_CHECK_EQUAL(time::toIsoString(reencoded.getNotAfter()), "20161119T193302");
+  BOOST_REQUIRE_EQUAL(reencoded.getSubjectDescriptionList().size(), 1);
+  BOOST_CHECK_EQUAL(reencoded.getSubjectDescriptionList()[0].getValue(), "/ndn/site1");
+  BOOST_CHECK(reencoded.getPublicKeyInfo() == certificate.getPublicKeyInfo());
+}
+
+BOOST_AUTO_TEST_CASE(ConcurrentDecode)
+{
+  const ndn::Certificate certificate(ndn::Block(RSA_CERT, sizeof(RSA_CERT)));
+
+  // a copy of a certificate that has not been decoded yet decodes on its own
+  ndn::Certificate copy(certificate);
+  BOOST_CHECK_EQUAL(time::toIsoString(copy.getNotBefore()), "20141119T193302");
+
+  const ndn::Certificate shared(ndn::Block(RSA_CERT, sizeof(RSA_CERT)));
+  std::vector<KeyType> keyTypes(4, KEY_TYPE_NULL);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < keyTypes.size(); ++i)
+    threads.push_back(std::thread([&shared, &keyTypes, i] {
+          keyTypes[i] = shared.getPublicKeyInfo().getKeyType();
+        }));
+  for (auto& thread : threads)
+    thread.join();
+
+  for (KeyType keyType : keyTypes)
+    BOOST_CHECK_EQUAL(keyType, KEY_TYPE_RSA);
+}
+
 const uint8_t WRONG_CERT[] = { // first byte is wrong and an error will be thrown out
 0x31, 0x82, 0x01, 0x63, 0x30, 0x22, 0x18, 0x0f, 0x32, 0x30, 0x31, 0x33, 0x31, 0x31, 0x30,
 0x31, 0x31, 0x37, 0x31, 0x31, 0x32, 0x32, 0x5a, 0x18, 0x0f, 0x32, 0x30, 0x31, 0x34, 0x31,
@@ -371,7 +422,16 @@ BOOST_AUTO_TEST_CASE(DecodeError)
   ndn::Data data("/tmp");
   data.setContent(WRONG_CERT, sizeof(WRONG_CERT));
 
-  BOOST_CHECK_THROW(ndn::Certificate certificate(data), Certificate::Error);
+  // the content is only decoded when needed
+  ndn::Certificate certificate(data);
+  BOOST_CHECK_THROW(certificate.decode(), Certificate::Error);
+  BOOST_CHECK_THROW(certificate.getPublicKeyInfo(), Certificate::Error);
+  BOOST_CHECK_THROW(certificate.isTooLate(), Certificate::Error);
+  BOOST_CHECK_EQUAL(certificate.isContentDecodable(), false);
+
+  ndn::Certificate good;
+  good.wireDecode(ndn::Block(RSA_CERT, sizeof(RSA_CERT)));
+  BOOST_CHECK_EQUAL(good.isContentDecodable(), true);
 }
 
 
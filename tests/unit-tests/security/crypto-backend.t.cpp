@@ -0,0 +1,245 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "security/crypto-backend.hpp"
+#include "security/cryptopp.hpp"
+
+#include "boost-test.hpp"
+
+namespace ndn {
+namespace tests {
+
+/**
+ * @brief key pair encoded the way SecTpmFile stores it
+ */
+struct EncodedKeyPair
+{
+  KeyType keyType;
+  std::string privateKey;
+  std::string publicKey;
+};
+
+static EncodedKeyPair
+generateKeyPair(KeyType keyType, uint32_t keySize)
+{
+  using namespace CryptoPP;
+
+  EncodedKeyPair keyPair;
+  keyPair.keyType = keyType;
+  AutoSeededRandomPool rng;
+  StringSink privateKeySink(keyPair.privateKey);
+  StringSink publicKeySink(keyPair.publicKey);
+
+  if (keyType == KEY_TYPE_RSA) {
+    InvertibleRSAFunction privateKey;
+    privateKey.Initialize(rng, keySize);
+    privateKey.DEREncode(privateKeySink);
+
+    RSAFunction publicKey(privateKey);
+    publicKey.DEREncode(publicKeySink);
+  }
+  else {
+    DL_GroupParameters_EC<ECP> params(keySize == 384 ? ASN1::secp384r1() : ASN1::secp256r1());
+    params.SetEncodeAsOID(true);
+
+    ECDSA<ECP, SHA256>::PrivateKey privateKey;
+    privateKey.Initialize(rng, params);
+
+    ECDSA<ECP, SHA256>::PublicKey publicKey;
+    privateKey.MakePublicKey(publicKey);
+    publicKey.AccessGroupParameters().SetEncodeAsOID(true);
+
+    privateKey.DEREncode(privateKeySink);
+    publicKey.Save(publicKeySink);
+  }
+
+  return keyPair;
+}
+
+static const uint8_t*
+bytes(const std::string& str)
+{
+  return reinterpret_cast<const uint8_t*>(str.data());
+}
+
+class CryptoBackendFixture
+{
+public:
+  CryptoBackendFixture()
+  {
+    backends.push_back(CryptoBackend::find("cryptopp"));
+#ifdef NDN_CXX_HAVE_OPENSSL
+    backends.push_back(CryptoBackend::find("openssl"));
+#endif // NDN_CXX_HAVE_OPENSSL
+
+    keyPairs.push_back(generateKeyPair(KEY_TYPE_RSA, 2048));
+    keyPairs.push_back(generateKeyPair(KEY_TYPE_ECDSA, 256));
+    keyPairs.push_back(generateKeyPair(KEY_TYPE_ECDSA, 384));
+  }
+
+public:
+  std::vector<const CryptoBackend*> backends;
+  std::vector<EncodedKeyPair> keyPairs;
+};
+
+BOOST_FIXTURE_TEST_SUITE(SecurityCryptoBackend, CryptoBackendFixture)
+
+BOOST_AUTO_TEST_CASE(Find)
+{
+  BOOST_REQUIRE(CryptoBackend::find("cryptopp") != nullptr);
+  BOOST_CHECK_EQUAL(CryptoBackend::find("cryptopp")->getName(), "cryptopp");
+#ifdef NDN_CXX_HAVE_OPENSSL
+  BOOST_REQUIRE(CryptoBackend::find("openssl") != nullptr);
+  BOOST_CHECK_EQUAL(CryptoBackend::find("openssl")->getName(), "openssl");
+#endif // NDN_CXX_HAVE_OPENSSL
+  BOOST_CHECK(CryptoBackend::find("unknown") == nullptr);
+
+  BOOST_CHECK_EQUAL(CryptoBackend::getDefault().getName(), NDN_CXX_CRYPTO_BACKEND);
+}
+
+BOOST_AUTO_TEST_CASE(SignVerify)
+{
+  const std::string content = "content to be signed";
+  const std::string otherContent = "content not signed";
+
+  for (const EncodedKeyPair& keyPair : keyPairs) {
+    for (const CryptoBackend* signer : backends) {
+      BOOST_TEST_MESSAGE(signer->getName() << " sign, key type " << keyPair.keyType);
+
+      ConstBufferPtr sig = signer->sign(keyPair.keyType,
+                                        bytes(keyPair.privateKey), keyPair.privateKey.size(),
+                                        bytes(content), content.size(),
+                                        DIGEST_ALGORITHM_SHA256);
+      BOOST_REQUIRE(sig != nullptr);
+
+      // every backend accepts signatures made by every other backend
+      for (const CryptoBackend* verifier : backends) {
+        BOOST_CHECK(verifier->verify(keyPair.keyType,
+                                     bytes(keyPair.publicKey), keyPair.publicKey.size(),
+                                     bytes(content), content.size(),
+                                     sig->buf(), sig->size(), DIGEST_ALGORITHM_SHA256));
+
+        BOOST_CHECK(!verifier->verify(keyPair.keyType,
+                                      bytes(keyPair.publicKey), keyPair.publicKey.size(),
+                                      bytes(otherContent), otherContent.size(),
+                                      sig->buf(), sig->size(), DIGEST_ALGORITHM_SHA256));
+
+        Buffer badSig(sig->buf(), sig->size());
+        badSig[badSig.size() - 1] ^= 0x01;
+        BOOST_CHECK(!verifier->verify(keyPair.keyType,
+                                      bytes(keyPair.publicKey), keyPair.publicKey.size(),
+                                      bytes(content), content.size(),
+                                      badSig.buf(), badSig.size(), DIGEST_ALGORITHM_SHA256));
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(KeyMismatch)
+{
+  const EncodedKeyPair& rsa = keyPairs[0];
+  const EncodedKeyPair& ecdsa = keyPairs[1];
+  const std::string content = "content to be signed";
+
+  for (const CryptoBackend* backend : backends) {
+    BOOST_TEST_MESSAGE(backend->getName());
+
+    BOOST_CHECK_THROW(backend->sign(KEY_TYPE_ECDSA, bytes(rsa.privateKey), rsa.privateKey.size(),
+                                    bytes(content), content.size(), DIGEST_ALGORITHM_SHA256),
+                      CryptoBackend::Error);
+    BOOST_CHECK_THROW(backend->sign(KEY_TYPE_RSA, bytes(content), content.size(),
+                                    bytes(content), content.size(), DIGEST_ALGORITHM_SHA256),
+                      CryptoBackend::Error);
+
+    ConstBufferPtr sig = backend->sign(KEY_TYPE_ECDSA,
+                                       bytes(ecdsa.privateKey), ecdsa.privateKey.size(),
+                                       bytes(content), content.size(), DIGEST_ALGORITHM_SHA256);
+    BOOST_CHECK(!backend->verify(KEY_TYPE_RSA, bytes(ecdsa.publicKey), ecdsa.publicKey.size(),
+                                 bytes(content), content.size(),
+                                 sig->buf(), sig->size(), DIGEST_ALGORITHM_SHA256));
+    BOOST_CHECK(!backend->verify(KEY_TYPE_ECDSA, bytes(rsa.publicKey), rsa.publicKey.size(),
+                                 bytes(content), content.size(),
+                                 sig->buf(), sig->size(), DIGEST_ALGORITHM_SHA256));
+    BOOST_CHECK(!backend->verify(KEY_TYPE_ECDSA, bytes(content), content.size(),
+                                 bytes(content), content.size(),
+                                 sig->buf(), sig->size(), DIGEST_ALGORITHM_SHA256));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(GenerateKeyPair)
+{
+  const std::string content = "content to be signed";
+  const KeyType keyTypes[] = {KEY_TYPE_RSA, KEY_TYPE_ECDSA, KEY_TYPE_ED25519};
+
+  for (const CryptoBackend* generator : backends) {
+    for (KeyType keyType : keyTypes) {
+      if (!generator->isKeyTypeSupported(keyType)) {
+        BOOST_CHECK_THROW(generator->derivePublicKey(keyType, bytes(content), content.size()),
+                          CryptoBackend::Error);
+        continue;
+      }
+      BOOST_TEST_MESSAGE(generator->getName() << " generate, key type " << keyType);
+
+      std::string privateKey, publicKey;
+      generator->generateKeyPair(keyType, keyType == KEY_TYPE_RSA ? 2048 : 256,
+                                 privateKey, publicKey);
+
+      // keys generated by one backend are usable by every backend supporting the key type
+      for (const CryptoBackend* backend : backends) {
+        if (!backend->isKeyTypeSupported(keyType))
+          continue;
+
+        ConstBufferPtr derived = backend->derivePublicKey(keyType, bytes(privateKey),
+                                                          privateKey.size());
+        BOOST_CHECK_EQUAL_COLLECTIONS(derived->begin(), derived->end(),
+                                      publicKey.begin(), publicKey.end());
+
+        ConstBufferPtr sig = backend->sign(keyType, bytes(privateKey), privateKey.size(),
+                                           bytes(content), content.size(),
+                                           DIGEST_ALGORITHM_SHA256);
+        BOOST_CHECK(generator->verify(keyType, bytes(publicKey), publicKey.size(),
+                                      bytes(content), content.size(),
+                                      sig->buf(), sig->size(), DIGEST_ALGORITHM_SHA256));
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(GetDefaultByKeyType)
+{
+  BOOST_CHECK(CryptoBackend::getDefault(KEY_TYPE_RSA).isKeyTypeSupported(KEY_TYPE_RSA));
+  BOOST_CHECK(CryptoBackend::getDefault(KEY_TYPE_ECDSA).isKeyTypeSupported(KEY_TYPE_ECDSA));
+  BOOST_CHECK_THROW(CryptoBackend::getDefault(KEY_TYPE_AES), CryptoBackend::Error);
+
+  bool isEd25519Supported = false;
+  for (const CryptoBackend* backend : backends)
+    isEd25519Supported = isEd25519Supported || backend->isKeyTypeSupported(KEY_TYPE_ED25519);
+
+  if (isEd25519Supported)
+    BOOST_CHECK(CryptoBackend::getDefault(KEY_TYPE_ED25519).isKeyTypeSupported(KEY_TYPE_ED25519));
+  else
+    BOOST_CHECK_THROW(CryptoBackend::getDefault(KEY_TYPE_ED25519), CryptoBackend::Error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace ndn
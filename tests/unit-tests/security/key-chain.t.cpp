@@ -20,6 +20,7 @@
  */
 
 #include "security/key-chain.hpp"
+#include "security/validator.hpp"
 #include "../util/test-home-environment-fixture.hpp"
 #include <boost/filesystem.hpp>
 
@@ -260,6 +261,64 @@ BOOST_AUTO_TEST_CASE(PrepareIdentityCertificate)
   keyChain.deleteIdentity(anotherIdentity);
 }
 
+BOOST_AUTO_TEST_CASE(IssueCertificates)
+{
+  KeyChain keyChain;
+
+  Name identity("/TestKeyChain/IssueCertificates");
+  identity.appendVersion();
+  Name signingCertName = keyChain.createIdentity(identity);
+  shared_ptr<IdentityCertificate> signingCert = keyChain.getCertificate(signingCertName);
+
+  vector<Name> subjects;
+  vector<shared_ptr<IdentityCertificate>> requests;
+  for (int i = 0; i < 8; ++i) {
+    Name subject = Name(identity).append("Device").appendNumber(i);
+    Name keyName = keyChain.generateRsaKeyPair(subject, true);
+    subjects.push_back(subject);
+    requests.push_back(keyChain.selfSign(keyName));
+  }
+
+  // the key name of this request is not formatted correctly
+  shared_ptr<IdentityCertificate> badRequest = make_shared<IdentityCertificate>(*requests[0]);
+  badRequest->setName(Name(identity).append("KEY").append("key-1").append("ID-CERT"));
+  requests.insert(requests.begin() + 3, badRequest);
+
+  vector<CertificateSubjectDescription> subjectDescription;
+  vector<shared_ptr<IdentityCertificate>> certificates =
+    keyChain.issueCertificates(requests, identity,
+                               time::system_clock::now(),
+                               time::system_clock::now() + time::days(365),
+                               subjectDescription, KeyChain::DEFAULT_PREFIX, 4);
+  BOOST_REQUIRE_EQUAL(certificates.size(), requests.size());
+  BOOST_CHECK(certificates[3] == nullptr);
+
+  certificates.erase(certificates.begin() + 3);
+  requests.erase(requests.begin() + 3);
+  for (size_t i = 0; i < certificates.size(); ++i) {
+    BOOST_REQUIRE(certificates[i] != nullptr);
+    BOOST_CHECK_EQUAL(certificates[i]->getPublicKeyName(), requests[i]->getPublicKeyName());
+    BOOST_CHECK_EQUAL(certificates[i]->getSignature().getKeyLocator().getName(),
+                      signingCertName.getPrefix(-1));
+    BOOST_CHECK(Validator::verifySignature(*certificates[i], signingCert->getPublicKeyInfo()));
+  }
+
+  keyChain.addCertificates(certificates);
+  for (const auto& certificate : certificates)
+    BOOST_CHECK(keyChain.doesCertificateExist(certificate->getName()));
+
+  // the signing identity must have a default certificate
+  BOOST_CHECK_THROW(keyChain.issueCertificates(requests, "/TestKeyChain/IssueCertificates/None",
+                                               time::system_clock::now(),
+                                               time::system_clock::now() + time::days(365),
+                                               subjectDescription),
+                    SecPublicInfo::Error);
+
+  for (const Name& subject : subjects)
+    keyChain.deleteIdentity(subject);
+  keyChain.deleteIdentity(identity);
+}
+
 BOOST_AUTO_TEST_CASE(Delete)
 {
   KeyChain keyChain;
@@ -327,6 +386,66 @@ BOOST_AUTO_TEST_CASE(Delete)
   BOOST_CHECK_EQUAL(keyChain.doesIdentityExist(identity), false);
 }
 
+BOOST_AUTO_TEST_CASE(SigningContextInvalidation)
+{
+  KeyChain keyChain;
+
+  Name identity1("/TestKeyChain/SigningContext/1");
+  identity1.appendVersion();
+  Name certName1;
+  BOOST_REQUIRE_NO_THROW(certName1 = keyChain.createIdentity(identity1));
+  BOOST_REQUIRE_NO_THROW(keyChain.setDefaultIdentity(identity1));
+
+  Data data1("/data/1");
+  BOOST_REQUIRE_NO_THROW(keyChain.sign(data1));
+  BOOST_CHECK_EQUAL(data1.getSignature().getKeyLocator().getName(), certName1.getPrefix(-1));
+
+  Name identity2("/TestKeyChain/SigningContext/2");
+  identity2.appendVersion();
+  Name certName2;
+  BOOST_REQUIRE_NO_THROW(certName2 = keyChain.createIdentity(identity2));
+  BOOST_REQUIRE_NO_THROW(keyChain.setDefaultIdentity(identity2));
+
+  // default signing context follows the change of default identity
+  Data data2("/data/2");
+  BOOST_REQUIRE_NO_THROW(keyChain.sign(data2));
+  BOOST_CHECK_EQUAL(data2.getSignature().getKeyLocator().getName(), certName2.getPrefix(-1));
+
+  Data data3("/data/3");
+  BOOST_REQUIRE_NO_THROW(keyChain.sign(data3, certName1));
+  BOOST_CHECK_EQUAL(data3.getSignature().getKeyLocator().getName(), certName1.getPrefix(-1));
+  BOOST_CHECK(data3.getSignature().getInfo() == data1.getSignature().getInfo());
+
+  // a deleted certificate can no longer be used, even though it was used before
+  BOOST_REQUIRE_NO_THROW(keyChain.deleteCertificate(certName1));
+  Data data4("/data/4");
+  BOOST_CHECK_THROW(keyChain.sign(data4, certName1), SecPublicInfo::Error);
+
+  BOOST_REQUIRE_NO_THROW(keyChain.deleteIdentity(identity1));
+  BOOST_REQUIRE_NO_THROW(keyChain.deleteIdentity(identity2));
+}
+
+BOOST_AUTO_TEST_CASE(SignatureValueReserve)
+{
+  KeyChain keyChain;
+
+  Name identity("/TestKeyChain/SignatureValueReserve");
+  identity.appendVersion();
+  BOOST_REQUIRE_NO_THROW(keyChain.createIdentity(identity, EcdsaKeyParams()));
+  Name certName = keyChain.getDefaultCertificateNameForIdentity(identity);
+
+  // the signed wire takes the whole buffer, apart from small variations in the sizes of
+  // ECDSA signature and TLV-LENGTH of Data
+  for (int i = 0; i < 10; ++i) {
+    Data data("/data");
+    BOOST_REQUIRE_NO_THROW(keyChain.sign(data, certName));
+    const Block& wire = data.wireEncode();
+    BOOST_CHECK_LE(wire.getBuffer()->size() - wire.size(), 8);
+  }
+
+  BOOST_REQUIRE_NO_THROW(keyChain.deleteIdentity(identity));
+}
+
 BOOST_AUTO_TEST_CASE(KeyChainWithCustomTpmAndPib)
 {
   BOOST_REQUIRE_NO_THROW((KeyChain("pib-dummy", "tpm-dummy")));
@@ -59,6 +59,17 @@ BOOST_AUTO_TEST_CASE(EcdsaParameter)
   BOOST_CHECK_EQUAL(params3.getKeySize(), 256);
 }
 
+BOOST_AUTO_TEST_CASE(Ed25519Parameter)
+{
+  Ed25519KeyParams params;
+  BOOST_CHECK_EQUAL(params.getKeyType(), KEY_TYPE_ED25519);
+  BOOST_CHECK_EQUAL(params.getKeySize(), 256);
+
+  Ed25519KeyParams params2(384);
+  BOOST_CHECK_EQUAL(params2.getKeyType(), KEY_TYPE_ED25519);
+  BOOST_CHECK_EQUAL(params2.getKeySize(), 256);
+}
+
 BOOST_AUTO_TEST_CASE(AesParameter)
 {
   AesKeyParams params;
@@ -78,6 +89,21 @@ BOOST_AUTO_TEST_CASE(AesParameter)
   BOOST_CHECK_EQUAL(params4.getKeySize(), 64);
 }
 
+BOOST_AUTO_TEST_CASE(HmacParameter)
+{
+  HmacKeyParams params;
+  BOOST_CHECK_EQUAL(params.getKeyType(), KEY_TYPE_HMAC);
+  BOOST_CHECK_EQUAL(params.getKeySize(), 256);
+
+  HmacKeyParams params2(512);
+  BOOST_CHECK_EQUAL(params2.getKeyType(), KEY_TYPE_HMAC);
+  BOOST_CHECK_EQUAL(params2.getKeySize(), 512);
+
+  HmacKeyParams params3(12);
+  BOOST_CHECK_EQUAL(params3.getKeyType(), KEY_TYPE_HMAC);
+  BOOST_CHECK_EQUAL(params3.getKeySize(), 256);
+}
+
 BOOST_AUTO_TEST_CASE(Error)
 {
   EcdsaKeyParams params;
@@ -0,0 +1,111 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "security/key-timestamp-table.hpp"
+
+#include "boost-test.hpp"
+#include "../unit-test-time-fixture.hpp"
+
+namespace ndn {
+namespace security {
+namespace tests {
+
+using ndn::tests::UnitTestTimeFixture;
+
+BOOST_FIXTURE_TEST_SUITE(SecurityKeyTimestampTable, UnitTestTimeFixture)
+
+BOOST_AUTO_TEST_CASE(FindUpdate)
+{
+  KeyTimestampTable table(10, time::hours(1));
+  time::system_clock::TimePoint timestamp;
+
+  BOOST_CHECK_EQUAL(table.find("/A/KEY/1", timestamp), false);
+  BOOST_CHECK_EQUAL(table.getNMisses(), 1);
+
+  time::system_clock::TimePoint t1 = time::system_clock::now();
+  table.update("/A/KEY/1", t1);
+  BOOST_CHECK_EQUAL(table.size(), 1);
+  BOOST_REQUIRE_EQUAL(table.find("/A/KEY/1", timestamp), true);
+  BOOST_CHECK(timestamp == t1);
+
+  time::system_clock::TimePoint t2 = t1 + time::seconds(5);
+  table.update("/A/KEY/1", t2);
+  BOOST_CHECK_EQUAL(table.size(), 1);
+  BOOST_REQUIRE_EQUAL(table.find("/A/KEY/1", timestamp), true);
+  BOOST_CHECK(timestamp == t2);
+
+  BOOST_CHECK_EQUAL(table.getNHits(), 2);
+  BOOST_CHECK_EQUAL(table.getNMisses(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(Eviction)
+{
+  KeyTimestampTable table(2, time::hours(1));
+  time::system_clock::TimePoint timestamp;
+  time::system_clock::TimePoint now = time::system_clock::now();
+
+  table.update("/A/KEY/1", now);
+  table.update("/B/KEY/1", now);
+  // refreshing /A makes /B the least recently updated key
+  table.update("/A/KEY/1", now);
+  table.update("/C/KEY/1", now);
+
+  BOOST_CHECK_EQUAL(table.size(), 2);
+  BOOST_CHECK_EQUAL(table.getNEvictions(), 1);
+  BOOST_CHECK_EQUAL(table.find("/A/KEY/1", timestamp), true);
+  BOOST_CHECK_EQUAL(table.find("/B/KEY/1", timestamp), false);
+  BOOST_CHECK_EQUAL(table.find("/C/KEY/1", timestamp), true);
+
+  KeyTimestampTable empty(0, time::hours(1));
+  empty.update("/A/KEY/1", now);
+  BOOST_CHECK_EQUAL(empty.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(Expiration)
+{
+  KeyTimestampTable table(10, time::seconds(10));
+  time::system_clock::TimePoint timestamp;
+
+  table.update("/A/KEY/1", time::system_clock::now());
+  advanceClocks(time::seconds(6));
+  table.update("/B/KEY/1", time::system_clock::now());
+  advanceClocks(time::seconds(6));
+
+  // /A has not been updated for 12 seconds and is dropped when a new key arrives
+  table.update("/C/KEY/1", time::system_clock::now());
+  BOOST_CHECK_EQUAL(table.size(), 2);
+  BOOST_CHECK_EQUAL(table.getNExpirations(), 1);
+  BOOST_CHECK_EQUAL(table.getNEvictions(), 0);
+  BOOST_CHECK_EQUAL(table.find("/A/KEY/1", timestamp), false);
+  BOOST_CHECK_EQUAL(table.find("/B/KEY/1", timestamp), true);
+
+  // /B has not been updated for 11 seconds and is dropped when it is looked up
+  advanceClocks(time::seconds(5));
+  BOOST_CHECK_EQUAL(table.find("/B/KEY/1", timestamp), false);
+  BOOST_CHECK_EQUAL(table.size(), 1);
+  BOOST_CHECK_EQUAL(table.getNExpirations(), 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace security
+} // namespace ndn
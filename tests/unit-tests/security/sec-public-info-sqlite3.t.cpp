@@ -135,6 +135,41 @@ BOOST_AUTO_TEST_CASE(KeyTypeEcdsa)
   pib.deleteIdentityInfo(Name("/TestSecPublicInfoSqlite3/KeyType/ECDSA"));
 }
 
+BOOST_FIXTURE_TEST_CASE(FailedUpdateIsRolledBack, PibTmpPathFixture)
+{
+  using namespace CryptoPP;
+
+  OBufferStream os;
+  StringSource ss(reinterpret_cast<const uint8_t*>(ECDSA_DER.c_str()), ECDSA_DER.size(),
+                  true, new Base64Decoder(new FileSink(os)));
+  PublicKey key(os.buf()->buf(), os.buf()->size());
+
+  SecPublicInfoSqlite3 pib(tmpPath.generic_string());
+  Name identity("/TestSecPublicInfoSqlite3/Rollback");
+  Name keyName1 = Name(identity).append("ksk-1");
+  Name keyName2 = Name(identity).append("ksk-2");
+
+  // repeated use of the same prepared statements
+  for (int i = 0; i < 3; ++i) {
+    pib.addKey(keyName1, key);
+    BOOST_CHECK(pib.doesPublicKeyExist(keyName1));
+  }
+  pib.setDefaultKeyNameForIdentity(keyName1);
+  BOOST_CHECK_EQUAL(pib.getDefaultKeyNameForIdentity(identity), keyName1);
+
+  // the default key is not reset when the new default does not exist
+  BOOST_CHECK_THROW(pib.setDefaultKeyNameForIdentity(keyName2), SecPublicInfo::Error);
+  BOOST_CHECK_EQUAL(pib.getDefaultKeyNameForIdentity(identity), keyName1);
+
+  pib.addKey(keyName2, key);
+  pib.setDefaultKeyNameForIdentity(keyName2);
+  BOOST_CHECK_EQUAL(pib.getDefaultKeyNameForIdentity(identity), keyName2);
+
+  pib.deleteIdentityInfo(identity);
+  BOOST_CHECK(!pib.doesIdentityExist(identity));
+  BOOST_CHECK(!pib.doesPublicKeyExist(keyName1));
+}
+
 BOOST_AUTO_TEST_CASE(KeyTypeNonExist)
 {
   Name nullKeyName("/TestSecPublicInfoSqlite3/KeyType/Null");
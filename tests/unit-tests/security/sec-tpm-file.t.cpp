@@ -21,10 +21,12 @@
 
 #include "security/sec-tpm-file.hpp"
 #include "security/key-chain.hpp"
+#include "security/validator.hpp"
 #include "security/cryptopp.hpp"
 
 #include "util/time.hpp"
 
+#include <boost/asio/io_service.hpp>
 #include <boost/filesystem.hpp>
 #include <boost/lexical_cast.hpp>
 #include "boost-test.hpp"
@@ -32,6 +34,26 @@
 namespace ndn {
 namespace tests {
 
+class TpmTmpPathFixture
+{
+public:
+  TpmTmpPathFixture()
+  {
+    boost::system::error_code error;
+    tmpPath = boost::filesystem::temp_directory_path(error);
+    BOOST_REQUIRE(boost::system::errc::success == error.value());
+    tmpPath /= boost::lexical_cast<std::string>(random::generateWord32());
+  }
+
+  ~TpmTmpPathFixture()
+  {
+    boost::filesystem::remove_all(tmpPath);
+  }
+
+public:
+  boost::filesystem::path tmpPath;
+};
+
 BOOST_AUTO_TEST_SUITE(SecuritySecTpmFile)
 
 BOOST_AUTO_TEST_CASE(Delete)
@@ -290,6 +312,128 @@ BOOST_AUTO_TEST_CASE(EcdsaSigning)
   tpm.deleteKeyPairInTpm(keyName);
 }
 
+BOOST_AUTO_TEST_CASE(ReserveKeyPairs)
+{
+  SecTpmFile tpm;
+
+  EcdsaKeyParams params;
+  BOOST_REQUIRE_NO_THROW(tpm.reserveKeyPairs(params, 2));
+  BOOST_CHECK_EQUAL(tpm.getKeyPairReserve(params), 2);
+  BOOST_CHECK_EQUAL(tpm.getKeyPairReserve(AesKeyParams()), 0);
+
+  Name prefix("/TestSecTpmFile/ReserveKeyPairs");
+  prefix.appendVersion();
+  const uint8_t content[] = {0x01, 0x02, 0x03, 0x04};
+  std::vector<shared_ptr<PublicKey>> publicKeys;
+
+  // more keys than reserved, so that some are generated on demand
+  for (int i = 0; i < 4; ++i) {
+    Name keyName = Name(prefix).append("ksk-" + boost::lexical_cast<std::string>(i));
+    BOOST_REQUIRE_NO_THROW(tpm.generateKeyPairInTpm(keyName, params));
+    BOOST_CHECK_THROW(tpm.generateKeyPairInTpm(keyName, params), SecTpmFile::Error);
+
+    shared_ptr<PublicKey> publicKey = tpm.getPublicKeyFromTpm(keyName);
+    BOOST_CHECK_EQUAL(publicKey->getKeyType(), KEY_TYPE_ECDSA);
+    for (const auto& otherKey : publicKeys)
+      BOOST_CHECK(!(*otherKey == *publicKey));
+    publicKeys.push_back(publicKey);
+
+    SignatureSha256WithEcdsa signature;
+    signature.setValue(tpm.signInTpm(content, sizeof(content), keyName, DIGEST_ALGORITHM_SHA256));
+    BOOST_CHECK(Validator::verifySignature(content, sizeof(content), signature, *publicKey));
+
+    tpm.deleteKeyPairInTpm(keyName);
+  }
+
+  BOOST_CHECK_NO_THROW(tpm.reserveKeyPairs(params, 0));
+  BOOST_CHECK_EQUAL(tpm.getKeyPairReserve(params), 0);
+  BOOST_CHECK_THROW(tpm.reserveKeyPairs(AesKeyParams(), 1), SecTpmFile::Error);
+}
+
+BOOST_AUTO_TEST_CASE(GenerateKeyPairAsync)
+{
+  SecTpmFile tpm;
+  boost::asio::io_service ioService;
+
+  Name keyName("/TestSecTpmFile/GenerateKeyPairAsync/ksk-1");
+  keyName.appendVersion();
+
+  // the key pair may be produced by a background thread, so keep run() from returning early
+  unique_ptr<boost::asio::io_service::work> work(new boost::asio::io_service::work(ioService));
+  int nGenerated = 0;
+  std::vector<std::string> failures;
+  auto onGenerated = [&] {
+    ++nGenerated;
+    work.reset();
+  };
+  auto onFailed = [&] (const std::string& reason) {
+    failures.push_back(reason);
+    work.reset();
+  };
+
+  BOOST_REQUIRE_NO_THROW(tpm.reserveKeyPairs(EcdsaKeyParams(), 1));
+  tpm.generateKeyPairInTpmAsync(keyName, EcdsaKeyParams(), ioService, onGenerated, onFailed);
+  ioService.run();
+  BOOST_CHECK_EQUAL(nGenerated, 1);
+  BOOST_CHECK_EQUAL(failures.size(), 0);
+
+  shared_ptr<PublicKey> publicKey;
+  BOOST_REQUIRE_NO_THROW(publicKey = tpm.getPublicKeyFromTpm(keyName));
+  BOOST_CHECK_EQUAL(publicKey->getKeyType(), KEY_TYPE_ECDSA);
+
+  // the key already exists
+  ioService.reset();
+  work.reset(new boost::asio::io_service::work(ioService));
+  tpm.generateKeyPairInTpmAsync(keyName, EcdsaKeyParams(), ioService, onGenerated, onFailed);
+  ioService.run();
+  BOOST_CHECK_EQUAL(nGenerated, 1);
+  BOOST_CHECK_EQUAL(failures.size(), 1);
+
+  // symmetric keys cannot be generated as a pair
+  Name aesKeyName("/TestSecTpmFile/GenerateKeyPairAsync/dsk-1");
+  aesKeyName.appendVersion();
+  ioService.reset();
+  work.reset(new boost::asio::io_service::work(ioService));
+  tpm.generateKeyPairInTpmAsync(aesKeyName, AesKeyParams(), ioService, onGenerated, onFailed);
+  ioService.run();
+  BOOST_CHECK_EQUAL(nGenerated, 1);
+  BOOST_CHECK_EQUAL(failures.size(), 2);
+
+  tpm.deleteKeyPairInTpm(keyName);
+  tpm.reserveKeyPairs(EcdsaKeyParams(), 0);
+}
+
+BOOST_FIXTURE_TEST_CASE(KeyFormat, TpmTmpPathFixture)
+{
+  std::string location = tmpPath.generic_string();
+  SecTpmFile base64Tpm(location);
+  SecTpmFile derTpm(location + "?format=der");
+  BOOST_CHECK_EQUAL(derTpm.getTpmLocator(), base64Tpm.getTpmLocator());
+  BOOST_CHECK_THROW(SecTpmFile(location + "?format=pem"), SecTpmFile::Error);
+
+  Name base64KeyName("/TestSecTpmFile/KeyFormat/ksk-1");
+  Name derKeyName("/TestSecTpmFile/KeyFormat/ksk-2");
+  BOOST_REQUIRE_NO_THROW(base64Tpm.generateKeyPairInTpm(base64KeyName, RsaKeyParams()));
+  BOOST_REQUIRE_NO_THROW(derTpm.generateKeyPairInTpm(derKeyName, EcdsaKeyParams()));
+
+  const uint8_t content[] = {0x01, 0x02, 0x03, 0x04};
+  for (const Name& keyName : {base64KeyName, derKeyName}) {
+    // both TPMs read keys stored in either format
+    shared_ptr<PublicKey> publicKey = base64Tpm.getPublicKeyFromTpm(keyName);
+    BOOST_CHECK(*publicKey == *derTpm.getPublicKeyFromTpm(keyName));
+
+    for (SecTpmFile* tpm : {&base64Tpm, &derTpm}) {
+      Block sigValue = tpm->signInTpm(content, sizeof(content), keyName, DIGEST_ALGORITHM_SHA256);
+      Signature signature;
+      if (publicKey->getKeyType() == KEY_TYPE_RSA)
+        signature = SignatureSha256WithRsa();
+      else
+        signature = SignatureSha256WithEcdsa();
+      signature.setValue(sigValue);
+      BOOST_CHECK(Validator::verifySignature(content, sizeof(content), signature, *publicKey));
+    }
+  }
+}
 
 BOOST_AUTO_TEST_CASE(ImportExportEcdsaKey)
 {
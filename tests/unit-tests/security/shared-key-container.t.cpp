@@ -0,0 +1,89 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+
+#include "security/shared-key-container.hpp"
+
+#include "boost-test.hpp"
+
+namespace ndn {
+namespace security {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(SecuritySharedKeyContainer)
+
+BOOST_AUTO_TEST_CASE(InsertFind)
+{
+  SharedKeyContainer container;
+  BOOST_CHECK(container.empty());
+
+  const uint8_t key[] = {0x01, 0x02, 0x03, 0x04};
+  container.insert("/cluster", "/cluster/KEY/hmac", make_shared<Buffer>(key, sizeof(key)));
+  BOOST_CHECK_EQUAL(container.size(), 1);
+
+  ConstBufferPtr found = container.find("/cluster/KEY/hmac", "/cluster/node1/data");
+  BOOST_REQUIRE(found != nullptr);
+  BOOST_CHECK_EQUAL_COLLECTIONS(found->begin(), found->end(), key, key + sizeof(key));
+
+  BOOST_CHECK(container.find("/cluster/KEY/hmac", "/cluster") != nullptr);
+  BOOST_CHECK(container.find("/cluster/KEY/hmac", "/other/data") == nullptr);
+  BOOST_CHECK(container.find("/cluster/KEY/other", "/cluster/node1/data") == nullptr);
+
+  // inserting the same key name again replaces the prefix and the key
+  container.insert("/cluster/node1", "/cluster/KEY/hmac", make_shared<Buffer>(key, 2));
+  BOOST_CHECK_EQUAL(container.size(), 1);
+  BOOST_CHECK(container.find("/cluster/KEY/hmac", "/cluster/node2/data") == nullptr);
+  found = container.find("/cluster/KEY/hmac", "/cluster/node1/data");
+  BOOST_REQUIRE(found != nullptr);
+  BOOST_CHECK_EQUAL(found->size(), 2);
+
+  container.clear();
+  BOOST_CHECK(container.empty());
+}
+
+BOOST_AUTO_TEST_CASE(InsertBase64)
+{
+  SharedKeyContainer container;
+
+  container.insert("/cluster", "/cluster/KEY/hmac", std::string("AQIDBA=="));
+  ConstBufferPtr found = container.find("/cluster/KEY/hmac", "/cluster/data");
+  BOOST_REQUIRE(found != nullptr);
+
+  const uint8_t key[] = {0x01, 0x02, 0x03, 0x04};
+  BOOST_CHECK_EQUAL_COLLECTIONS(found->begin(), found->end(), key, key + sizeof(key));
+}
+
+BOOST_AUTO_TEST_CASE(EmptyKey)
+{
+  SharedKeyContainer container;
+
+  BOOST_CHECK_THROW(container.insert("/cluster", "/cluster/KEY/hmac", make_shared<Buffer>()),
+                    SharedKeyContainer::Error);
+  BOOST_CHECK_THROW(container.insert("/cluster", "/cluster/KEY/hmac", std::string("")),
+                    SharedKeyContainer::Error);
+  BOOST_CHECK(container.empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace security
+} // namespace ndn
@@ -0,0 +1,169 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+
+#include "security/signature-hmac-with-sha256.hpp"
+#include "security/key-chain.hpp"
+#include "security/validator.hpp"
+#include "identity-management-fixture.hpp"
+#include "boost-test.hpp"
+
+namespace ndn {
+namespace tests {
+
+class SignatureHmacWithSha256Fixture : public security::IdentityManagementFixture
+{
+public:
+  SignatureHmacWithSha256Fixture()
+    : keyName("/SecurityTestSignatureHmacWithSha256/KEY/hmac")
+  {
+    m_keyChain.generateSymmetricKeyInTpm(keyName, HmacKeyParams());
+    key = m_keyChain.exportSymmetricKeyFromTpm(keyName);
+  }
+
+  ~SignatureHmacWithSha256Fixture()
+  {
+    m_keyChain.deleteKeyPairInTpm(keyName);
+  }
+
+public:
+  Name keyName;
+  ConstBufferPtr key;
+};
+
+BOOST_FIXTURE_TEST_SUITE(SecuritySignatureHmacWithSha256, SignatureHmacWithSha256Fixture)
+
+const uint8_t sigInfo[] = {
+0x16, 0x1b, // SignatureInfo
+  0x1b, 0x01, // SignatureType
+    0x04,
+  0x1c, 0x16, // KeyLocator
+    0x07, 0x14, // Name
+      0x08, 0x04,
+        0x74, 0x65, 0x73, 0x74,
+      0x08, 0x03,
+        0x6b, 0x65, 0x79,
+      0x08, 0x07,
+        0x6c, 0x6f, 0x63, 0x61, 0x74, 0x6f, 0x72
+};
+
+const uint8_t sigValue[] = {
+0x17, 0x20, // SignatureValue
+  0xb0, 0x34, 0x4c, 0x61, 0xd8, 0xdb, 0x38, 0x53, 0x5c, 0xa8, 0xaf, 0xce, 0xaf,
+  0x0b, 0xf1, 0x2b, 0x88, 0x1d, 0xc2, 0x00, 0xc9, 0x83, 0x3d, 0xa7, 0x26, 0xe9,
+  0x37, 0x6c, 0x2e, 0x32, 0xcf, 0xf7
+};
+
+
+BOOST_AUTO_TEST_CASE(Decoding)
+{
+  Block sigInfoBlock(sigInfo, sizeof(sigInfo));
+  Block sigValueBlock(sigValue, sizeof(sigValue));
+
+  Signature sig(sigInfoBlock, sigValueBlock);
+  BOOST_CHECK_NO_THROW(SignatureHmacWithSha256(sig));
+  BOOST_CHECK_NO_THROW(sig.getKeyLocator());
+}
+
+BOOST_AUTO_TEST_CASE(Encoding)
+{
+  Name name("/test/key/locator");
+  KeyLocator keyLocator(name);
+
+  SignatureHmacWithSha256 sig(keyLocator);
+
+  BOOST_CHECK_NO_THROW(sig.getKeyLocator());
+
+  const Block& encodeSigInfoBlock = sig.getInfo();
+
+  Block sigInfoBlock(sigInfo, sizeof(sigInfo));
+
+  BOOST_CHECK_EQUAL_COLLECTIONS(sigInfoBlock.wire(),
+                                sigInfoBlock.wire() + sigInfoBlock.size(),
+                                encodeSigInfoBlock.wire(),
+                                encodeSigInfoBlock.wire() + encodeSigInfoBlock.size());
+
+  sig.setKeyLocator(Name("/test/another/key/locator"));
+
+  const Block& encodeSigInfoBlock2 = sig.getInfo();
+  BOOST_CHECK(sigInfoBlock != encodeSigInfoBlock2);
+}
+
+BOOST_AUTO_TEST_CASE(DataSignature)
+{
+  BOOST_REQUIRE_EQUAL(key->size(), 32);
+
+  Data testData("/SecurityTestSignatureHmacWithSha256/DataSignature/Data1");
+  char content[5] = "1234";
+  testData.setContent(reinterpret_cast<uint8_t*>(content), 5);
+  BOOST_CHECK_NO_THROW(m_keyChain.signWithHmac(testData, keyName));
+  BOOST_CHECK_EQUAL(testData.getSignature().getType(), tlv::SignatureHmacWithSha256);
+  BOOST_CHECK_EQUAL(testData.getSignature().getKeyLocator().getName(), keyName);
+
+  Block dataBlock(testData.wireEncode().wire(), testData.wireEncode().size());
+
+  Data testData2;
+  testData2.wireDecode(dataBlock);
+  SignatureHmacWithSha256 sig(testData2.getSignature());
+  BOOST_CHECK(Validator::verifySignature(testData2, sig, *key));
+
+  Buffer otherKey(key->begin(), key->end());
+  otherKey[0] ^= 0x01;
+  BOOST_CHECK(!Validator::verifySignature(testData2, sig, otherKey));
+
+  testData2.setContent(reinterpret_cast<uint8_t*>(content), 4);
+  BOOST_CHECK(!Validator::verifySignature(testData2, sig, *key));
+}
+
+BOOST_AUTO_TEST_CASE(InterestSignature)
+{
+  Interest interest("/SecurityTestSignatureHmacWithSha256/InterestSignature/Interest1");
+  BOOST_CHECK_NO_THROW(m_keyChain.signWithHmac(interest, keyName));
+
+  Block interestBlock(interest.wireEncode().wire(), interest.wireEncode().size());
+
+  Interest interest2;
+  interest2.wireDecode(interestBlock);
+
+  const Name& interestName = interest2.getName();
+  Signature signature(interestName[signed_interest::POS_SIG_INFO].blockFromValue(),
+                      interestName[signed_interest::POS_SIG_VALUE].blockFromValue());
+  SignatureHmacWithSha256 sig(signature);
+  BOOST_CHECK_EQUAL(sig.getKeyLocator().getName(), keyName);
+  BOOST_CHECK(Validator::verifySignature(interest2, sig, *key));
+
+  Buffer otherKey(key->begin(), key->end());
+  otherKey[0] ^= 0x01;
+  BOOST_CHECK(!Validator::verifySignature(interest2, sig, otherKey));
+}
+
+BOOST_AUTO_TEST_CASE(MissingKey)
+{
+  Data testData("/SecurityTestSignatureHmacWithSha256/MissingKey/Data1");
+  BOOST_CHECK_THROW(m_keyChain.signWithHmac(testData,
+                                            "/SecurityTestSignatureHmacWithSha256/KEY/none"),
+                    SecTpm::Error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace ndn
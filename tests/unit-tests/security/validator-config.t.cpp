@@ -1506,6 +1506,116 @@ BOOST_FIXTURE_TEST_CASE(TrustAnchorDir, DirTestFixture)
   advanceClocks(time::milliseconds(10), 20);
 }
 
+BOOST_FIXTURE_TEST_CASE(SharedKey, security::IdentityManagementFixture)
+{
+  Name keyName("/TestValidatorConfig/SharedKey/KEY/hmac");
+  uint8_t key[32];
+  for (size_t i = 0; i < sizeof(key); i++)
+    key[i] = i + 1;
+  BOOST_REQUIRE(m_keyChain.importSymmetricKeyIntoTpm(keyName, key, sizeof(key)));
+
+  Name otherKeyName("/TestValidatorConfig/SharedKey/KEY/other");
+  m_keyChain.generateSymmetricKeyInTpm(otherKeyName, HmacKeyParams());
+
+  shared_ptr<Data> data1 = make_shared<Data>("/cluster/data");
+  BOOST_CHECK_NO_THROW(m_keyChain.signWithHmac(*data1, keyName));
+
+  shared_ptr<Data> data2 = make_shared<Data>("/other/data");
+  BOOST_CHECK_NO_THROW(m_keyChain.signWithHmac(*data2, keyName));
+
+  shared_ptr<Data> data3 = make_shared<Data>("/cluster/data3");
+  BOOST_CHECK_NO_THROW(m_keyChain.signWithHmac(*data3, otherKeyName));
+
+  shared_ptr<Interest> interest1 = make_shared<Interest>("/cluster/command");
+  BOOST_CHECK_NO_THROW(m_keyChain.signWithHmac(*interest1, keyName));
+
+  std::string CONFIG_RULES =
+    "rule\n"
+    "{\n"
+    "  id \"Cluster Data Rule\"\n"
+    "  for data\n"
+    "  checker\n"
+    "  {\n"
+    "    type customized\n"
+    "    sig-type hmac-sha256\n"
+    "    key-locator\n"
+    "    {\n"
+    "      type name\n"
+    "      name /TestValidatorConfig/SharedKey/KEY\n"
+    "      relation is-prefix-of\n"
+    "    }\n"
+    "  }\n"
+    "}\n"
+    "rule\n"
+    "{\n"
+    "  id \"Cluster Interest Rule\"\n"
+    "  for interest\n"
+    "  checker\n"
+    "  {\n"
+    "    type customized\n"
+    "    sig-type hmac-sha256\n"
+    "    key-locator\n"
+    "    {\n"
+    "      type name\n"
+    "      name /TestValidatorConfig/SharedKey/KEY\n"
+    "      relation is-prefix-of\n"
+    "    }\n"
+    "  }\n"
+    "}\n";
+
+  std::string CONFIG_KEY =
+    "shared-key\n"
+    "{\n"
+    "  prefix /cluster\n"
+    "  key-name /TestValidatorConfig/SharedKey/KEY/hmac\n"
+    "  type base64\n"
+    "  base64-string \"AQIDBAUGBwgJCgsMDQ4PEBESExQVFhcYGRobHB0eHyA=\"\n"
+    "}\n";
+
+  const boost::filesystem::path CONFIG_PATH =
+    (boost::filesystem::current_path() / std::string("unit-test-nfd.conf"));
+
+  Face face;
+  ValidatorConfig validator(face);
+  validator.load(CONFIG_RULES + CONFIG_KEY, CONFIG_PATH.native());
+  BOOST_CHECK(!validator.isEmpty());
+
+  validator.validate(*data1,
+    [] (const shared_ptr<const Data>&) { BOOST_CHECK(true); },
+    [] (const shared_ptr<const Data>&, const string&) { BOOST_CHECK(false); });
+
+  // not under the prefix of the key
+  validator.validate(*data2,
+    [] (const shared_ptr<const Data>&) { BOOST_CHECK(false); },
+    [] (const shared_ptr<const Data>&, const string&) { BOOST_CHECK(true); });
+
+  // unknown key
+  validator.validate(*data3,
+    [] (const shared_ptr<const Data>&) { BOOST_CHECK(false); },
+    [] (const shared_ptr<const Data>&, const string&) { BOOST_CHECK(true); });
+
+  validator.validate(*interest1,
+    [] (const shared_ptr<const Interest>&) { BOOST_CHECK(true); },
+    [] (const shared_ptr<const Interest>&, const string&) { BOOST_CHECK(false); });
+
+  // the same key given through the API
+  ValidatorConfig validator2(face);
+  validator2.load(CONFIG_RULES, CONFIG_PATH.native());
+
+  validator2.validate(*data1,
+    [] (const shared_ptr<const Data>&) { BOOST_CHECK(false); },
+    [] (const shared_ptr<const Data>&, const string&) { BOOST_CHECK(true); });
+
+  validator2.addSharedKey("/cluster", keyName, make_shared<Buffer>(key, sizeof(key)));
+
+  validator2.validate(*data1,
+    [] (const shared_ptr<const Data>&) { BOOST_CHECK(true); },
+    [] (const shared_ptr<const Data>&, const string&) { BOOST_CHECK(false); });
+
+  m_keyChain.deleteKeyPairInTpm(keyName);
+  m_keyChain.deleteKeyPairInTpm(otherKeyName);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace tests
@@ -0,0 +1,118 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "util/crypto.hpp"
+
+#include "boost-test.hpp"
+
+namespace ndn {
+namespace crypto {
+namespace test {
+
+BOOST_AUTO_TEST_SUITE(UtilCrypto)
+
+static const uint8_t ABC[] = {'a', 'b', 'c'};
+
+// FIPS 180-2, B.1
+static const uint8_t ABC_DIGEST[] = {
+  0xba, 0x78, 0x16, 0xbf, 0x8f, 0x01, 0xcf, 0xea, 0x41, 0x41, 0x40, 0xde, 0x5d, 0xae, 0x22, 0x23,
+  0xb0, 0x03, 0x61, 0xa3, 0x96, 0x17, 0x7a, 0x9c, 0xb4, 0x10, 0xff, 0x61, 0xf2, 0x00, 0x15, 0xad
+};
+
+static const uint8_t EMPTY_DIGEST[] = {
+  0xe3, 0xb0, 0xc4, 0x42, 0x98, 0xfc, 0x1c, 0x14, 0x9a, 0xfb, 0xf4, 0xc8, 0x99, 0x6f, 0xb9, 0x24,
+  0x27, 0xae, 0x41, 0xe4, 0x64, 0x9b, 0x93, 0x4c, 0xa4, 0x95, 0x99, 0x1b, 0x78, 0x52, 0xb8, 0x55
+};
+
+BOOST_AUTO_TEST_CASE(Sha256)
+{
+  ConstBufferPtr digest = sha256(ABC, sizeof(ABC));
+  BOOST_REQUIRE(digest != nullptr);
+  BOOST_CHECK_EQUAL_COLLECTIONS(digest->begin(), digest->end(),
+                                ABC_DIGEST, ABC_DIGEST + sizeof(ABC_DIGEST));
+
+  uint8_t digest2[SHA256_DIGEST_SIZE];
+  sha256(ABC, sizeof(ABC), digest2);
+  BOOST_CHECK_EQUAL_COLLECTIONS(digest2, digest2 + sizeof(digest2),
+                                ABC_DIGEST, ABC_DIGEST + sizeof(ABC_DIGEST));
+
+  sha256(ABC, 0, digest2);
+  BOOST_CHECK_EQUAL_COLLECTIONS(digest2, digest2 + sizeof(digest2),
+                                EMPTY_DIGEST, EMPTY_DIGEST + sizeof(EMPTY_DIGEST));
+}
+
+BOOST_AUTO_TEST_CASE(Sha256Batch)
+{
+  std::vector<uint8_t> large(100000, 0x5A);
+  const uint8_t* data[] = {ABC, ABC, large.data(), ABC};
+  size_t dataLength[] = {sizeof(ABC), 0, large.size(), sizeof(ABC)};
+  const size_t nBuffers = sizeof(data) / sizeof(data[0]);
+
+  uint8_t digests[nBuffers * SHA256_DIGEST_SIZE];
+  sha256Batch(data, dataLength, nBuffers, digests);
+
+  for (size_t i = 0; i < nBuffers; ++i) {
+    uint8_t expected[SHA256_DIGEST_SIZE];
+    sha256(data[i], dataLength[i], expected);
+    BOOST_CHECK_EQUAL_COLLECTIONS(digests + i * SHA256_DIGEST_SIZE,
+                                  digests + (i + 1) * SHA256_DIGEST_SIZE,
+                                  expected, expected + sizeof(expected));
+  }
+
+  BOOST_CHECK_EQUAL_COLLECTIONS(digests + SHA256_DIGEST_SIZE, digests + 2 * SHA256_DIGEST_SIZE,
+                                EMPTY_DIGEST, EMPTY_DIGEST + sizeof(EMPTY_DIGEST));
+
+  BOOST_CHECK_NO_THROW(sha256Batch(nullptr, nullptr, 0, nullptr));
+}
+
+BOOST_AUTO_TEST_CASE(HmacSha256)
+{
+  // RFC 4231, test case 1
+  std::vector<uint8_t> key1(20, 0x0b);
+  const std::string data1 = "Hi There";
+  static const uint8_t HMAC1[] = {
+    0xb0, 0x34, 0x4c, 0x61, 0xd8, 0xdb, 0x38, 0x53, 0x5c, 0xa8, 0xaf, 0xce, 0xaf, 0x0b, 0xf1, 0x2b,
+    0x88, 0x1d, 0xc2, 0x00, 0xc9, 0x83, 0x3d, 0xa7, 0x26, 0xe9, 0x37, 0x6c, 0x2e, 0x32, 0xcf, 0xf7
+  };
+
+  uint8_t hmac[SHA256_DIGEST_SIZE];
+  hmacSha256(key1.data(), key1.size(),
+             reinterpret_cast<const uint8_t*>(data1.data()), data1.size(), hmac);
+  BOOST_CHECK_EQUAL_COLLECTIONS(hmac, hmac + sizeof(hmac), HMAC1, HMAC1 + sizeof(HMAC1));
+
+  // RFC 4231, test case 2
+  const std::string key2 = "Jefe";
+  const std::string data2 = "what do ya want for nothing?";
+  static const uint8_t HMAC2[] = {
+    0x5b, 0xdc, 0xc1, 0x46, 0xbf, 0x60, 0x75, 0x4e, 0x6a, 0x04, 0x24, 0x26, 0x08, 0x95, 0x75, 0xc7,
+    0x5a, 0x00, 0x3f, 0x08, 0x9d, 0x27, 0x39, 0x83, 0x9d, 0xec, 0x58, 0xb9, 0x64, 0xec, 0x38, 0x43
+  };
+
+  hmacSha256(reinterpret_cast<const uint8_t*>(key2.data()), key2.size(),
+             reinterpret_cast<const uint8_t*>(data2.data()), data2.size(), hmac);
+  BOOST_CHECK_EQUAL_COLLECTIONS(hmac, hmac + sizeof(hmac), HMAC2, HMAC2 + sizeof(HMAC2));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace test
+} // namespace crypto
+} // namespace ndn
@@ -0,0 +1,274 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "util/disk-storage.hpp"
+#include "security/key-chain.hpp"
+
+#include "boost-test.hpp"
+#include "../make-interest-data.hpp"
+#include "../unit-test-time-fixture.hpp"
+
+#include <boost/filesystem.hpp>
+
+namespace ndn {
+namespace util {
+namespace tests {
+
+class DiskStorageFixture : public ndn::tests::UnitTestTimeFixture
+{
+public:
+  DiskStorageFixture()
+    : path((boost::filesystem::temp_directory_path() / "ndn-cxx-disk-storage-test.log").string())
+  {
+    boost::filesystem::remove(path);
+  }
+
+  ~DiskStorageFixture()
+  {
+    boost::filesystem::remove(path);
+  }
+
+  static shared_ptr<Data>
+  makeData(const Name& name, uint8_t content)
+  {
+    shared_ptr<Data> data = make_shared<Data>(name);
+    data->setContent(&content, 1);
+    data->setFreshnessPeriod(time::seconds(10));
+    return signData(data);
+  }
+
+  static uint8_t
+  getContent(const shared_ptr<const Data>& data)
+  {
+    BOOST_REQUIRE(data != nullptr);
+    BOOST_REQUIRE_EQUAL(data->getContent().value_size(), 1);
+    return data->getContent().value()[0];
+  }
+
+public:
+  std::string path;
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilDiskStorage, DiskStorageFixture)
+
+BOOST_AUTO_TEST_CASE(InsertFind)
+{
+  DiskStorage storage(path);
+  BOOST_CHECK_EQUAL(storage.size(), 0);
+
+  shared_ptr<Data> data1 = makeData("/A/1", 1);
+  storage.insert(*data1);
+  BOOST_CHECK_EQUAL(getContent(storage.find(Name("/A/1"))), 1);
+
+  // reads after insertion remap the grown log
+  storage.insert(*makeData("/A/2", 2));
+  storage.insert(*makeData("/A/3/x", 3));
+  BOOST_CHECK_EQUAL(storage.size(), 3);
+  BOOST_CHECK_EQUAL(getContent(storage.find(Name("/A/2"))), 2);
+  BOOST_CHECK_EQUAL(getContent(storage.find(Name("/A"))), 1);
+  BOOST_CHECK_EQUAL(getContent(storage.find(data1->getFullName())), 1);
+  BOOST_CHECK(storage.find(Name("/B")) == nullptr);
+
+  shared_ptr<const Data> found = storage.find(Name("/A/1"));
+  BOOST_CHECK(found->wireEncode() == data1->wireEncode());
+
+  // same name replaces the stored packet
+  storage.insert(*makeData("/A/2", 4));
+  BOOST_CHECK_EQUAL(storage.size(), 3);
+  BOOST_CHECK_EQUAL(getContent(storage.find(Name("/A/2"))), 4);
+}
+
+BOOST_AUTO_TEST_CASE(Selectors)
+{
+  DiskStorage storage(path);
+  storage.insert(*makeData("/A/1", 1));
+  storage.insert(*makeData("/A/2/x", 2));
+  storage.insert(*makeData("/A/2/y", 3));
+  storage.insert(*makeData("/A/3", 4));
+
+  Interest interest("/A");
+  BOOST_CHECK_EQUAL(getContent(storage.find(interest)), 1);
+
+  interest.setChildSelector(1);
+  BOOST_CHECK_EQUAL(getContent(storage.find(interest)), 4);
+
+  Exclude exclude;
+  exclude.excludeOne(name::Component("3"));
+  interest.setExclude(exclude);
+  BOOST_CHECK_EQUAL(getContent(storage.find(interest)), 2);
+
+  Interest interest2("/A");
+  interest2.setMinSuffixComponents(3);
+  BOOST_CHECK_EQUAL(getContent(storage.find(interest2)), 2);
+
+  Interest interest3("/A/1");
+  interest3.setMustBeFresh(true);
+  BOOST_CHECK_EQUAL(getContent(storage.find(interest3)), 1);
+  advanceClocks(time::seconds(11));
+  BOOST_CHECK(storage.find(interest3) == nullptr);
+
+  shared_ptr<const Data> data = storage.find(Name("/A/3"));
+  BOOST_CHECK_EQUAL(getContent(storage.find(Interest(data->getFullName()))), 4);
+}
+
+BOOST_AUTO_TEST_CASE(Erase)
+{
+  DiskStorage storage(path);
+  storage.insert(*makeData("/A/1", 1));
+  storage.insert(*makeData("/A/2", 2));
+  storage.insert(*makeData("/B", 3));
+
+  storage.erase("/A/1", false);
+  BOOST_CHECK_EQUAL(storage.size(), 2);
+  storage.erase("/A");
+  BOOST_CHECK_EQUAL(storage.size(), 1);
+  BOOST_CHECK(storage.find(Name("/A")) == nullptr);
+  BOOST_CHECK_EQUAL(getContent(storage.find(Name("/B"))), 3);
+
+  uint64_t logSize = storage.getLogSize();
+  storage.compact();
+  BOOST_CHECK_LT(storage.getLogSize(), logSize);
+  BOOST_CHECK_EQUAL(storage.getLogSize(), boost::filesystem::file_size(path));
+  BOOST_CHECK_EQUAL(getContent(storage.find(Name("/B"))), 3);
+
+  storage.insert(*makeData("/C", 4));
+  BOOST_CHECK_EQUAL(getContent(storage.find(Name("/C"))), 4);
+}
+
+BOOST_AUTO_TEST_CASE(Reopen)
+{
+  {
+    DiskStorage storage(path);
+    storage.insert(*makeData("/A/1", 1));
+    storage.insert(*makeData("/A/2", 2));
+    storage.insert(*makeData("/A/1", 3));
+  }
+
+  // simulate a crash in the middle of writing a packet
+  uint64_t fileSize = boost::filesystem::file_size(path);
+  {
+    std::ofstream log(path.c_str(), std::ios::out | std::ios::binary | std::ios::app);
+    log.write("\x06\x20\x07", 3);
+  }
+
+  DiskStorage storage(path);
+  BOOST_CHECK_EQUAL(storage.size(), 2);
+  BOOST_CHECK_EQUAL(storage.getLogSize(), fileSize);
+  BOOST_CHECK_EQUAL(boost::filesystem::file_size(path), fileSize);
+  BOOST_CHECK_EQUAL(getContent(storage.find(Name("/A/1"))), 3);
+  BOOST_CHECK_EQUAL(getContent(storage.find(Name("/A/2"))), 2);
+
+  // stale time is kept in the log
+  Interest interest("/A/1");
+  interest.setMustBeFresh(true);
+  BOOST_CHECK_EQUAL(getContent(storage.find(interest)), 3);
+  advanceClocks(time::seconds(11));
+  BOOST_CHECK(storage.find(interest) == nullptr);
+
+  storage.insert(*makeData("/A/3", 4));
+  BOOST_CHECK_EQUAL(getContent(storage.find(Name("/A/3"))), 4);
+}
+
+BOOST_AUTO_TEST_CASE(ReopenErased)
+{
+  {
+    DiskStorage storage(path);
+    storage.insert(*makeData("/A/1", 1));
+    storage.insert(*makeData("/A/2", 2));
+    storage.insert(*makeData("/B/1", 3));
+    storage.insert(*makeData("/B/2", 4));
+
+    uint64_t logSize = storage.getLogSize();
+    storage.erase("/C");
+    storage.erase("/B", false);
+    BOOST_CHECK_EQUAL(storage.getLogSize(), logSize);
+
+    storage.erase("/A");
+    storage.erase("/B/1", false);
+    storage.insert(*makeData("/A/3", 5));
+  }
+
+  DiskStorage storage(path);
+  BOOST_CHECK_EQUAL(storage.size(), 2);
+  BOOST_CHECK(storage.find(Name("/A/1")) == nullptr);
+  BOOST_CHECK(storage.find(Name("/A/2")) == nullptr);
+  BOOST_CHECK(storage.find(Name("/B/1")) == nullptr);
+  BOOST_CHECK_EQUAL(getContent(storage.find(Name("/A/3"))), 5);
+  BOOST_CHECK_EQUAL(getContent(storage.find(Name("/B/2"))), 4);
+
+  storage.compact();
+  BOOST_CHECK_EQUAL(storage.size(), 2);
+  BOOST_CHECK_EQUAL(getContent(storage.find(Name("/A/3"))), 5);
+
+  Interest interest("/B/2");
+  interest.setMustBeFresh(true);
+  BOOST_CHECK_EQUAL(getContent(storage.find(interest)), 4);
+  advanceClocks(time::seconds(11));
+  BOOST_CHECK(storage.find(interest) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(ReadAppended)
+{
+  DiskStorage storage(path);
+  for (uint8_t i = 0; i < 20; ++i) {
+    storage.insert(*makeData(Name("/A").appendNumber(i), i));
+    BOOST_CHECK_EQUAL(getContent(storage.find(Name("/A").appendNumber(i))), i);
+  }
+  for (uint8_t i = 0; i < 20; ++i) {
+    BOOST_CHECK_EQUAL(getContent(storage.find(Name("/A").appendNumber(i))), i);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(CompactFailure)
+{
+  DiskStorage storage(path);
+  storage.insert(*makeData("/A", 1));
+  storage.insert(*makeData("/B", 2));
+  storage.erase("/A");
+
+  // compacted log cannot be created
+  boost::filesystem::create_directory(path + ".compact");
+  uint64_t logSize = storage.getLogSize();
+  BOOST_CHECK_THROW(storage.compact(), DiskStorage::Error);
+  boost::filesystem::remove(path + ".compact");
+
+  BOOST_CHECK_EQUAL(storage.getLogSize(), logSize);
+  BOOST_CHECK_EQUAL(getContent(storage.find(Name("/B"))), 2);
+  storage.insert(*makeData("/C", 3));
+  BOOST_CHECK_EQUAL(getContent(storage.find(Name("/C"))), 3);
+  BOOST_CHECK_EQUAL(storage.getLogSize(), boost::filesystem::file_size(path));
+}
+
+BOOST_AUTO_TEST_CASE(NotDataLog)
+{
+  {
+    std::ofstream log(path.c_str(), std::ios::out | std::ios::binary);
+    log.write("\x05\x01\x00", 3);
+  }
+
+  BOOST_CHECK_THROW(DiskStorage storage(path), DiskStorage::Error);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // UtilDiskStorage
+
+} // namespace tests
+} // namespace util
+} // namespace ndn
@@ -0,0 +1,92 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "util/in-memory-storage-clock.hpp"
+#include "security/key-chain.hpp"
+
+#include "boost-test.hpp"
+#include "../make-interest-data.hpp"
+
+namespace ndn {
+namespace util {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(UtilInMemoryStorage)
+BOOST_AUTO_TEST_SUITE(Clock)
+
+BOOST_AUTO_TEST_CASE(SecondChance)
+{
+  InMemoryStorageClock ims;
+
+  Name name1("/insert/1");
+  ims.insert(*makeData(name1));
+
+  Name name2("/insert/2");
+  ims.insert(*makeData(name2));
+
+  Name name3("/insert/3");
+  ims.insert(*makeData(name3));
+
+  shared_ptr<Interest> interest1 = makeInterest(name1);
+  shared_ptr<Interest> interest2 = makeInterest(name2);
+  shared_ptr<Interest> interest3 = makeInterest(name3);
+
+  ims.find(*interest1);
+  ims.find(*interest3);
+
+  // /insert/1 is referenced and gets a second chance, /insert/2 is evicted
+  ims.evictItem();
+  BOOST_CHECK_EQUAL(ims.size(), 2);
+  BOOST_CHECK(!static_cast<bool>(ims.find(*interest2)));
+
+  // the mark of /insert/1 has already been cleared, so it is evicted after
+  // /insert/3 gets its second chance
+  ims.evictItem();
+  BOOST_CHECK_EQUAL(ims.size(), 1);
+  BOOST_CHECK(!static_cast<bool>(ims.find(*interest1)));
+  BOOST_CHECK(static_cast<bool>(ims.find(*interest3)));
+}
+
+BOOST_AUTO_TEST_CASE(EraseReferenced)
+{
+  InMemoryStorageClock ims;
+
+  Name name1("/insert/1");
+  ims.insert(*makeData(name1));
+
+  Name name2("/insert/2");
+  ims.insert(*makeData(name2));
+
+  ims.find(*makeInterest(name1));
+  ims.erase(name1);
+  BOOST_CHECK_EQUAL(ims.size(), 1);
+
+  ims.evictItem();
+  BOOST_CHECK_EQUAL(ims.size(), 0);
+  BOOST_CHECK(!ims.evictItem());
+}
+
+BOOST_AUTO_TEST_SUITE_END() // Clock
+BOOST_AUTO_TEST_SUITE_END() // UtilInMemoryStorage
+
+} // namespace tests
+} // namespace util
+} // namespace ndn
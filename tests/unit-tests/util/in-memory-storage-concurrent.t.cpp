@@ -0,0 +1,197 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "util/in-memory-storage-concurrent.hpp"
+#include "security/key-chain.hpp"
+
+#include "boost-test.hpp"
+#include "../make-interest-data.hpp"
+
+#include <thread>
+
+namespace ndn {
+namespace util {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(UtilInMemoryStorage)
+BOOST_AUTO_TEST_SUITE(Concurrent)
+
+BOOST_AUTO_TEST_CASE(Limit)
+{
+  InMemoryStorageConcurrent ims(10, 4);
+  BOOST_CHECK_EQUAL(ims.getNShards(), 4);
+  BOOST_CHECK_EQUAL(ims.getShardLimit(), 3);
+
+  InMemoryStorageConcurrent ims2;
+  BOOST_CHECK_EQUAL(ims2.getShardLimit(), std::numeric_limits<size_t>::max());
+}
+
+BOOST_AUTO_TEST_CASE(InsertFindErase)
+{
+  InMemoryStorageConcurrent ims;
+
+  for (int i = 0; i < 100; ++i) {
+    ims.insert(*makeData(Name("/A").appendSegment(i)));
+  }
+  ims.insert(*makeData("/A/0"));
+  BOOST_CHECK_EQUAL(ims.size(), 101);
+
+  shared_ptr<const Data> found = ims.find(*makeInterest(Name("/A").appendSegment(42)));
+  BOOST_REQUIRE(static_cast<bool>(found));
+  BOOST_CHECK_EQUAL(found->getName(), Name("/A").appendSegment(42));
+
+  found = ims.find(Name("/A").appendSegment(7));
+  BOOST_REQUIRE(static_cast<bool>(found));
+  BOOST_CHECK_EQUAL(found->getName(), Name("/A").appendSegment(7));
+
+  // prefix lookups combine results from all shards
+  found = ims.find(*makeInterest("/A"));
+  BOOST_REQUIRE(static_cast<bool>(found));
+  BOOST_CHECK_EQUAL(found->getName(), "/A/0");
+
+  shared_ptr<Interest> interest = makeInterest("/A");
+  interest->setChildSelector(1);
+  found = ims.find(*interest);
+  BOOST_REQUIRE(static_cast<bool>(found));
+  BOOST_CHECK_EQUAL(found->getName(), Name("/A").appendSegment(99));
+
+  found = ims.find(Name("/A"));
+  BOOST_REQUIRE(static_cast<bool>(found));
+  BOOST_CHECK_EQUAL(found->getName(), "/A/0");
+
+  found = ims.find(*makeInterest(found->getFullName()));
+  BOOST_REQUIRE(static_cast<bool>(found));
+  BOOST_CHECK_EQUAL(found->getName(), "/A/0");
+
+  ims.erase("/A/0", false);
+  BOOST_CHECK_EQUAL(ims.size(), 101);
+  ims.erase("/A/0");
+  BOOST_CHECK_EQUAL(ims.size(), 100);
+  ims.erase("/A");
+  BOOST_CHECK_EQUAL(ims.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(FindByFullName)
+{
+  InMemoryStorageConcurrent ims;
+
+  for (int i = 0; i < 20; ++i) {
+    ims.insert(*makeData(Name("/B").appendSegment(i)));
+  }
+
+  shared_ptr<Data> data = makeData("/B/x");
+  ims.insert(*data);
+
+  shared_ptr<const Data> found = ims.find(data->getFullName());
+  BOOST_REQUIRE(static_cast<bool>(found));
+  BOOST_CHECK_EQUAL(found->getFullName(), data->getFullName());
+
+  uint8_t digest[32] = {0};
+  BOOST_CHECK(ims.find(Name("/B/x").appendImplicitSha256Digest(digest, sizeof(digest))) ==
+              nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(ReferenceOnlyReturned)
+{
+  // two shards of two packets each; packets are assigned to shards by the hash of their names
+  InMemoryStorageConcurrent ims(4, 2);
+  BOOST_REQUIRE_EQUAL(ims.getShardLimit(), 2);
+
+  // y is in one shard, x0 < x1 < x2 follow y and are all in the other shard
+  Name y;
+  std::vector<Name> x;
+  for (int i = 0; x.size() < 3; ++i) {
+    Name name = Name("/P").appendSegment(i);
+    size_t shard = std::hash<Name>()(name) % 2;
+    if (y.empty()) {
+      if (shard == 1)
+        y = name;
+    }
+    else if (shard == 0) {
+      x.push_back(name);
+    }
+  }
+
+  ims.insert(*makeData(y));
+  ims.insert(*makeData(x[0]));
+  ims.insert(*makeData(x[1]));
+
+  // x0 is the best match in its shard, but y is returned
+  shared_ptr<const Data> found = ims.find(*makeInterest("/P"));
+  BOOST_REQUIRE(static_cast<bool>(found));
+  BOOST_CHECK_EQUAL(found->getName(), y);
+
+  // x0 was not marked as referenced, so it is evicted first
+  ims.insert(*makeData(x[2]));
+  BOOST_CHECK(ims.find(x[0]) == nullptr);
+  BOOST_CHECK(ims.find(x[1]) != nullptr);
+  BOOST_CHECK(ims.find(x[2]) != nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(Evict)
+{
+  InMemoryStorageConcurrent ims(8, 2);
+
+  for (int i = 0; i < 100; ++i) {
+    ims.insert(*makeData(Name("/A").appendSegment(i)));
+  }
+  BOOST_CHECK_LE(ims.size(), 8);
+}
+
+BOOST_AUTO_TEST_CASE(Threads)
+{
+  static const int N_THREADS = 4;
+  static const int N_PACKETS = 200;
+
+  InMemoryStorageConcurrent ims;
+
+  std::vector<shared_ptr<Data>> packets;
+  for (int i = 0; i < N_THREADS * N_PACKETS; ++i) {
+    packets.push_back(makeData(Name("/T").appendSegment(i)));
+  }
+
+  std::vector<std::thread> threads;
+  std::vector<int> nFound(N_THREADS, 0);
+  for (int t = 0; t < N_THREADS; ++t) {
+    threads.push_back(std::thread([&, t] {
+      for (int i = t * N_PACKETS; i < (t + 1) * N_PACKETS; ++i) {
+        ims.insert(*packets[i]);
+        if (ims.find(*makeInterest(packets[i]->getName())) != nullptr)
+          ++nFound[t];
+      }
+    }));
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  BOOST_CHECK_EQUAL(ims.size(), N_THREADS * N_PACKETS);
+  for (int t = 0; t < N_THREADS; ++t) {
+    BOOST_CHECK_EQUAL(nFound[t], N_PACKETS);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END() // Concurrent
+BOOST_AUTO_TEST_SUITE_END() // UtilInMemoryStorage
+
+} // namespace tests
+} // namespace util
+} // namespace ndn
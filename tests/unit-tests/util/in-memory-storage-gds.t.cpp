@@ -0,0 +1,83 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "util/in-memory-storage-gds.hpp"
+#include "security/key-chain.hpp"
+
+#include "boost-test.hpp"
+#include "../make-interest-data.hpp"
+
+namespace ndn {
+namespace util {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(UtilInMemoryStorage)
+BOOST_AUTO_TEST_SUITE(Gds)
+
+static shared_ptr<Data>
+makeDataWithContentSize(const Name& name, size_t contentSize)
+{
+  shared_ptr<Data> data = make_shared<Data>(name);
+  std::vector<uint8_t> content(contentSize);
+  data->setContent(content.data(), content.size());
+  return signData(data);
+}
+
+BOOST_AUTO_TEST_CASE(LargeFirst)
+{
+  InMemoryStorageGds ims;
+
+  ims.insert(*makeDataWithContentSize("/small/1", 100));
+  ims.insert(*makeDataWithContentSize("/large", 8000));
+  ims.insert(*makeDataWithContentSize("/small/2", 100));
+
+  ims.evictItem();
+  BOOST_CHECK_EQUAL(ims.size(), 2);
+  BOOST_CHECK(ims.find(Name("/large")) == nullptr);
+  BOOST_CHECK(ims.find(Name("/small/1")) != nullptr);
+  BOOST_CHECK(ims.find(Name("/small/2")) != nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(Aging)
+{
+  InMemoryStorageGds ims;
+
+  ims.insert(*makeDataWithContentSize("/small/1", 100));
+  ims.insert(*makeDataWithContentSize("/small/2", 100));
+  ims.insert(*makeDataWithContentSize("/large", 8000));
+
+  // evicting /large raises inflation, so a packet accessed afterwards is
+  // preferred over an equally sized one that has not been accessed since
+  ims.evictItem();
+  ims.find(*makeInterest("/small/2"));
+
+  ims.evictItem();
+  BOOST_CHECK_EQUAL(ims.size(), 1);
+  BOOST_CHECK(ims.find(Name("/small/1")) == nullptr);
+  BOOST_CHECK(ims.find(Name("/small/2")) != nullptr);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // Gds
+BOOST_AUTO_TEST_SUITE_END() // UtilInMemoryStorage
+
+} // namespace tests
+} // namespace util
+} // namespace ndn
@@ -90,6 +90,52 @@ BOOST_AUTO_TEST_CASE(Post)
   BOOST_CHECK_EQUAL(decoded2.getMessage(), "msg2");
 }
 
+BOOST_AUTO_TEST_CASE(Batching)
+{
+  shared_ptr<DummyClientFace> face = makeDummyClientFace(io);
+  ndn::KeyChain keyChain;
+  util::NotificationStream<SimpleNotification> notificationStream(*face,
+    "/localhost/nfd/NotificationStreamTest", keyChain);
+
+  // each encoded notification is 8 octets
+  notificationStream.setBatching(20, time::milliseconds(100));
+
+  // published when the delay budget is used up
+  notificationStream.postNotification(SimpleNotification("msg1"));
+  notificationStream.postNotification(SimpleNotification("msg2"));
+  advanceClocks(time::milliseconds(10), 9);
+  BOOST_CHECK_EQUAL(face->sentDatas.size(), 0);
+  advanceClocks(time::milliseconds(10));
+  BOOST_REQUIRE_EQUAL(face->sentDatas.size(), 1);
+  BOOST_CHECK_EQUAL(face->sentDatas[0].getName(),
+                    "/localhost/nfd/NotificationStreamTest/%FE%00");
+
+  const Block& content = face->sentDatas[0].getContent();
+  content.parse();
+  BOOST_REQUIRE_EQUAL(content.elements().size(), 2);
+  BOOST_CHECK_EQUAL(SimpleNotification(content.elements()[0]).getMessage(), "msg1");
+  BOOST_CHECK_EQUAL(SimpleNotification(content.elements()[1]).getMessage(), "msg2");
+
+  // published when the size budget would be exceeded
+  notificationStream.postNotification(SimpleNotification("msg3"));
+  notificationStream.postNotification(SimpleNotification("msg4"));
+  notificationStream.postNotification(SimpleNotification("msg5"));
+  advanceClocks(time::milliseconds(1));
+  BOOST_REQUIRE_EQUAL(face->sentDatas.size(), 2);
+  face->sentDatas[1].getContent().parse();
+  BOOST_CHECK_EQUAL(face->sentDatas[1].getContent().elements().size(), 2);
+
+  notificationStream.flush();
+  advanceClocks(time::milliseconds(1));
+  BOOST_REQUIRE_EQUAL(face->sentDatas.size(), 3);
+  BOOST_CHECK_EQUAL(face->sentDatas[2].getName(),
+                    "/localhost/nfd/NotificationStreamTest/%FE%02");
+
+  // flush timer was cancelled
+  advanceClocks(time::milliseconds(100));
+  BOOST_CHECK_EQUAL(face->sentDatas.size(), 3);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace tests
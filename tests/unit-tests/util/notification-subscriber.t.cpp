@@ -214,6 +214,81 @@ BOOST_FIXTURE_TEST_CASE(EndToEnd, EndToEndFixture)
   BOOST_CHECK_EQUAL(subscriberFace->sentInterests.size(), 0);
 }
 
+BOOST_FIXTURE_TEST_CASE(Pipeline, EndToEndFixture)
+{
+  BOOST_CHECK_THROW(subscriber.setPipelineSize(0), std::invalid_argument);
+  subscriber.setPipelineSize(3);
+
+  std::vector<std::string> messages;
+  notificationConn = subscriber.onNotification.connect(
+    [&messages] (const SimpleNotification& notification) {
+      messages.push_back(notification.getMessage());
+    });
+
+  subscriber.start();
+  advanceClocks(time::milliseconds(1));
+  BOOST_CHECK(this->hasInitialRequest());
+
+  // respond to initial request, then three continuation requests are outstanding
+  subscriberFace->sentInterests.clear();
+  this->deliverNotification("n1");
+  advanceClocks(time::milliseconds(1));
+  BOOST_REQUIRE_EQUAL(subscriberFace->sentInterests.size(), 3);
+  for (size_t i = 0; i < 3; ++i) {
+    BOOST_CHECK_EQUAL(subscriberFace->sentInterests[i].getName().at(-1).toSequenceNumber(),
+                      lastDeliveredSeqNo + 1 + i);
+  }
+
+  // publish three notifications and deliver them in reverse order
+  publisherFace->sentDatas.clear();
+  notificationStream.postNotification(SimpleNotification("n2"));
+  notificationStream.postNotification(SimpleNotification("n3"));
+  notificationStream.postNotification(SimpleNotification("n4"));
+  advanceClocks(time::milliseconds(1));
+  BOOST_REQUIRE_EQUAL(publisherFace->sentDatas.size(), 3);
+
+  subscriberFace->sentInterests.clear();
+  subscriberFace->receive(publisherFace->sentDatas[2]);
+  advanceClocks(time::milliseconds(1));
+  subscriberFace->receive(publisherFace->sentDatas[1]);
+  advanceClocks(time::milliseconds(1));
+  BOOST_CHECK_EQUAL(messages.size(), 1);
+  BOOST_CHECK_EQUAL(subscriberFace->sentInterests.size(), 0);
+
+  subscriberFace->receive(publisherFace->sentDatas[0]);
+  advanceClocks(time::milliseconds(1));
+  std::vector<std::string> expected{"n1", "n2", "n3", "n4"};
+  BOOST_CHECK_EQUAL_COLLECTIONS(messages.begin(), messages.end(),
+                                expected.begin(), expected.end());
+  BOOST_CHECK_EQUAL(subscriberFace->sentInterests.size(), 3); // pipeline is refilled
+}
+
+BOOST_FIXTURE_TEST_CASE(Batch, EndToEndFixture)
+{
+  std::vector<std::string> messages;
+  notificationConn = subscriber.onNotification.connect(
+    [&messages] (const SimpleNotification& notification) {
+      messages.push_back(notification.getMessage());
+    });
+  subscriber.start();
+  advanceClocks(time::milliseconds(1));
+
+  notificationStream.setBatching(1000, time::milliseconds(10));
+  notificationStream.postNotification(SimpleNotification("n1"));
+  notificationStream.postNotification(SimpleNotification("n2"));
+  notificationStream.postNotification(SimpleNotification("n3"));
+  advanceClocks(time::milliseconds(10));
+  BOOST_REQUIRE_EQUAL(publisherFace->sentDatas.size(), 1);
+
+  subscriberFace->sentInterests.clear();
+  subscriberFace->receive(publisherFace->sentDatas[0]);
+  advanceClocks(time::milliseconds(1));
+  std::vector<std::string> expected{"n1", "n2", "n3"};
+  BOOST_CHECK_EQUAL_COLLECTIONS(messages.begin(), messages.end(),
+                                expected.begin(), expected.end());
+  BOOST_CHECK_EQUAL(this->getRequestSeqNo(), 1);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace tests
@@ -268,6 +268,151 @@ BOOST_AUTO_TEST_CASE(ScopedEventIdMove)
 
 BOOST_AUTO_TEST_SUITE_END() // ScopedEventId
 
+class TimerWheelFixture : public UnitTestTimeFixture
+{
+public:
+  TimerWheelFixture()
+    : scheduler(io, Scheduler::BACKEND_TIMER_WHEEL)
+  {
+  }
+
+public:
+  Scheduler scheduler;
+};
+
+BOOST_FIXTURE_TEST_SUITE(TimerWheel, TimerWheelFixture)
+
+BOOST_AUTO_TEST_CASE(Events)
+{
+  size_t count1 = 0;
+  size_t count2 = 0;
+
+  scheduler.scheduleEvent(time::milliseconds(500), [&] {
+      ++count1;
+      BOOST_CHECK_EQUAL(count2, 1);
+    });
+
+  EventId i = scheduler.scheduleEvent(time::seconds(1), [&] {
+      BOOST_ERROR("This event should not have been fired");
+    });
+  scheduler.cancelEvent(i);
+
+  scheduler.scheduleEvent(time::milliseconds(250), [&] {
+      BOOST_CHECK_EQUAL(count1, 0);
+      ++count2;
+    });
+
+  i = scheduler.scheduleEvent(time::milliseconds(50), [&] {
+      BOOST_ERROR("This event should not have been fired");
+    });
+  scheduler.cancelEvent(i);
+
+  advanceClocks(time::milliseconds(1), 1000);
+  BOOST_CHECK_EQUAL(count1, 1);
+  BOOST_CHECK_EQUAL(count2, 1);
+}
+
+BOOST_AUTO_TEST_CASE(Order)
+{
+  std::vector<int> order;
+  scheduler.scheduleEvent(time::microseconds(3000), [&] { order.push_back(4); });
+  scheduler.scheduleEvent(time::microseconds(1800), [&] { order.push_back(3); });
+  scheduler.scheduleEvent(time::microseconds(1200), [&] { order.push_back(1); });
+  scheduler.scheduleEvent(time::microseconds(1500), [&] { order.push_back(2); });
+  scheduler.scheduleEvent(time::microseconds(3000), [&] { order.push_back(5); });
+
+  advanceClocks(time::milliseconds(1), 5);
+  std::vector<int> expected{1, 2, 3, 4, 5};
+  BOOST_CHECK_EQUAL_COLLECTIONS(order.begin(), order.end(), expected.begin(), expected.end());
+}
+
+BOOST_AUTO_TEST_CASE(RoundUp)
+{
+  Scheduler scheduler(io, Scheduler::BACKEND_TIMER_WHEEL, time::milliseconds(10));
+
+  int hit = 0;
+  scheduler.scheduleEvent(time::milliseconds(15), [&] { ++hit; });
+
+  advanceClocks(time::milliseconds(1), 19);
+  BOOST_CHECK_EQUAL(hit, 0);
+  advanceClocks(time::milliseconds(1));
+  BOOST_CHECK_EQUAL(hit, 1);
+}
+
+BOOST_AUTO_TEST_CASE(LongDelays)
+{
+  // each delay lands on a different level of the wheel; the last exceeds the wheel range
+  std::vector<time::nanoseconds> delays{time::milliseconds(300), time::seconds(70),
+                                        time::hours(5), time::days(60)};
+  std::vector<int> hits(delays.size(), 0);
+  for (size_t i = 0; i < delays.size(); ++i) {
+    scheduler.scheduleEvent(delays[i], [&hits, i] { ++hits[i]; });
+  }
+  EventId cancelled = scheduler.scheduleEvent(time::seconds(71), [] {
+      BOOST_ERROR("This event should not have been fired");
+    });
+
+  time::nanoseconds elapsed = time::nanoseconds::zero();
+  for (size_t i = 0; i < delays.size(); ++i) {
+    advanceClocks(delays[i] - elapsed - time::milliseconds(1));
+    BOOST_CHECK_EQUAL(hits[i], 0);
+    advanceClocks(time::milliseconds(1));
+    BOOST_CHECK_EQUAL(hits[i], 1);
+    elapsed = delays[i];
+
+    if (i == 1)
+      scheduler.cancelEvent(cancelled);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(StaleEventId)
+{
+  EventId fired = scheduler.scheduleEvent(time::milliseconds(10), [] {});
+  advanceClocks(time::milliseconds(10));
+
+  // the record of the fired event is reused for this one
+  int hit = 0;
+  scheduler.scheduleEvent(time::milliseconds(10), [&] { ++hit; });
+  scheduler.cancelEvent(fired);
+
+  advanceClocks(time::milliseconds(10));
+  BOOST_CHECK_EQUAL(hit, 1);
+}
+
+BOOST_AUTO_TEST_CASE(Reschedule)
+{
+  int count = 0;
+  function<void()> event = [&] {
+    if (++count < 5) {
+      scheduler.scheduleEvent(time::seconds(0), event);
+    }
+  };
+  scheduler.scheduleEvent(time::milliseconds(10), event);
+
+  advanceClocks(time::milliseconds(10));
+  BOOST_CHECK_EQUAL(count, 5);
+}
+
+BOOST_AUTO_TEST_CASE(CancelAll)
+{
+  int count = 0;
+  scheduler.scheduleEvent(time::milliseconds(500), [&] { scheduler.cancelAllEvents(); });
+  scheduler.scheduleEvent(time::milliseconds(400), [&] { ++count; });
+  EventId i = scheduler.scheduleEvent(time::seconds(3), [] {
+      BOOST_ERROR("This event should have been cancelled");
+    });
+
+  advanceClocks(time::milliseconds(100), 10);
+  BOOST_CHECK_EQUAL(count, 1);
+  scheduler.cancelEvent(i);
+
+  scheduler.scheduleEvent(time::milliseconds(100), [&] { ++count; });
+  advanceClocks(time::milliseconds(100), 40);
+  BOOST_CHECK_EQUAL(count, 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TimerWheel
+
 BOOST_AUTO_TEST_SUITE_END() // UtilTestScheduler
 
 } // namespace tests
@@ -309,6 +309,45 @@ BOOST_AUTO_TEST_CASE(AutoDisconnectMove)
   BOOST_CHECK_EQUAL(hit, 2); // handler called
 }
 
+BOOST_AUTO_TEST_CASE(ReuseSlot)
+{
+  SignalOwner0 so;
+
+  std::vector<int> order;
+  Connection c1 = so.sig.connect([&order] { order.push_back(1); });
+  so.sig.connect([&order] { order.push_back(2); });
+  c1.disconnect();
+
+  // the slot of c1 is reused, but the new handler is executed last
+  Connection c3 = so.sig.connect([&order] { order.push_back(3); });
+  BOOST_CHECK_EQUAL(c1.isConnected(), false);
+  BOOST_CHECK_EQUAL(c3.isConnected(), true);
+  BOOST_CHECK(c1 != c3);
+
+  c1.disconnect(); // has no effect on c3
+  BOOST_CHECK_EQUAL(c3.isConnected(), true);
+
+  so.emitSignal(sig);
+  std::vector<int> expected{2, 3};
+  BOOST_CHECK_EQUAL_COLLECTIONS(order.begin(), order.end(), expected.begin(), expected.end());
+}
+
+BOOST_AUTO_TEST_CASE(LargeHandler)
+{
+  SignalOwner0 so;
+
+  shared_ptr<int> hit = make_shared<int>(0);
+  char padding[256] = {};
+  Connection connection = so.sig.connect([hit, padding] { *hit += 1 + padding[0]; });
+  BOOST_CHECK_EQUAL(hit.use_count(), 2);
+
+  so.emitSignal(sig);
+  BOOST_CHECK_EQUAL(*hit, 1);
+
+  connection.disconnect();
+  BOOST_CHECK_EQUAL(hit.use_count(), 1); // handler destructed
+}
+
 BOOST_AUTO_TEST_CASE(ConnectSingleShot)
 {
   SignalOwner0 so;
@@ -23,10 +23,13 @@
 #include "util/in-memory-storage-fifo.hpp"
 #include "util/in-memory-storage-lfu.hpp"
 #include "util/in-memory-storage-lru.hpp"
+#include "util/in-memory-storage-clock.hpp"
+#include "util/in-memory-storage-gds.hpp"
 #include "security/key-chain.hpp"
 
 #include "boost-test.hpp"
 #include "../make-interest-data.hpp"
+#include "../unit-test-time-fixture.hpp"
 
 #include <boost/mpl/list.hpp>
 
@@ -38,7 +41,8 @@ BOOST_AUTO_TEST_SUITE(UtilInMemoryStorage)
 BOOST_AUTO_TEST_SUITE(Common)
 
 typedef boost::mpl::list<InMemoryStoragePersistent, InMemoryStorageFifo, InMemoryStorageLfu,
-                         InMemoryStorageLru> InMemoryStorages;
+                         InMemoryStorageLru, InMemoryStorageClock,
+                         InMemoryStorageGds> InMemoryStorages;
 
 BOOST_AUTO_TEST_CASE_TEMPLATE(Insertion, T, InMemoryStorages)
 {
@@ -128,6 +132,32 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(InsertAndFind, T, InMemoryStorages)
   BOOST_CHECK_EQUAL(data->getName(), found->getName());
 }
 
+BOOST_AUTO_TEST_CASE_TEMPLATE(InsertLazy, T, InMemoryStorages)
+{
+  const uint8_t WIRE[] = {
+    0x06, 0x0f, // Data
+          0x07, 0x03, // Name
+                0x08, 0x01, 0x41,
+          0x14, 0x01, // MetaInfo
+                0x19, // malformed FreshnessPeriod
+          0x15, 0x00, // Content
+          0x16, 0x03, // SignatureInfo
+                0x1b, 0x01, 0x00 // SignatureType
+  };
+
+  T ims;
+
+  // the malformed MetaInfo is not decoded, as neither insert nor this lookup need it
+  shared_ptr<Data> data = make_shared<Data>();
+  data->wireDecodeLazy(Block(WIRE, sizeof(WIRE)));
+  BOOST_REQUIRE_NO_THROW(ims.insert(*data));
+
+  shared_ptr<Interest> interest = makeInterest("/A");
+  shared_ptr<const Data> found = ims.find(*interest);
+  BOOST_REQUIRE(static_cast<bool>(found));
+  BOOST_CHECK_EQUAL(found->getName(), "/A");
+}
+
 BOOST_AUTO_TEST_CASE_TEMPLATE(InsertAndNotFind, T, InMemoryStorages)
 {
   T ims;
@@ -159,6 +189,37 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(InsertAndFindByName, T, InMemoryStorages)
   BOOST_CHECK_EQUAL(data->getName(), found->getName());
 }
 
+BOOST_AUTO_TEST_CASE_TEMPLATE(InsertAndFindByNameLeftmost, T, InMemoryStorages)
+{
+  T ims;
+
+  Name name("/insert/and/find");
+
+  uint32_t content1 = 1;
+  shared_ptr<Data> data1 = makeData(name);
+  data1->setContent(reinterpret_cast<const uint8_t*>(&content1), sizeof(content1));
+  signData(data1);
+  ims.insert(*data1);
+
+  uint32_t content2 = 2;
+  shared_ptr<Data> data2 = makeData(name);
+  data2->setContent(reinterpret_cast<const uint8_t*>(&content2), sizeof(content2));
+  signData(data2);
+  ims.insert(*data2);
+
+  ims.insert(*makeData("/insert/and/find/child"));
+
+  const Name& leftmost = std::min(data1->getFullName(), data2->getFullName());
+
+  shared_ptr<const Data> found = ims.find(name);
+  BOOST_REQUIRE(static_cast<bool>(found));
+  BOOST_CHECK_EQUAL(found->getFullName(), leftmost);
+
+  found = ims.find(Name("/insert/and"));
+  BOOST_REQUIRE(static_cast<bool>(found));
+  BOOST_CHECK_EQUAL(found->getFullName(), leftmost);
+}
+
 BOOST_AUTO_TEST_CASE_TEMPLATE(InsertAndFindByFullName, T, InMemoryStorages)
 {
   T ims;
@@ -629,8 +690,8 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(ExcludeSelector, T, InMemoryStorages)
   BOOST_CHECK_EQUAL(found3->getName(), "/c/a");
 }
 
-typedef boost::mpl::list<InMemoryStorageFifo, InMemoryStorageLfu, InMemoryStorageLru>
-                         InMemoryStoragesLimited;
+typedef boost::mpl::list<InMemoryStorageFifo, InMemoryStorageLfu, InMemoryStorageLru,
+                         InMemoryStorageClock, InMemoryStorageGds> InMemoryStoragesLimited;
 
 BOOST_AUTO_TEST_CASE_TEMPLATE(setCapacity, T, InMemoryStoragesLimited)
 {
@@ -699,16 +760,95 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(InsertAndEvict, T, InMemoryStoragesLimited)
   BOOST_CHECK(!static_cast<bool>(found));
 }
 
+static shared_ptr<Data>
+makeDataWithContentSize(const Name& name, size_t contentSize)
+{
+  shared_ptr<Data> data = make_shared<Data>(name);
+  std::vector<uint8_t> content(contentSize);
+  data->setContent(content.data(), content.size());
+  return signData(data);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(MemoryUsage, T, InMemoryStorages)
+{
+  T ims;
+  BOOST_CHECK_EQUAL(ims.getMemoryUsage(), 0);
+  BOOST_CHECK_EQUAL(ims.getMemoryLimit(), std::numeric_limits<size_t>::max());
+
+  shared_ptr<Data> data1 = makeDataWithContentSize("/small", 100);
+  shared_ptr<Data> data2 = makeDataWithContentSize("/large", 8000);
+  ims.insert(*data1);
+  ims.insert(*data2);
+  ims.insert(*data2);
+  BOOST_CHECK_EQUAL(ims.getMemoryUsage(), InMemoryStorageEntry::estimateMemoryUsage(*data1) +
+                                          InMemoryStorageEntry::estimateMemoryUsage(*data2));
+
+  ims.erase("/large");
+  BOOST_CHECK_EQUAL(ims.getMemoryUsage(), InMemoryStorageEntry::estimateMemoryUsage(*data1));
+
+  ims.erase("/");
+  BOOST_CHECK_EQUAL(ims.getMemoryUsage(), 0);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(MemoryLimit, T, InMemoryStoragesLimited)
+{
+  T ims(std::numeric_limits<size_t>::max());
+
+  size_t smallUsage = InMemoryStorageEntry::estimateMemoryUsage(
+                        *makeDataWithContentSize(Name("/small").appendSegment(0), 100));
+  size_t largeUsage = InMemoryStorageEntry::estimateMemoryUsage(
+                        *makeDataWithContentSize(Name("/large").appendSegment(0), 8000));
+  ims.setMemoryLimit(4 * largeUsage);
+
+  for (int i = 0; i < 10; ++i) {
+    ims.insert(*makeDataWithContentSize(Name("/large").appendSegment(i), 8000));
+    BOOST_CHECK_LE(ims.getMemoryUsage(), ims.getMemoryLimit());
+  }
+  BOOST_CHECK_EQUAL(ims.size(), 4);
+
+  for (int i = 0; i < 100; ++i) {
+    ims.insert(*makeDataWithContentSize(Name("/small").appendSegment(i), 100));
+    BOOST_CHECK_LE(ims.getMemoryUsage(), ims.getMemoryLimit());
+  }
+  BOOST_CHECK_GE(ims.size(), 4 * largeUsage / smallUsage - largeUsage / smallUsage);
+
+  // packet larger than the whole limit is never stored, and evicts nothing
+  size_t nPackets = ims.size();
+  ims.insert(*makeDataWithContentSize("/huge", 5 * 8000));
+  BOOST_CHECK(ims.find(Name("/huge")) == nullptr);
+  BOOST_CHECK_EQUAL(ims.size(), nPackets);
+
+  ims.setMemoryLimit(largeUsage);
+  BOOST_CHECK_LE(ims.getMemoryUsage(), largeUsage);
+}
+
+BOOST_AUTO_TEST_CASE(MemoryLimitPersistent)
+{
+  InMemoryStoragePersistent ims;
+  shared_ptr<Data> data = makeDataWithContentSize("/A", 1000);
+  ims.insert(*data);
+
+  size_t usage = InMemoryStorageEntry::estimateMemoryUsage(*data);
+  BOOST_CHECK_THROW(ims.setMemoryLimit(usage - 1), InMemoryStorage::Error);
+  BOOST_CHECK_EQUAL(ims.getMemoryLimit(), std::numeric_limits<size_t>::max());
+  BOOST_CHECK_EQUAL(ims.size(), 1);
+
+  ims.setMemoryLimit(usage + 100);
+  ims.insert(*makeDataWithContentSize("/B", 1000));
+  BOOST_CHECK_EQUAL(ims.size(), 1);
+}
+
 ///as Find function is implemented at the base case, therefore testing for one derived class is
 ///sufficient for all
-class FindFixture
+class FindFixture : public tests::UnitTestTimeFixture
 {
 protected:
   Name
-  insert(uint32_t id, const Name& name)
+  insert(uint32_t id, const Name& name,
+         const time::milliseconds& freshnessPeriod = time::milliseconds(99999))
   {
     shared_ptr<Data> data = makeData(name);
-    data->setFreshnessPeriod(time::milliseconds(99999));
+    data->setFreshnessPeriod(freshnessPeriod);
     data->setContent(reinterpret_cast<const uint8_t*>(&id), sizeof(id));
     signData(data);
 
@@ -976,6 +1116,65 @@ BOOST_AUTO_TEST_CASE(DigestExclude)
   BOOST_CHECK_EQUAL(find(), 1);
 }
 
+BOOST_AUTO_TEST_CASE(MustBeFresh)
+{
+  insert(1, "ndn:/A/1", time::milliseconds(500));
+  insert(2, "ndn:/A/2");
+  insert(3, "ndn:/A/3", time::milliseconds(-1));
+
+  startInterest("ndn:/A")
+    .setMustBeFresh(true);
+  BOOST_CHECK_EQUAL(find(), 1);
+
+  advanceClocks(time::milliseconds(1000));
+
+  startInterest("ndn:/A")
+    .setMustBeFresh(true);
+  BOOST_CHECK_EQUAL(find(), 2);
+
+  startInterest("ndn:/A");
+  BOOST_CHECK_EQUAL(find(), 1);
+
+  startInterest("ndn:/A/1")
+    .setMustBeFresh(true);
+  BOOST_CHECK_EQUAL(find(), 0);
+
+  advanceClocks(time::milliseconds(100000));
+
+  startInterest("ndn:/A")
+    .setMustBeFresh(true)
+    .setChildSelector(0);
+  BOOST_CHECK_EQUAL(find(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(ExcludeChildren)
+{
+  insert(1, "ndn:/A/a/1");
+  insert(2, "ndn:/A/a/2");
+  insert(3, "ndn:/A/b/1");
+  insert(4, "ndn:/A/b/2");
+  insert(5, "ndn:/A/c/1");
+
+  Exclude excludeA;
+  excludeA.excludeOne(name::Component("a"));
+  startInterest("ndn:/A")
+    .setChildSelector(0)
+    .setExclude(excludeA);
+  BOOST_CHECK_EQUAL(find(), 3);
+
+  Exclude excludeBC;
+  excludeBC.excludeRange(name::Component("b"), name::Component("c"));
+  startInterest("ndn:/A")
+    .setChildSelector(1)
+    .setExclude(excludeBC);
+  BOOST_CHECK_EQUAL(find(), 1);
+
+  startInterest("ndn:/A")
+    .setChildSelector(1)
+    .setMinSuffixComponents(4);
+  BOOST_CHECK_EQUAL(find(), 0);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // Find
 BOOST_AUTO_TEST_SUITE_END() // Common
 BOOST_AUTO_TEST_SUITE_END() // UtilInMemoryStorage
@@ -23,6 +23,7 @@
 
 #include "face.hpp"
 #include "security/key-chain.hpp"
+#include "util/disk-storage.hpp"
 
 namespace ndn {
 
@@ -31,10 +32,24 @@ const size_t MAX_SEG_SIZE = 4096;
 class Producer
 {
 public:
-  Producer(const char* name)
+  Producer(const char* name, const char* storePath)
     : m_name(name)
     , m_isVerbose(false)
   {
+    if (storePath != 0)
+      {
+        m_diskStore.reset(new util::DiskStorage(storePath));
+
+        // segments stored by a previous run are served as they are, instead of being
+        // appended again together with whatever is read from stdin
+        if (static_cast<bool>(m_diskStore->find(m_name)))
+          {
+            std::cerr << "Serving the chunks stored for prefix [" << m_name << "] in "
+                      << storePath << ", input is ignored" << std::endl;
+            return;
+          }
+      }
+
     int segnum = 0;
     char* buf = new char[MAX_SEG_SIZE];
     do
@@ -51,7 +66,10 @@ public:
             data->setContent(reinterpret_cast<const uint8_t*>(buf), got);
 
             m_keychain.sign(*data);
-            m_store.push_back(data);
+            if (static_cast<bool>(m_diskStore))
+              m_diskStore->insert(*data);
+            else
+              m_store.push_back(data);
             segnum++;
           }
       }
@@ -67,6 +85,18 @@ public:
     if (m_isVerbose)
       std::cerr << "<< I: " << interest << std::endl;
 
+    if (static_cast<bool>(m_diskStore))
+      {
+        // this producer is the origin of the stored segments, so they are served even
+        // when the store considers them stale
+        Interest lookup(interest);
+        lookup.setMustBeFresh(false);
+        shared_ptr<const Data> data = m_diskStore->find(lookup);
+        if (static_cast<bool>(data))
+          m_face.put(*data);
+        return;
+      }
+
     size_t segnum = static_cast<size_t>(interest.getName().rbegin()->toSegment());
 
     if (segnum < m_store.size())
@@ -87,7 +117,7 @@ public:
   void
   run()
   {
-    if (m_store.empty())
+    if (m_store.empty() && !(static_cast<bool>(m_diskStore) && m_diskStore->size() > 0))
       {
         std::cerr << "Nothing to serve. Exiting." << std::endl;
         return;
@@ -106,6 +136,7 @@ private:
   KeyChain m_keychain;
 
   std::vector< shared_ptr<Data> > m_store;
+  unique_ptr<util::DiskStorage> m_diskStore;
 
   bool m_isVerbose;
 };
@@ -115,7 +146,10 @@ main(int argc, char** argv)
 {
   if (argc < 2)
     {
-      std::cerr << "Usage: ./ndnputchunks [data_prefix]\n";
+      std::cerr << "Usage: ./ndnputchunks [data_prefix] [store_file]\n"
+                << "  store_file: keep segments in this file instead of memory; if it already\n"
+                << "              holds segments of data_prefix, they are served and the input\n"
+                << "              is not read\n";
       return -1;
     }
 
@@ -124,7 +158,7 @@ main(int argc, char** argv)
       time::steady_clock::TimePoint startTime = time::steady_clock::now();
 
       std::cerr << "Preparing the input..." << std::endl;
-      Producer producer(argv[1]);
+      Producer producer(argv[1], argc > 2 ? argv[2] : 0);
       std::cerr << "Ready... (took " << (time::steady_clock::now() - startTime) << std::endl;
 
       while (true)
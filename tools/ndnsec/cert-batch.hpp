@@ -0,0 +1,230 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_TOOLS_NDNSEC_CERT_BATCH_HPP
+#define NDN_TOOLS_NDNSEC_CERT_BATCH_HPP
+
+#include "util.hpp"
+
+/**
+ * @brief Decode a base64-encoded signing request
+ *
+ * @return the request, or a null pointer if @p base64 is not a valid certificate
+ */
+ndn::shared_ptr<ndn::IdentityCertificate>
+decodeSigningRequest(const std::string& base64)
+{
+  try
+    {
+      using namespace CryptoPP;
+      ndn::OBufferStream os;
+      StringSource ss(base64, true, new Base64Decoder(new FileSink(os)));
+
+      ndn::shared_ptr<ndn::IdentityCertificate> request =
+        ndn::make_shared<ndn::IdentityCertificate>();
+      request->wireDecode(ndn::Block(os.buf()));
+      return request;
+    }
+  catch (const std::exception&)
+    {
+      return ndn::shared_ptr<ndn::IdentityCertificate>();
+    }
+}
+
+int
+ndnsec_cert_batch(int argc, char** argv)
+{
+  using namespace ndn;
+  using namespace ndn::time;
+  namespace po = boost::program_options;
+
+  KeyChain keyChain;
+
+  std::string notBeforeStr;
+  std::string notAfterStr;
+  std::string requestFile("-");
+  Name signId;
+  Name certPrefix = KeyChain::DEFAULT_PREFIX; // to avoid displaying the default value
+  size_t nThreads = 0;
+  size_t batchSize = 1000;
+
+  po::options_description description(
+    "General Usage\n"
+    "  ndnsec cert-batch [-h] [-S date] [-E date] [-s sign-id] [-p cert-prefix] "
+        "[-j threads] [-b batch-size] [-i] requests\n"
+    "General options");
+
+  description.add_options()
+    ("help,h", "produce help message")
+    ("not-before,S",   po::value<std::string>(&notBeforeStr),
+                       "certificate starting date, YYYYMMDDhhmmss (default: now)")
+    ("not-after,E",    po::value<std::string>(&notAfterStr),
+                       "certificate ending date, YYYYMMDDhhmmss (default: now + 365 days)")
+    ("sign-id,s",      po::value<Name>(&signId)->default_value(keyChain.getDefaultIdentity()),
+                       "signing identity")
+    ("cert-prefix,p",  po::value<Name>(&certPrefix),
+                       "cert prefix, which is the part of certificate name before "
+                       "KEY component")
+    ("threads,j",      po::value<size_t>(&nThreads)->default_value(0),
+                       "number of signing threads, 0 for one per CPU core")
+    ("batch-size,b",   po::value<size_t>(&batchSize)->default_value(1000),
+                       "number of requests signed and installed together")
+    ("install,i",      "also install the issued certificates into PublicInfo")
+    ("requests,r",     po::value<std::string>(&requestFile)->default_value("-"),
+                       "requests file name, one base64-encoded request per line, - for stdin")
+    ;
+
+  po::positional_options_description p;
+  p.add("requests", 1);
+
+  po::variables_map vm;
+  try
+    {
+      po::store(po::command_line_parser(argc, argv).options(description).positional(p).run(),
+                vm);
+      po::notify(vm);
+    }
+  catch (const std::exception& e)
+    {
+      std::cerr << "ERROR: " << e.what() << std::endl;
+      return 1;
+    }
+
+  if (vm.count("help") != 0)
+    {
+      std::cout << description << std::endl;
+      return 0;
+    }
+
+  if (batchSize == 0)
+    {
+      std::cerr << "ERROR: batch size must be positive" << std::endl;
+      return 1;
+    }
+
+  system_clock::TimePoint notBefore;
+  system_clock::TimePoint notAfter;
+
+  if (vm.count("not-before") == 0)
+    {
+      notBefore = system_clock::now();
+    }
+  else
+    {
+      notBefore = fromIsoString(notBeforeStr.substr(0, 8) + "T" +
+                                notBeforeStr.substr(8, 6));
+    }
+
+  if (vm.count("not-after") == 0)
+    {
+      notAfter = notBefore + days(365);
+    }
+  else
+    {
+      notAfter = fromIsoString(notAfterStr.substr(0, 8) + "T" +
+                               notAfterStr.substr(8, 6));
+
+      if (notAfter < notBefore)
+        {
+          std::cerr << "ERROR: not-before cannot be later than not-after" << std::endl
+                    << std::endl
+                    << description << std::endl;
+          return 1;
+        }
+    }
+
+  std::ifstream requestFileStream;
+  if (requestFile != "-")
+    {
+      requestFileStream.open(requestFile.c_str());
+      if (!requestFileStream.is_open())
+        {
+          std::cerr << "ERROR: cannot open " << requestFile << std::endl;
+          return 1;
+        }
+    }
+  std::istream& input = requestFile == "-" ? std::cin : requestFileStream;
+
+  keyChain.createIdentity(signId);
+
+  bool hasFailure = false;
+  size_t lineNo = 0;
+  std::string line;
+  std::vector<shared_ptr<IdentityCertificate>> requests;
+  std::vector<size_t> requestLineNos;
+
+  while (input)
+    {
+      requests.clear();
+      requestLineNos.clear();
+
+      while (requests.size() < batchSize && std::getline(input, line))
+        {
+          ++lineNo;
+          if (line.find_first_not_of(" \t\r") == std::string::npos)
+            continue;
+
+          shared_ptr<IdentityCertificate> request = decodeSigningRequest(line);
+          if (!static_cast<bool>(request))
+            {
+              std::cerr << "ERROR: line " << lineNo << ": input error" << std::endl;
+              hasFailure = true;
+              continue;
+            }
+          requests.push_back(request);
+          requestLineNos.push_back(lineNo);
+        }
+
+      std::vector<shared_ptr<IdentityCertificate>> certificates =
+        keyChain.issueCertificates(requests, signId, notBefore, notAfter,
+                                   std::vector<CertificateSubjectDescription>(),
+                                   certPrefix, nThreads);
+
+      std::vector<shared_ptr<IdentityCertificate>> issued;
+      for (size_t i = 0; i < certificates.size(); ++i)
+        {
+          if (!static_cast<bool>(certificates[i]))
+            {
+              std::cerr << "ERROR: line " << requestLineNos[i] << ": key name is not formated "
+                        << "correctly or does not match certificate name" << std::endl;
+              hasFailure = true;
+              continue;
+            }
+          issued.push_back(certificates[i]);
+        }
+
+      if (vm.count("install") != 0)
+        keyChain.addCertificates(issued);
+
+      for (const auto& certificate : issued)
+        {
+          const Block& wire = certificate->wireEncode();
+          using namespace CryptoPP;
+          StringSource ss(wire.wire(), wire.size(), true,
+                          new Base64Encoder(new FileSink(std::cout), false));
+          std::cout << std::endl;
+        }
+    }
+
+  return hasFailure ? 1 : 0;
+}
+
+#endif // NDN_TOOLS_NDNSEC_CERT_BATCH_HPP
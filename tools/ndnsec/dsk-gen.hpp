@@ -43,7 +43,7 @@ ndnsec_dsk_gen(int argc, char** argv)
     ("identity,i", po::value<std::string>(&identityName),
      "identity name, for example, /ndn/ucla.edu/alice")
     ("type,t", po::value<char>(&keyType)->default_value('r'),
-     "optional, key type, r for RSA key (default), e for ECDSA key.")
+     "optional, key type, r for RSA key (default), e for ECDSA key, d for Ed25519 key.")
     // ("size,s", po::value<int>(&keySize)->default_value(2048),
     //  "optional, key size, 2048 (default)")
     ;
@@ -141,6 +141,15 @@ ndnsec_dsk_gen(int argc, char** argv)
         }
         break;
       }
+    case 'd':
+      {
+        newKeyName = keyChain.generateEd25519KeyPair(Name(identityName), false);
+        if (0 == newKeyName.size()) {
+          std::cerr << "ERROR: Fail to generate Ed25519 key!" << std::endl;
+          return 1;
+        }
+        break;
+      }
     default:
       std::cerr << "ERROR: Unrecongized key type" << "\n";
       std::cerr << description << std::endl;
@@ -49,7 +49,7 @@ ndnsec_key_gen(int argc, char** argv)
      "the default identity of the system")
     ("dsk,d", "generate Data-Signing-Key (DSK) instead of the default Key-Signing-Key (KSK)")
     ("type,t", po::value<char>(&keyType)->default_value('r'),
-    "optional, key type, r for RSA key (default), e for ECDSA key")
+    "optional, key type, r for RSA key (default), e for ECDSA key, d for Ed25519 key")
     // ("size,s", po::value<int>(&keySize)->default_value(2048),
     // "optional, key size, 2048 (default)")
     ;
@@ -97,6 +97,9 @@ ndnsec_key_gen(int argc, char** argv)
       keyName = keyChain.generateEcdsaKeyPair(Name(identityName), isKsk,
                                               EcdsaKeyParams().getKeySize());
       break;
+    case 'd':
+      keyName = keyChain.generateEd25519KeyPair(Name(identityName), isKsk);
+      break;
     default:
       std::cerr << "Unrecongized key type" << "\n";
       std::cerr << description << std::endl;
@@ -31,6 +31,7 @@
 #include "dsk-gen.hpp"
 #include "sign-req.hpp"
 #include "cert-gen.hpp"
+#include "cert-batch.hpp"
 #include "cert-revoke.hpp"
 #include "cert-dump.hpp"
 #include "cert-install.hpp"
@@ -54,6 +55,7 @@ std::string ndnsec_helper("\
   dsk-gen      Generate a Data-Signing-Key for an identity.\n\
   sign-req     Generate a certificate signing request.\n\
   cert-gen     Generate an identity certificate.\n\
+  cert-batch   Generate identity certificates for a stream of requests.\n\
   cert-revoke  Revoke an identity certificate.\n\
   cert-dump    Dump a certificate from PublicInfo.\n\
   cert-install Install a certificate into PublicInfo.\n\
@@ -89,6 +91,7 @@ main(int argc, char** argv)
       else if (command == "dsk-gen")      { return ndnsec_dsk_gen(argc - 1, argv + 1); }
       else if (command == "sign-req")     { return ndnsec_sign_req(argc - 1, argv + 1); }
       else if (command == "cert-gen")     { return ndnsec_cert_gen(argc - 1, argv + 1); }
+      else if (command == "cert-batch")   { return ndnsec_cert_batch(argc - 1, argv + 1); }
       else if (command == "cert-revoke")  { return ndnsec_cert_revoke(argc - 1, argv + 1); }
       else if (command == "cert-dump")    { return ndnsec_cert_dump(argc - 1, argv + 1); }
       else if (command == "cert-install") { return ndnsec_cert_install(argc - 1, argv + 1); }